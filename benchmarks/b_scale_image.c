@@ -0,0 +1,134 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | b_scale_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "benchmarks.h"
+#include "libswscale/swscale.h"
+#include "process.h"
+#include "utilities.h"
+
+#define BENCH_SRC_WIDTH 3840   // 4K UHD source width.
+#define BENCH_SRC_HEIGHT 2160  // 4K UHD source height.
+
+/* Average microseconds per box downscale of the image */
+static double _time_box(const image_t* image, int ratio)
+{
+    long long start = monotonic_time_in_microseconds();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        image_t* scaled = get_box_downscaled_image(image, ratio, 0);
+        if (!scaled)
+            return -1.0;
+        free_image(scaled);
+    }
+
+    return (double)(monotonic_time_in_microseconds() - start) / BENCHMARK_ITERATIONS;
+}
+
+/* Average microseconds per libswscale downscale, context creation included as in scale_image.c */
+static double _time_sws(const image_t* image, int ratio, int flags)
+{
+    int dst_width = image->width / ratio;
+    int dst_height = image->height / ratio;
+    uint8_t* dst_data = (uint8_t*)malloc((size_t)dst_width * dst_height * RGB_BYTES_PER_PIXEL);
+    if (!dst_data)
+        return -1.0;
+
+    const uint8_t* src_slices[1] = {image->data};
+    int src_strides[1] = {image->width * RGB_BYTES_PER_PIXEL};
+    uint8_t* dst_slices[1] = {dst_data};
+    int dst_strides[1] = {dst_width * RGB_BYTES_PER_PIXEL};
+    double elapsed = -1.0;
+
+    long long start = monotonic_time_in_microseconds();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        struct SwsContext* context =
+            sws_getContext(image->width, image->height, AV_PIX_FMT_RGB24, dst_width, dst_height,
+                           AV_PIX_FMT_RGB24, flags, NULL, NULL, NULL);
+        if (!context)
+            goto cleanup;
+
+        sws_scale(context, src_slices, src_strides, 0, image->height, dst_slices, dst_strides);
+        sws_freeContext(context);
+    }
+    elapsed = (double)(monotonic_time_in_microseconds() - start) / BENCHMARK_ITERATIONS;
+
+cleanup:
+    free(dst_data);
+    return elapsed;
+}
+
+/**
+ * @brief Compares the integer-ratio box downscaler with libswscale on a 4K RGB frame.
+ *
+ * Prints the average time per frame of each scaler for 1/2, 1/3 and 1/4 reductions.
+ *
+ * @return 0 on success, 1 if a scaler failed.
+ */
+int benchmark_scale_image(void)
+{
+    image_t image = {.width = BENCH_SRC_WIDTH, .height = BENCH_SRC_HEIGHT};
+    image.size = (size_t)image.width * image.height * RGB_BYTES_PER_PIXEL;
+    image.data = (uint8_t*)malloc(image.size);
+    if (!image.data)
+        return 1;
+
+    for (size_t i = 0; i < image.size; ++i)
+        image.data[i] = (uint8_t)((i * 37) ^ (i >> 3));
+
+    const struct
+    {
+        const char* name;
+        int flags;
+    } sws_cases[] = {{"sws fast_bilinear", SWS_FAST_BILINEAR},
+                     {"sws bilinear", SWS_BILINEAR},
+                     {"sws area", SWS_AREA}};
+
+    int failed = 0;
+    printf("scale_image: %dx%d RGB24, %d iterations\n", image.width, image.height,
+           BENCHMARK_ITERATIONS);
+
+    for (int ratio = 2; ratio <= BOX_MAX_RATIO; ++ratio)
+    {
+        double box_us = _time_box(&image, ratio);
+        if (box_us < 0)
+        {
+            printf("  1/%d %-18s failed\n", ratio, "box");
+            failed++;
+            continue;
+        }
+        printf("  1/%d %-18s %10.1f us/frame\n", ratio, "box", box_us);
+
+        for (size_t i = 0; i < sizeof(sws_cases) / sizeof(sws_cases[0]); ++i)
+        {
+            double sws_us = _time_sws(&image, ratio, sws_cases[i].flags);
+            if (sws_us < 0)
+            {
+                printf("  1/%d %-18s failed\n", ratio, sws_cases[i].name);
+                failed++;
+                continue;
+            }
+            printf("  1/%d %-18s %10.1f us/frame (box is %.1fx faster)\n", ratio,
+                   sws_cases[i].name, sws_us, box_us > 0 ? sws_us / box_us : 0.0);
+        }
+    }
+
+    free(image.data);
+    return failed ? 1 : 0;
+}
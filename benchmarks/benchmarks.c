@@ -0,0 +1,35 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | benchmarks.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include "benchmarks.h"
+
+#include <stdio.h>
+
+#include "utilities.h"
+
+int main()
+{
+    int failed = 0;
+    failed += benchmark_scale_image();
+
+    printf("\n");
+    if (failed)
+        printf(ANSI_RED "%d benchmarks failed.\n" ANSI_RESET, failed);
+    else
+        printf(ANSI_GREEN "All benchmarks completed.\n" ANSI_RESET);
+
+    return failed ? 1 : 0;
+}
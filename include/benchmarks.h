@@ -0,0 +1,24 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | benchmarks.h
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#define BENCHMARK_ITERATIONS 20  // Timed runs per benchmark case.
+
+int benchmark_scale_image(void);
+
+#endif  // BENCHMARKS_H
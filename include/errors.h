@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | errors.h
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -18,23 +18,50 @@
 #define ERRORS_H
 
 /* Argument Errors */
+#define ERROR_DUPLICATE_OUTPUT "Error: The same output path or file descriptor is used twice."
 #define ERROR_INVALID_ARGUMENTS "Error: Invalid arguments provided."
+#define ERROR_INVALID_BATCH "Error: Invalid batch (only --jobs and --debug go with --batch)."
+#define ERROR_INVALID_BATCH_JOB "Error: Bad batch job (needs -o; no interval, shm, fd or deadline)."
+#define ERROR_INVALID_BEST_OF "Error: Invalid best-of (1-256 frames, no exposure or burst)."
+#define ERROR_INVALID_BURST "Error: Invalid burst (1-256 frames, no exposure, timelapse or shm)."
+#define ERROR_INVALID_COUNT "Error: Invalid timelapse count (requires --interval)."
+#define ERROR_INVALID_DEADLINE "Error: Invalid deadline (not with --interval or --publish-shm)."
+#define ERROR_INVALID_CROP "Error: Invalid crop region (expected x,y,w,h inside the frame)."
 #define ERROR_INVALID_DEBUG_DIR "Error: Invalid debug directory specified."
 #define ERROR_INVALID_DEBUG_STEP "Error: Invalid debug step specified."
 #define ERROR_INVALID_EXPOSURE "Error: Invalid exposure value."
+#define ERROR_INVALID_EXPOSURE_END "Error: Invalid exposure end (pts and weighting need exposure)."
 #define ERROR_INVALID_FPS "Error: Invalid FPS value specified."
 #define ERROR_INVALID_IMAGE_DIMENSIONS "Error: Invalid image dimensions specified."
 #define ERROR_INVALID_IMAGE_QUALITY "Error: Invalid image quality specified."
 #define ERROR_INVALID_IMAGE_SIZE "Error: Invalid image size specified."
+#define ERROR_INVALID_INTERVAL "Error: Invalid timelapse interval (not with --publish-shm)."
+#define ERROR_INVALID_INPUT_ALT "Error: Invalid alternative input (RTSP URL, single snapshot)."
+#define ERROR_INVALID_INPUT_PROFILE "Error: Invalid input profile (WxH=rtsp://url, no --input)."
+#define ERROR_INVALID_MAX_LOSS "Error: Invalid max loss (0-100 percent)."
 #define ERROR_INVALID_OUTPUT_FD "Error: Invalid output file descriptor specified."
 #define ERROR_INVALID_OUTPUT_FORMAT "Error: Invalid output format specified."
+#define ERROR_INVALID_OUTPUT_SPEC "Error: Invalid output specification (expected fmt:key=value)."
+#define ERROR_INVALID_PIPELINE_DEPTH "Error: Invalid pipeline depth (requires --interval)."
+#define ERROR_INVALID_PROFILE_CACHE "Error: Invalid profile cache (expected a writable directory)."
+#define ERROR_INVALID_PYRAMID_LEVELS "Error: Invalid pyramid levels (requires --output-file)."
 #define ERROR_INVALID_RESIZE_HEIGHT "Error: Invalid resize height specified."
 #define ERROR_INVALID_RESIZE_WIDTH "Error: Invalid resize width specified."
 #define ERROR_INVALID_RTSP_URL "Error: Invalid RTSP URL provided."
 #define ERROR_INVALID_SCALE_FACTOR "Error: Invalid scale factor specified."
+#define ERROR_INVALID_SCALE_THREADS "Error: Invalid number of scaling threads specified."
+#define ERROR_INVALID_SHM_FORMAT "Error: Invalid shared-memory frame format specified."
+#define ERROR_INVALID_SHM_NAME "Error: Invalid shared-memory name (expected /name)."
+#define ERROR_INVALID_SHM_SLOTS "Error: Invalid number of shared-memory slots specified."
+#define ERROR_INVALID_STACK_MODE "Error: Invalid stack mode (keyframes requires --exposure)."
 #define ERROR_INVALID_TIMEOUT "Error: Invalid timeout value."
+#define ERROR_INVALID_TRANSPORT "Error: Invalid transport (a socket buffer needs UDP)."
+#define ERROR_INVALID_VIDEO_TRACK "Error: Invalid video track specified."
+#define ERROR_INVALID_WRITE_TIMEOUT "Error: Invalid write timeout specified."
 #define ERROR_NO_OUTPUT_SPECIFIED "Error: No output file or file descriptor specified."
 #define ERROR_NOT_NULL_TERMINATED "Error: The provided message is not null-terminated."
+#define ERROR_TOO_MANY_INPUT_PROFILES "Error: Too many input profiles."
+#define ERROR_TOO_MANY_OUTPUTS "Error: Too many output specifications."
 
 /* Memory and Allocation Errors */
 #define ERROR_FAILED_TO_ALLOCATE_BUFFER "Error: Failed to allocate buffer for image data."
@@ -48,16 +75,24 @@
 
 /* File and Directory Errors */
 #define ERROR_FAILED_TO_CREATE_DEBUG_DIR "Error: Failed to create debug directory."
+#define ERROR_FAILED_TO_CREATE_TEMP_FILE "Error: Failed to create temporary output file."
+#define ERROR_FAILED_TO_FORMAT_OUTPUT_PATH "Error: Failed to expand output path template."
+#define ERROR_FAILED_TO_MAP_SHM "Error: Failed to map shared memory."
 #define ERROR_FAILED_TO_OPEN_FILE "Error: Failed to open file."
+#define ERROR_FAILED_TO_OPEN_BATCH "Error: Failed to open batch file."
 #define ERROR_FAILED_TO_OPEN_FD "Error: Failed to open file descriptor for writing."
 #define ERROR_FAILED_TO_OPEN_MEMORY_STREAM "Error: Failed to open memory stream."
+#define ERROR_FAILED_TO_OPEN_SHM "Error: Failed to open shared memory."
 #define ERROR_FAILED_TO_READ_FRAME "Error: Failed to read frame from stream."
+#define ERROR_FAILED_TO_RENAME_FILE "Error: Failed to move temporary file into place."
 #define ERROR_FAILED_TO_SAVE_DEBUG_FILE "Error: Failed to save debug file."
+#define ERROR_FAILED_TO_SYNC_FILE "Error: Failed to sync file to storage."
 #define ERROR_FAILED_TO_WRITE_FILE "Error: Failed to write to file."
 #define ERROR_FAILED_TO_WRITE_FD "Error: Failed to write to file descriptor."
 #define ERROR_FAILED_TO_WRITE_OUTPUT_FD "Error: Failed to write output to file descriptor."
 #define ERROR_FAILED_TO_WRITE_OUTPUT_FILE "Error: Failed to write output file."
 #define ERROR_NO_DATA_TO_WRITE "Error: No data to write to file descriptor."
+#define ERROR_WRITE_TIMED_OUT "Error: Timed out waiting for file descriptor to accept data."
 
 /* Image and Encoding Errors */
 #define ERROR_FAILED_TO_CONVERT_IMAGE "Error: Failed to convert image."
@@ -69,28 +104,40 @@
 #define ERROR_FAILED_TO_FORMAT_HEADER "Error: Failed to format image header."
 #define ERROR_FAILED_TO_GET_IMAGE_SIZE "Error: Failed to get image size."
 #define ERROR_FAILED_TO_INIT_RAW_IMAGE "Error: Failed to initialize raw image."
+#define ERROR_FAILED_TO_PUBLISH_FRAME "Error: Failed to publish frame to shared memory."
 #define ERROR_FAILED_TO_SCALE_IMAGE "Error: Failed to scale image."
 #define ERROR_LIBPNG_ERROR "Error: libpng encountered an error."
 
 /* Stream and Codec Errors */
 #define ERROR_FAILED_TO_COPY_CODEC_PARAMETERS "Error: Failed to copy codec parameters to context."
 #define ERROR_FAILED_TO_CREATE_SWS_CONTEXT "Error: Failed to create SwsContext for scaling."
+#define ERROR_FAILED_TO_CROP_FRAME "Error: Decoded frame does not contain the crop region."
 #define ERROR_FAILED_TO_GET_STREAM_INFO "Error: Failed to get stream information."
 #define ERROR_FAILED_TO_OPEN_CODEC "Error: Failed to open codec."
 #define ERROR_FAILED_TO_OPEN_RTSP_STREAM "Error: Failed to open RTSP stream."
 #define ERROR_FAILED_TO_RECEIVE_FRAME "Error: Failed to receive frame from decoder."
 #define ERROR_FAILED_TO_SEND_PACKET "Error: Failed to send packet to decoder."
 #define ERROR_FAILED_TO_SET_STREAM_OPTIONS "Error: Failed to set stream options."
+#define ERROR_KEYFRAMES_MISSED "Error: Stream missed its expected keyframes."
 #define ERROR_NO_CODEC_PARAMETERS_FOUND "Error: No codec parameters found for video stream."
 #define ERROR_NO_DECODER_FOUND "Error: No decoder found for the video stream."
+#define ERROR_NO_FIRST_FRAME "Error: No frame decoded to learn the video format from."
 #define ERROR_NO_FRAMES_TO_READ "Error: No frames to read."
 #define ERROR_NO_STREAMS_FOUND "Error: No streams found in the format context."
+#define ERROR_NO_STREAM_WON_RACE "Error: Neither input delivered a keyframe covering the output."
 #define ERROR_NO_VIDEO_STREAM_FOUND "Error: No video stream found in the format context."
+#define ERROR_PACKET_LOSS_ABOVE_LIMIT "Error: Frame loss on the stream is above --max-loss."
+#define ERROR_STREAM_PROFILE_MISMATCH "Error: Stream no longer matches its cached profile."
 #define ERROR_INVALID_DESTINATION_DIMENSIONS "Error: Invalid destination dimensions for scaling."
 
 /* Miscellaneous Errors */
+#define ERROR_DEADLINE_EXCEEDED "Error: Deadline exceeded."
 #define ERROR_FAILED_TO_CALCULATE_LIMITS "Error: Failed to calculate stream limits."
 #define ERROR_FAILED_TO_GET_TIME "Error: Failed to get the current time."
+#define ERROR_FAILED_TO_INSTALL_SIGNAL_HANDLERS "Error: Failed to install signal handlers."
+#define ERROR_FAILED_TO_PARSE_BATCH_LINE "Error: Failed to split batch line into arguments."
+#define ERROR_FAILED_TO_START_THREAD "Error: Failed to start worker thread."
+#define ERROR_SNAPSHOT_DROPPED "Error: Encoder queue is full, snapshot dropped."
 
 /* General Return Codes */
 #define RTN_ERROR -1
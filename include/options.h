@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | options.h
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -26,6 +26,8 @@
 #define DEFAULT_SCALE_FACTOR 1.0f               // Default image scale factor.
 #define MIN_SCALE_FACTOR 0.1f                   // Minimum image scale factor.
 #define MAX_SCALE_FACTOR 10.0f                  // Maximum image scale factor.
+#define DEFAULT_SCALE_THREADS 0                 // Default scaling threads (0: one per CPU).
+#define MAX_SCALE_THREADS 256                   // Maximum number of scaling threads.
 #define DEFAULT_IMAGE_QUALITY 95                // Default image quality (0 to 100).
 #define MIN_IMAGE_QUALITY 0                     // Minimum image quality.
 #define MAX_IMAGE_QUALITY 100                   // Maximum image quality.
@@ -35,6 +37,41 @@
 #define MAX_RESIZE_WIDTH 19200                  // Maximum resize width.
 #define DEFAULT_DEBUG_STEP 100                  // Default interval for saving debug files.
 #define DEFAULT_DEBUG_DIR "./debug_files"       // Default directory for debug files.
+#define DEFAULT_SHM_SLOTS 4                     // Default number of shared-memory ring slots.
+#define MIN_SHM_SLOTS 2                         // Minimum number of shared-memory ring slots.
+#define MAX_SHM_SLOTS 64                        // Maximum number of shared-memory ring slots.
+#define DEFAULT_SHM_FORMAT SHM_FORMAT_RGB       // Default pixel layout of published frames.
+#define DEFAULT_WRITE_TIMEOUT_MS 0              // Default output fd write deadline (0: none).
+#define MAX_WRITE_TIMEOUT_MS 3600000            // Maximum output fd write deadline.
+#define MAX_OUTPUT_VARIANTS 16                  // Maximum number of --output specifications.
+#define MAX_INPUT_PROFILES 8                    // Maximum number of --input-profile URLs.
+#define MAX_PYRAMID_LEVELS 8                    // Maximum number of pyramid levels.
+#define MIN_PYRAMID_WIDTH 16                    // Minimum width of a pyramid level.
+#define MIN_PYRAMID_HEIGHT 16                   // Minimum height of a pyramid level.
+#define DEFAULT_INTERVAL_SEC 0                  // Default timelapse interval (0: single snapshot).
+#define MAX_INTERVAL_SEC 86400                  // Maximum timelapse interval in seconds.
+#define DEFAULT_TIMELAPSE_COUNT 0               // Default number of snapshots (0: until signalled).
+#define MAX_TIMELAPSE_COUNT 1000000             // Maximum number of timelapse snapshots.
+#define DEFAULT_PIPELINE_DEPTH 0                // Default encoder queue depth (0: no pipeline).
+#define MAX_PIPELINE_DEPTH 64                   // Maximum encoder queue depth.
+#define DEFAULT_BURST_FRAMES 0                  // Default burst length (0: no burst).
+#define MAX_BURST_FRAMES 256                    // Maximum number of frames in a burst.
+#define DEFAULT_BEST_OF 0                       // Default best-of candidates (0: off).
+#define MAX_BEST_OF 256                         // Maximum number of best-of candidates.
+#define DEFAULT_STACK_MODE STACK_MODE_ALL       // Default frames accumulated by an exposure.
+#define DEFAULT_VIDEO_TRACK 0                   // Default video track (0: first, main stream).
+#define MAX_VIDEO_TRACK 15                      // Maximum video track index.
+#define DEFAULT_TRANSPORT TRANSPORT_TCP         // Default RTSP lower transport.
+#define DEFAULT_BUFFER_SIZE 0                   // Default UDP socket buffer (0: system default).
+#define MAX_BUFFER_SIZE 67108864                // Maximum UDP socket buffer in bytes.
+#define DEFAULT_REORDER_QUEUE -1                // Default RTP reorder queue (-1: demuxer's own).
+#define MAX_REORDER_QUEUE 4096                  // Maximum RTP reorder queue in packets.
+#define DEFAULT_MAX_LOSS 100                    // Default tolerated frame loss (100: any).
+#define DEFAULT_DEADLINE_MS 0                   // Default end-to-end budget (0: none).
+#define MAX_DEADLINE_MS 86400000                // Maximum end-to-end budget (one day).
+#define DEFAULT_JOBS 0                          // Default batch captures (0: one per CPU).
+#define MAX_JOBS 256                            // Maximum number of concurrent batch captures.
+#define MAX_BATCH_ARGS 128                      // Maximum number of arguments on a batch line.
 
 /* Enum for supported image formats */
 typedef enum image_format_e
@@ -43,12 +80,110 @@ typedef enum image_format_e
     IMAGE_FORMAT_JPEG,
     IMAGE_FORMAT_PNG,
     IMAGE_FORMAT_PPM,
+    IMAGE_FORMAT_PGM,
     IMAGE_FORMAT_UNKNOWN
 } image_format_t;
 
 const char* image_format_to_string(image_format_t format);
+const char* image_format_to_mime_type(image_format_t format);
 image_format_t string_to_image_format(const char* str);
 
+/**
+ * @brief One output produced from the captured frame (--output "fmt:q=..:w=..:path=..").
+ *
+ * Fields that are not given in the specification keep the defaults of the
+ * corresponding single-output options.
+ */
+typedef struct output_variant_s
+{
+    image_format_t format;  // Image format of this output.
+    int image_quality;      // Image quality (0 to 100).
+    float scale_factor;     // Image scale factor.
+    int resize_width;       // Resize to fit specified width (0: off, -1: disabled by scale).
+    int resize_height;      // Resize to fit specified height (0: off, -1: disabled by scale).
+    char* path;             // Output file path. If omitted, no file is saved.
+    int fd;                 // Output file descriptor (-1: none).
+} output_variant_t;
+
+short parse_output_spec(const char* spec, output_variant_t* variant);
+
+/**
+ * @brief Resolution profile of a camera served at its own URL (--input-profile WxH=url).
+ */
+typedef struct input_profile_s
+{
+    int width;   // Frame width of the profile in pixels.
+    int height;  // Frame height of the profile in pixels.
+    char* url;   // RTSP URL that serves the profile.
+} input_profile_t;
+
+short parse_input_profile(const char* spec, input_profile_t* profile);
+int split_batch_line(char* line, char* argv[], int max_args);
+
+/**
+ * @brief Region of interest cut from the decoded frame before conversion (--crop x,y,w,h).
+ *
+ * Coordinates are source pixels, or fractions of the frame when normalized is set.
+ * A zero width means no crop.
+ */
+typedef struct crop_s
+{
+    float x;          // Left edge of the region.
+    float y;          // Top edge of the region.
+    float width;      // Width of the region (0: no crop).
+    float height;     // Height of the region.
+    char normalized;  // Coordinates are fractions of the frame (0: pixels, 1: fractions).
+} crop_t;
+
+short parse_crop(const char* spec, crop_t* crop);
+
+/* Enum for pixel layouts of frames published to shared memory */
+typedef enum shm_format_e
+{
+    SHM_FORMAT_RGB = 0,
+    SHM_FORMAT_YUV,
+    SHM_FORMAT_UNKNOWN
+} shm_format_t;
+
+const char* shm_format_to_string(shm_format_t format);
+shm_format_t string_to_shm_format(const char* str);
+
+/* Enum for the frames an exposure accumulates */
+typedef enum stack_mode_e
+{
+    STACK_MODE_ALL = 0,
+    STACK_MODE_KEYFRAMES,
+    STACK_MODE_UNKNOWN
+} stack_mode_t;
+
+const char* stack_mode_to_string(stack_mode_t mode);
+stack_mode_t string_to_stack_mode(const char* str);
+
+/* Enum for what ends an exposure */
+typedef enum exposure_end_e
+{
+    EXPOSURE_END_FRAMES = 0,
+    EXPOSURE_END_PTS,
+    EXPOSURE_END_UNKNOWN
+} exposure_end_t;
+
+const char* exposure_end_to_string(exposure_end_t mode);
+exposure_end_t string_to_exposure_end(const char* str);
+
+/* Enum for RTSP lower transports */
+typedef enum transport_e
+{
+    TRANSPORT_TCP = 0,
+    TRANSPORT_UDP,
+    TRANSPORT_UDP_MULTICAST,
+    TRANSPORT_HTTP,
+    TRANSPORT_AUTO,
+    TRANSPORT_UNKNOWN
+} transport_t;
+
+const char* transport_to_string(transport_t transport);
+transport_t string_to_transport(const char* str);
+
 /**
  * @brief Structure to hold configuration options for the application.
  *
@@ -58,6 +193,9 @@ image_format_t string_to_image_format(const char* str);
 typedef struct options_s
 {
     char* rtsp_url;                // RTSP URL to connect to.
+    char* input_alt;               // RTSP URL raced against rtsp_url (NULL: no race).
+    input_profile_t* inputs;       // Resolution profiles the input URL is picked from.
+    int inputs_count;              // Number of entries in inputs (0: rtsp_url is used).
     int timeout_sec;               // RTSP stream connection timeout in seconds.
     char* output_file_path;        // Output file path. If omitted, no file is saved.
     int output_file_fd;            // Output file descriptor.
@@ -66,10 +204,40 @@ typedef struct options_s
     float scale_factor;            // Image scale factor.
     int resize_height;             // Resize to fit specified height.
     int resize_width;              // Resize to fit specified width.
+    int scale_threads;             // Threads for colour conversion and scaling (0: per CPU).
     int image_quality;             // Image quality (0 to 100).
     char debug;                    // Debug mode: print debug information (0: off, 1: on).
     int debug_step;                // Save debug file every N steps.
     char* debug_dir;               // Directory for debug files (default: ./debug_files).
+    char* shm_name;                // Shared-memory ring to publish frames to. If omitted, off.
+    int shm_slots;                 // Number of slots in the shared-memory ring.
+    shm_format_t shm_format;       // Pixel layout of frames published to shared memory.
+    int write_timeout_ms;          // Deadline for writing to the output fd (0: no deadline).
+    char atomic_write;             // Write output file via temp file + rename (0: off, 1: on).
+    char fsync;                    // Sync output file before it is renamed (0: off, 1: on).
+    output_variant_t* outputs;     // Additional outputs produced from the same capture.
+    int outputs_count;             // Number of entries in outputs.
+    int pyramid_levels;            // Number of halving pyramid levels to save (0: off).
+    crop_t crop;                   // Region of interest cut from every frame (width 0: off).
+    char gray;                     // Capture the luma plane only (0: off, 1: on).
+    int interval_sec;              // Timelapse interval in seconds (0: single snapshot).
+    int count;                     // Number of timelapse snapshots (0: until signalled).
+    int pipeline_depth;            // Snapshots queued for the encode/write worker (0: off).
+    int burst_frames;              // Consecutive frames saved as separate images (0: off).
+    int best_of;                   // Frames scored to keep the sharpest one (0: off).
+    stack_mode_t stack_mode;       // Frames accumulated by an exposure (all or keyframes).
+    exposure_end_t exposure_end;   // End of an exposure (frame count or stream time).
+    char weight_by_duration;       // Weight exposure frames by their duration (0: off, 1: on).
+    char fast_start;               // Bounded stream probing for a fast start (0: off, 1: on).
+    char* profile_cache_dir;       // Directory of cached stream profiles. If omitted, off.
+    int video_track;               // Video track to decode among the advertised ones (0: first).
+    transport_t transport;         // RTSP lower transport (tcp, udp, udp_multicast, http, auto).
+    int buffer_size;               // UDP socket receive buffer in bytes (0: system default).
+    int reorder_queue;             // RTP packets held for reordering (-1: demuxer default).
+    int max_loss;                  // Tolerated share of lost or corrupt frames in percent.
+    int deadline_ms;               // End-to-end budget of a capture in milliseconds (0: none).
+    char* batch_file;              // File of capture jobs, one per line ("-": stdin, NULL: off).
+    int jobs;                      // Concurrent batch captures (0: one per CPU).
     char help;                     // Help flag: print usage information (0: off, 1: on).
     char version;                  // Version flag: print version information (0: off, 1: on).
 } options_t;
@@ -0,0 +1,33 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | output.h
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <time.h>
+
+#include "options.h"
+#include "process.h"
+
+short write_image(const options_t* options, const image_t* image);
+short write_outputs(const options_t* options, image_t* raw_image);
+short write_output_variants(const options_t* options, image_t* raw_image);
+short write_pyramid(const options_t* options, image_t* base_image);
+char* get_pyramid_level_path(const char* path, int width);
+char* get_sequence_path(const char* path_template, unsigned long long sequence, time_t when);
+char* get_burst_frame_path(const char* path, unsigned long long frame, time_t when);
+
+#endif  // OUTPUT_H
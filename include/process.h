@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | process.h
     ::  ::          ::  ::    Created  | 2025-06-06
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -19,12 +19,16 @@
 
 #include "libavcodec/avcodec.h"
 #include "options.h"
+#include "publish.h"
 
 /* Default settings */
 #define DEFAULT_FPS 25.0f                // Default frame rate for video streams if not specified.
 #define I_FRAME_TIMEOUT_SEC 60           // Maximum timeout for I-frames in seconds (1 minute).
 #define FRAME_DELIVERY_LATENCY_SEC 0.3f  // Frame delivery latency in seconds (0.3 seconds).
+#define DEFAULT_GOP_SEC 2.0f             // GOP duration assumed until one has been measured.
 #define RGB_BYTES_PER_PIXEL 3            // Number of bytes per pixel in RGB format.
+#define GRAY_BYTES_PER_PIXEL 1           // Number of bytes per pixel in grayscale format.
+#define BOX_MAX_RATIO 4                  // Largest integer ratio handled by the box downscaler.
 
 /* Quality settings for image scaling */
 #define QUALITY_FAST_BILINEAR 20  // Prioritizing speed over quality.
@@ -44,6 +48,16 @@ typedef struct process_s
     unsigned long long received_frames;  // Number of frames received from the stream.
     short got_first_i_frame;             // Flag indicating if the first I-frame has been received.
     int stream_read_status;              // Status of the stream reading (0: success, < 0: error).
+    shm_ring_t* shm_ring;                // Shared-memory ring frames are published to (or NULL).
+    AVFrame** burst_frames;              // Preallocated frames a burst converts into (or NULL).
+    AVFrame* best_frame;                 // Best-scored frame of --best-of (or NULL).
+    uint8_t* best_buffer;                // Buffer of best_frame, swapped with buffer on a new best.
+    uint8_t* score_buffer;               // Downsampled luma plane the frames are scored on.
+    double best_score;                   // Score of best_frame (-1: no frame yet).
+    int64_t first_keyframe_pts;          // PTS of the first stacked keyframe (--stack keyframes).
+    int64_t last_pts;                    // PTS of the last accumulated frame (or AV_NOPTS_VALUE).
+    int64_t covered_duration;            // Stream time covered by the accumulated frames.
+    unsigned long long sum_weight;       // Total weight of the accumulated frames.
 } process_t;
 
 typedef struct image_s
@@ -55,10 +69,22 @@ typedef struct image_s
 } image_t;
 
 image_t* get_raw_image(options_t* options);
-image_t* get_converted_image(options_t* options, image_t* raw_image);
+image_t* race_raw_image(options_t* options);
+short run_timelapse(options_t* options);
+short run_burst(options_t* options);
+short run_batch(options_t* options);
+image_t* get_converted_image(const options_t* options, image_t* raw_image);
 image_t* get_ppm_image(const uint8_t* data, size_t size, int width, int height);
+image_t* get_pgm_image(const uint8_t* data, size_t size, int width, int height);
 image_t* get_jpg_image(const uint8_t* data, size_t size, int width, int height, short quality);
+image_t* get_half_size_image(const image_t* image);
+image_t* get_box_downscaled_image(const image_t* image, int ratio, int threads);
+int get_box_downscale_ratio(int src_width, int src_height, float scale_factor);
+void free_box_downscale_pool(void);
 image_t* get_png_image(const uint8_t* data, size_t size, int width, int height, short quality);
+int get_image_channels(size_t size, int width, int height);
+double get_frame_score(const uint8_t* data, int linesize, int width, int height, int channels,
+                       uint8_t* luma);
 void free_process(process_t* process);
 void free_image(image_t* image);
 
@@ -0,0 +1,90 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | publish.h
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#ifndef PUBLISH_H
+#define PUBLISH_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "libavcodec/avcodec.h"
+#include "options.h"
+
+#define SHM_RING_MAGIC 0x53534852u  // "SSHR": streamshot shared-memory ring.
+#define SHM_RING_VERSION 1          // Layout version, bumped on incompatible changes.
+#define SHM_RING_ALIGNMENT 64       // Alignment of the header, slots and pixel data (cache line).
+
+/*
+ * Shared-memory ring layout (offsets are relative to the start of the mapping):
+ *
+ *   [shm_ring_header_t] [slot 0] [slot 1] ... [slot N-1]
+ *
+ * Slot i starts at header->slots_offset + i * header->slot_stride with a shm_ring_slot_t,
+ * its pixel data starts header->data_offset bytes after the slot start. RGB frames are packed
+ * RGB24 rows; YUV frames are I420 planes (Y, then U, then V) without row padding.
+ *
+ * Every slot is guarded by a seqlock. The writer makes `sequence` odd, fills the slot and makes
+ * it even again, then publishes the frame through `frames_published`. A reader:
+ *   1. loads header->frames_published (acquire); 0 means nothing was published yet;
+ *   2. takes slot (frames_published - 1) % slot_count and loads its `sequence` (acquire),
+ *      retrying while it is odd;
+ *   3. copies the slot header and pixel data;
+ *   4. issues an acquire fence and reloads `sequence`; the copy is valid only if it is unchanged.
+ * Readers never write to the mapping, so any number of them can attach without locks.
+ */
+typedef struct shm_ring_header_s
+{
+    uint32_t magic;                     // SHM_RING_MAGIC once the header is initialized.
+    uint32_t version;                   // SHM_RING_VERSION.
+    uint32_t slot_count;                // Number of slots in the ring.
+    uint32_t pixel_format;              // shm_format_t of the stored frames.
+    uint32_t width;                     // Frame width in pixels.
+    uint32_t height;                    // Frame height in pixels.
+    int32_t time_base_num;              // Numerator of the stream time base of slot pts.
+    int32_t time_base_den;              // Denominator of the stream time base of slot pts.
+    uint64_t frame_size;                // Size of one frame in bytes.
+    uint64_t slots_offset;              // Offset of slot 0 from the start of the mapping.
+    uint64_t slot_stride;               // Distance in bytes between consecutive slots.
+    uint64_t data_offset;               // Offset of pixel data from the start of a slot.
+    _Atomic uint64_t frames_published;  // Number of complete frames published so far.
+} shm_ring_header_t;
+
+typedef struct shm_ring_slot_s
+{
+    _Atomic uint64_t sequence;  // Seqlock counter: odd while the slot is being written.
+    uint64_t frame_index;       // Zero-based index of the frame in publishing order.
+    int64_t pts;                // Presentation timestamp in the stream time base.
+    uint32_t width;             // Frame width in pixels.
+    uint32_t height;            // Frame height in pixels.
+    uint64_t size;              // Number of valid pixel data bytes.
+} shm_ring_slot_t;
+
+typedef struct shm_ring_s
+{
+    char* name;                      // Name of the POSIX shared-memory object.
+    int fd;                          // File descriptor of the shared-memory object.
+    uint8_t* base;                   // Start of the mapping.
+    size_t mapped_size;              // Size of the mapping in bytes.
+    shm_ring_header_t* header;       // Ring header at the start of the mapping.
+    struct SwsContext* yuv_context;  // Converter to I420 for decoders with other pixel formats.
+    unsigned long long published;    // Number of frames published by this process.
+} shm_ring_t;
+
+shm_ring_t* open_shm_ring(const options_t* options, int width, int height, AVRational time_base);
+short publish_frame(shm_ring_t* ring, const AVFrame* video_frame, const uint8_t* rgb_data);
+void close_shm_ring(shm_ring_t* ring);
+
+#endif  // PUBLISH_H
@@ -0,0 +1,57 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | scaler.h
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#ifndef SCALER_H
+#define SCALER_H
+
+#include "libavutil/frame.h"
+#include "libswscale/swscale.h"
+
+#define SWS_CACHE_CAPACITY 8  // Maximum number of idle and busy SwsContexts kept for reuse.
+
+/* Geometry, formats and options a SwsContext was created for */
+typedef struct sws_key_s
+{
+    int src_width;                  // Width of the source frames in pixels.
+    int src_height;                 // Height of the source frames in pixels.
+    enum AVPixelFormat src_format;  // Pixel format of the source frames.
+    int dst_width;                  // Width of the destination frames in pixels.
+    int dst_height;                 // Height of the destination frames in pixels.
+    enum AVPixelFormat dst_format;  // Pixel format of the destination frames.
+    int flags;                      // SWS_* flags selecting the scaling algorithm.
+    int threads;                    // Number of slice threads.
+} sws_key_t;
+
+/* Usage counters of the SwsContext cache */
+typedef struct sws_cache_stats_s
+{
+    unsigned long long hits;       // Acquisitions served by an idle cached context.
+    unsigned long long misses;     // Acquisitions that had to create a context.
+    unsigned long long evictions;  // Idle contexts freed to make room for new ones.
+} sws_cache_stats_t;
+
+struct SwsContext* create_sws_context(int src_width, int src_height, enum AVPixelFormat src_format,
+                                      int dst_width, int dst_height, enum AVPixelFormat dst_format,
+                                      int flags, int threads);
+short wrap_frame_buffer(AVFrame* frame, uint8_t* data, int width, int height,
+                        enum AVPixelFormat format);
+short scale_frame(struct SwsContext* context, AVFrame* dst, const AVFrame* src);
+struct SwsContext* acquire_sws_context(const sws_key_t* key);
+void release_sws_context(struct SwsContext* context);
+sws_cache_stats_t get_sws_cache_stats(void);
+void free_sws_cache(void);
+
+#endif  // SCALER_H
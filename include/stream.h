@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | stream.h
     ::  ::          ::  ::    Created  | 2025-06-06
-          ::::  ::::          Modified | 2025-06-19
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -17,11 +17,57 @@
 #ifndef STREAM_H
 #define STREAM_H
 
+#include <stdatomic.h>
+
 #include "libavcodec/avcodec.h"
 #include "libavformat/avformat.h"
 #include "libswscale/swscale.h"
 #include "options.h"
 
+/* Keyframe cadence */
+#define MAX_MISSED_KEYFRAMES 2    // Expected keyframes a stream may miss before it is failed.
+#define GOP_LEARNING_WEIGHT 0.25  // Weight of a new keyframe interval in the learned GOP.
+
+/* Learning the frame format from the first frame (--fast-start without probing) */
+#define MAX_PRIMED_PACKETS 256      // Packets kept from the first keyframe until a frame is out.
+#define FIRST_FRAME_TIMEOUT_SEC 60  // Longest wait for the first frame in seconds.
+
+/* Pixel rectangle of the decoded frame that is converted and processed */
+typedef struct region_s
+{
+    int x;       // Left edge in source pixels.
+    int y;       // Top edge in source pixels.
+    int width;   // Width in source pixels.
+    int height;  // Height in source pixels.
+} region_t;
+
+/* Loss and reordering seen on the video stream, derived from packet timestamps */
+typedef struct transport_stats_s
+{
+    unsigned long long packets;            // Video packets demuxed.
+    unsigned long long corrupt_packets;    // Packets flagged corrupt by the demuxer.
+    unsigned long long reordered_packets;  // Packets whose DTS went backwards.
+    unsigned long long missing_frames;     // Frames lost between consecutive packets.
+    unsigned long long frames;             // Frames decoded since the first I-frame.
+    unsigned long long corrupt_frames;     // Decoded frames with concealed errors.
+    int64_t last_dts;                      // DTS of the latest in-order packet.
+} transport_stats_t;
+
+/* Limited (MPEG) range of 8-bit luma samples */
+#define LUMA_RANGE_MIN 16    // Black.
+#define LUMA_RANGE_SPAN 219  // Black to white (16..235).
+
+/* Race of --input and --input-alt for the first usable keyframe */
+#define RACE_STREAMS 2        // --input and --input-alt.
+#define RACE_GRACE_MS 500     // Time a qualifying stream leaves a smaller one to qualify too.
+#define RACE_POLL_US 1000     // Poll interval while waiting out the grace window.
+
+typedef struct stream_race_s
+{
+    atomic_int winner;                 // Index of the stream that won the race (-1: none yet).
+    atomic_llong areas[RACE_STREAMS];  // Processed area per stream (0: not open, -1: out).
+} stream_race_t;
+
 typedef struct stream_s
 {
     AVDictionary* options;                  // Options for the RTSP stream (e.g., timeout).
@@ -29,11 +75,55 @@ typedef struct stream_s
     int video_stream_index;                 // Index of the video stream in the format context.
     AVCodecContext* codec_context;          // Codec context for decoding the video stream.
     struct SwsContext* sws_context;         // SwsContext for scaling and converting pixel formats.
+    region_t region;                        // Region of the frame that is processed (--crop).
+    char luma_plane;                        // Luma is read from the decoded frame (--gray).
+    uint8_t luma_lut[256];                  // Limited to full range luma (see luma_range.c).
     unsigned int number_of_frames_to_read;  // Number of frames to read from the stream.
     long long stop_reading_at;              // Timestamp to stop reading frames (in microseconds).
+    double keyframe_interval_sec;           // Learned or cached GOP duration (0: none).
+    int64_t last_keyframe_pts;              // PTS of the latest decoded keyframe.
+    long long last_keyframe_at;             // Monotonic time of the latest keyframe (us, 0: none).
+    int64_t frame_duration;                 // Nominal frame duration in stream time base units.
+    long long opened_at;                    // Monotonic time of stream opening (us).
+    long long first_frame_us;               // Time to first decoded frame (us, 0: none).
+    char processed_frame;                   // A decoded frame was cropped and converted.
+    char* profile_path;                     // Profile cache file (NULL: no --profile-cache).
+    char profile_loaded;                    // Decoder parameters came from the profile cache.
+    transport_stats_t transport_stats;      // Loss and reordering seen on the video stream.
+    stream_race_t* race;                    // Race the stream takes part in (NULL: none).
+    int race_index;                         // Index of the stream in its race.
+    AVPacket** primed_packets;              // Packets decoded to learn the format, replayed.
+    int primed_count;                       // Number of primed packets.
+    int primed_next;                        // Next primed packet to replay.
 } stream_t;
 
 stream_t* get_stream(options_t* options);
+stream_t* get_racing_stream(options_t* options, stream_race_t* race, int index);
 void free_stream(stream_t* stream);
+int find_video_track(const AVFormatContext* format_context, int track);
+char* get_stream_profile_path(const char* dir, const char* url);
+short apply_stream_profile(stream_t* stream, const options_t* options);
+short check_stream_profile(stream_t* stream, const AVFrame* frame);
+void save_stream_profile(const stream_t* stream);
+void count_video_packet(stream_t* stream, const AVPacket* packet);
+short is_corrupt_frame(const AVFrame* frame);
+short count_video_frame(stream_t* stream, const AVFrame* frame, const options_t* options);
+void learn_keyframe_interval(stream_t* stream, const AVFrame* frame, const options_t* options);
+short check_keyframe_cadence(const stream_t* stream);
+const input_profile_t* pick_input_profile(const options_t* options);
+short select_input_profile(options_t* options);
+void init_stream_race(stream_race_t* race);
+void join_stream_race(stream_t* stream, const options_t* options);
+void leave_stream_race(stream_race_t* race, int index);
+short claim_stream_race(stream_t* stream, const options_t* options);
+short stream_race_lost(const stream_t* stream);
+void print_transport_stats(const stream_t* stream);
+int read_stream_packet(stream_t* stream, AVPacket* packet);
+void free_primed_packets(stream_t* stream);
+void init_luma_range(stream_t* stream);
+const uint8_t* get_luma_range_lut(const stream_t* stream, const AVFrame* frame);
+void copy_luma_plane(const stream_t* stream, const AVFrame* frame, uint8_t* dst, int linesize);
+short get_crop_region(const crop_t* crop, int frame_width, int frame_height, int log2_chroma_w,
+                      int log2_chroma_h, region_t* region);
 
 #endif  // STREAM_H
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | tests.h
     ::  ::          ::  ::    Created  | 2025-06-25
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -22,6 +22,7 @@ int test_trim_flag_value(void);
 int test_write_data_to_fd(void);
 int test_write_msg_to_fd(void);
 int test_write_data_to_file(void);
+int test_write_data_to_file_atomic(void);
 int test_time_now_in_microseconds(void);
 int test_image_format_to_string(void);
 int test_string_to_image_format(void);
@@ -29,7 +30,29 @@ int test_convert_image(void);
 int test_jpg_image(void);
 int test_png_image(void);
 int test_ppm_image(void);
+int test_pgm_image(void);
 int test_parse_args(void);
 int test_validate_options(void);
+int test_shm_ring(void);
+int test_parse_output_spec(void);
+int test_workers(void);
+int test_write_output_variants(void);
+int test_half_size_image(void);
+int test_write_pyramid(void);
+int test_crop(void);
+int test_box_downscaled_image(void);
+int test_scaler(void);
+int test_sequence_path(void);
+int test_frame_score(void);
+int test_stream_profile(void);
+int test_find_video_track(void);
+int test_transport_stats(void);
+int test_deadline(void);
+int test_keyframe_cadence(void);
+int test_stream_race(void);
+int test_input_profile(void);
+int test_batch_line(void);
+int test_first_frame(void);
+int test_luma_range(void);
 
 #endif  // TESTS_H
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | utilities.h
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -27,13 +27,37 @@
 #define ANSI_BLUE "\033[34m"
 #define ANSI_RESET "\033[0m"
 
+/**
+ * @brief Statistics collected while writing a buffer to a file descriptor.
+ */
+typedef struct write_stats_s
+{
+    size_t bytes;          // Number of bytes accepted by the descriptor.
+    long long elapsed_us;  // Total time spent in the writer.
+    long long stall_us;    // Time spent waiting in poll() for the descriptor.
+    unsigned int polls;    // Number of poll() waits.
+} write_stats_t;
+
 ssize_t write_data_to_file(const char* file_path, const void* buf, size_t buf_size);
+ssize_t write_data_to_file_atomic(const char* file_path, const void* buf, size_t buf_size,
+                                  char durable);
 ssize_t write_data_to_fd(int fd, const void* buf, size_t buf_size);
+ssize_t write_data_to_fd_with_deadline(int fd, const void* buf, size_t buf_size, int timeout_ms,
+                                       write_stats_t* stats);
 ssize_t write_msg_to_fd(int fd, const char* msg);
 short save_ppm(const char* path, const uint8_t* data, size_t size, int width, int height);
 char* normalize_file_path(const char* file_path);
 char* trim_flag_value(const char* str);
 void print_version(void);
 long long time_now_in_microseconds(void);
+long long monotonic_time_in_microseconds(void);
+short install_stop_handlers(void);
+short stop_requested(void);
+void start_deadline(int deadline_ms);
+void set_deadline_stage(const char* stage);
+long long get_deadline_at(void);
+short deadline_exceeded(void);
+const char* get_deadline_exhausted_stage(void);
+int deadline_interrupt_callback(void* opaque);
 
 #endif  // UTILITIES_H
@@ -0,0 +1,72 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | workers.h
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <pthread.h>
+
+#define WORKER_QUEUE_FULL 1  // try_submit_worker_task(): the task was not queued.
+
+typedef void (*worker_task_fn_t)(void* arg);
+
+/**
+ * @brief A set of submitted tasks that can be waited for as a whole.
+ */
+typedef struct worker_group_s
+{
+    pthread_mutex_t mutex;  // Protects pending.
+    pthread_cond_t done;    // Signalled when pending drops to zero.
+    unsigned int pending;   // Number of submitted tasks that have not finished yet.
+} worker_group_t;
+
+typedef struct worker_task_s
+{
+    worker_task_fn_t function;  // Function to run on a worker thread.
+    void* arg;                  // Argument passed to function.
+    worker_group_t* group;      // Group notified when the task finishes (or NULL).
+} worker_task_t;
+
+/**
+ * @brief Fixed-size thread pool fed from a bounded FIFO queue.
+ */
+typedef struct worker_pool_s
+{
+    pthread_t* threads;         // Worker threads.
+    int threads_count;          // Number of started worker threads.
+    worker_task_t* queue;       // Ring buffer of queued tasks.
+    int queue_capacity;         // Maximum number of queued tasks.
+    int queue_head;             // Index of the oldest queued task.
+    int queue_length;           // Number of queued tasks.
+    pthread_mutex_t mutex;      // Protects the queue and stopping.
+    pthread_cond_t not_empty;   // Signalled when a task is queued or the pool stops.
+    pthread_cond_t not_full;    // Signalled when a queued task is taken.
+    char stopping;              // Workers exit once the queue is drained (0: no, 1: yes).
+} worker_pool_t;
+
+worker_pool_t* create_worker_pool(int threads_count, int queue_capacity);
+short submit_worker_task(worker_pool_t* pool, worker_group_t* group, worker_task_fn_t function,
+                         void* arg);
+short try_submit_worker_task(worker_pool_t* pool, worker_group_t* group,
+                             worker_task_fn_t function, void* arg);
+int get_worker_queue_length(worker_pool_t* pool);
+void free_worker_pool(worker_pool_t* pool);
+short init_worker_group(worker_group_t* group);
+void wait_worker_group(worker_group_t* group);
+void destroy_worker_group(worker_group_t* group);
+int get_cpu_count(void);
+
+#endif  // WORKERS_H
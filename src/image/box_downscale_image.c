@@ -0,0 +1,369 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | box_downscale_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+#include "workers.h"
+
+#define BOX_THREADING_MIN_PIXELS 2000000  // Source size from which the rows are split on threads.
+#define BOX_MAX_THREADS 8                 // Upper bound of row bands per downscale.
+#define BOX_RECIPROCAL_SHIFT 16           // Fixed-point precision of the averaging reciprocal.
+#define BOX_POOL_QUEUE_CAPACITY 32        // Bands queued on the shared pool before callers wait.
+
+/* Rows [first_row, last_row) of the destination image, downscaled on one thread */
+typedef struct box_band_s
+{
+    const image_t* src;  // Source image.
+    image_t* dst;        // Destination image.
+    int ratio;           // Integer reduction ratio.
+    int channels;        // Samples per pixel (RGB or grayscale).
+    int first_row;       // First destination row of the band.
+    int last_row;        // Destination row after the last one of the band.
+    uint16_t* sums;      // Scratch row of vertical sums owned by the band.
+    short status;        // 0 on success, -1 on failure.
+} box_band_t;
+
+/**
+ * @brief Adds `count` rows of 8-bit samples into 16-bit sums (vertical pass of the box filter).
+ *
+ * @param rows       Array of `count` pointers to source rows.
+ * @param count      Number of rows to add (at most 4, so the sums cannot overflow).
+ * @param sums       Pointer to the destination buffer of `samples` 16-bit sums.
+ * @param samples    Number of samples per row.
+ */
+static void _sum_rows(const uint8_t* const* rows, int count, uint16_t* sums, size_t samples)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= samples; i += 32)
+    {
+        __m256i lo = _mm256_setzero_si256();
+        __m256i hi = _mm256_setzero_si256();
+        for (int r = 0; r < count; ++r)
+        {
+            lo = _mm256_add_epi16(
+                lo, _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(rows[r] + i))));
+            hi = _mm256_add_epi16(
+                hi, _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(rows[r] + i + 16))));
+        }
+        _mm256_storeu_si256((__m256i*)(sums + i), lo);
+        _mm256_storeu_si256((__m256i*)(sums + i + 16), hi);
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= samples; i += 16)
+    {
+        __m128i lo = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        for (int r = 0; r < count; ++r)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(rows[r] + i));
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(a, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(a, zero));
+        }
+        _mm_storeu_si128((__m128i*)(sums + i), lo);
+        _mm_storeu_si128((__m128i*)(sums + i + 8), hi);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= samples; i += 16)
+    {
+        uint16x8_t lo = vdupq_n_u16(0);
+        uint16x8_t hi = vdupq_n_u16(0);
+        for (int r = 0; r < count; ++r)
+        {
+            uint8x16_t a = vld1q_u8(rows[r] + i);
+            lo = vaddw_u8(lo, vget_low_u8(a));
+            hi = vaddw_u8(hi, vget_high_u8(a));
+        }
+        vst1q_u16(sums + i, lo);
+        vst1q_u16(sums + i + 8, hi);
+    }
+#endif
+
+    for (; i < samples; ++i)
+    {
+        uint16_t sum = 0;
+        for (int r = 0; r < count; ++r) sum += rows[r][i];
+        sums[i] = sum;
+    }
+}
+
+/* Averages ratio-wide groups of the vertical sums into one destination row (horizontal pass) */
+static inline void _average_row(const uint16_t* sums, uint8_t* out, int width, int ratio,
+                                int channels)
+{
+    // ceil(2^16 / area) is exact for every sum of at most 16 samples of 8 bits
+    uint32_t area = (uint32_t)(ratio * ratio);
+    uint32_t reciprocal = ((1u << BOX_RECIPROCAL_SHIFT) + area - 1) / area;
+    uint32_t rounding = area / 2;
+
+    for (int x = 0; x < width; ++x)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            uint32_t sum = 0;
+            for (int k = 0; k < ratio; ++k) sum += sums[k * channels + c];
+            out[c] = (uint8_t)(((sum + rounding) * reciprocal) >> BOX_RECIPROCAL_SHIFT);
+        }
+        sums += ratio * channels;
+        out += channels;
+    }
+}
+
+/* Downscales the rows of one band: vertical sums, then horizontal averages */
+static void _downscale_band(void* arg)
+{
+    box_band_t* band = (box_band_t*)arg;
+    const image_t* src = band->src;
+    image_t* dst = band->dst;
+    int ratio = band->ratio;
+    int channels = band->channels;
+    size_t src_stride = (size_t)src->width * channels;
+    size_t row_samples = (size_t)dst->width * ratio * channels;
+
+    for (int y = band->first_row; y < band->last_row; ++y)
+    {
+        const uint8_t* rows[BOX_MAX_RATIO];
+        for (int r = 0; r < ratio; ++r)
+            rows[r] = src->data + (size_t)(y * ratio + r) * src_stride;
+        _sum_rows(rows, ratio, band->sums, row_samples);
+
+        // Constant ratios and channel counts let the compiler unroll the horizontal pass
+        uint8_t* out = dst->data + (size_t)y * dst->width * channels;
+        if (channels == GRAY_BYTES_PER_PIXEL)
+        {
+            if (ratio == 2)
+                _average_row(band->sums, out, dst->width, 2, GRAY_BYTES_PER_PIXEL);
+            else if (ratio == 3)
+                _average_row(band->sums, out, dst->width, 3, GRAY_BYTES_PER_PIXEL);
+            else
+                _average_row(band->sums, out, dst->width, 4, GRAY_BYTES_PER_PIXEL);
+        }
+        else if (ratio == 2)
+            _average_row(band->sums, out, dst->width, 2, RGB_BYTES_PER_PIXEL);
+        else if (ratio == 3)
+            _average_row(band->sums, out, dst->width, 3, RGB_BYTES_PER_PIXEL);
+        else
+            _average_row(band->sums, out, dst->width, 4, RGB_BYTES_PER_PIXEL);
+    }
+
+    band->status = RTN_SUCCESS;
+}
+
+/* Band workers shared by every downscale of the process, started on first use */
+static pthread_mutex_t _box_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static worker_pool_t* _box_pool = NULL;
+
+/* Returns the shared band pool, starting it on first use (NULL if it cannot be started) */
+static worker_pool_t* _get_box_pool(void)
+{
+    pthread_mutex_lock(&_box_pool_mutex);
+    if (!_box_pool)
+        _box_pool = create_worker_pool(BOX_MAX_THREADS - 1, BOX_POOL_QUEUE_CAPACITY);
+    worker_pool_t* pool = _box_pool;
+    pthread_mutex_unlock(&_box_pool_mutex);
+
+    return pool;
+}
+
+/**
+ * @brief Runs the bands on the shared band pool, the first one on the calling thread.
+ *
+ * Threads are started once per process rather than per image, so a timelapse or a batch
+ * does not pay the thread start-up cost on every frame. Bands that cannot be queued run on
+ * the calling thread.
+ */
+static short _run_bands(box_band_t* bands, int bands_count)
+{
+    worker_pool_t* pool = bands_count > 1 ? _get_box_pool() : NULL;
+    worker_group_t group;
+    short queued = pool && !init_worker_group(&group);
+
+    for (int i = 1; i < bands_count; ++i)
+        if (!queued || submit_worker_task(pool, &group, _downscale_band, &bands[i]))
+            _downscale_band(&bands[i]);
+
+    _downscale_band(&bands[0]);
+
+    if (queued)
+    {
+        wait_worker_group(&group);
+        destroy_worker_group(&group);
+    }
+
+    short result = RTN_SUCCESS;
+    for (int i = 0; i < bands_count; ++i) result |= bands[i].status;
+
+    return result ? RTN_ERROR : RTN_SUCCESS;
+}
+
+/**
+ * @brief Stops the band workers shared by the box downscales.
+ *
+ * Call once no downscale is running anymore, typically before the process exits; a later
+ * downscale starts the workers again.
+ */
+void free_box_downscale_pool(void)
+{
+    pthread_mutex_lock(&_box_pool_mutex);
+    free_worker_pool(_box_pool);
+    _box_pool = NULL;
+    pthread_mutex_unlock(&_box_pool_mutex);
+}
+
+/**
+ * @brief Returns the integer reduction ratio a scale factor stands for, if the box filter fits.
+ *
+ * @param src_width     Width of the source image in pixels.
+ * @param src_height    Height of the source image in pixels.
+ * @param scale_factor  Requested scale factor.
+ *
+ * @return 2, 3 or 4 when the scale factor is 1/2, 1/3 or 1/4 and both source dimensions are
+ *         divisible by it, otherwise 0.
+ */
+int get_box_downscale_ratio(int src_width, int src_height, float scale_factor)
+{
+    if (src_width <= 0 || src_height <= 0 || scale_factor <= 0.0f)
+        return 0;
+
+    int ratio = (int)lroundf(1.0f / scale_factor);
+    if (ratio < 2 || ratio > BOX_MAX_RATIO || fabsf(scale_factor * ratio - 1.0f) > 1e-3f)
+        return 0;
+
+    return src_width % ratio == 0 && src_height % ratio == 0 ? ratio : 0;
+}
+
+/**
+ * @brief Builds a copy of a raw RGB or grayscale image reduced by an integer ratio with a box
+ * filter.
+ *
+ * Every destination pixel is the rounded average of a ratio x ratio block of source pixels.
+ * The vertical pass is vectorized with AVX2, SSE2 or NEON when available and the horizontal
+ * pass divides by a fixed-point reciprocal. Large images are split into row bands that run
+ * on worker threads shared by the whole process (see free_box_downscale_pool()). Trailing
+ * rows or columns that do not fill a whole block are dropped.
+ *
+ * @param image    Pointer to the source image_t (RGB24 or GRAY8, at least ratio x ratio pixels).
+ * @param ratio    Reduction ratio (2 to BOX_MAX_RATIO).
+ * @param threads  Maximum number of row bands for large images (0: one per CPU).
+ *
+ * @return Pointer to a newly allocated image_t, or NULL on failure.
+ *
+ * @note The caller is responsible for freeing the returned image with free_image().
+ */
+image_t* get_box_downscaled_image(const image_t* image, int ratio, int threads)
+{
+    int channels = image ? get_image_channels(image->size, image->width, image->height) : 0;
+    if (!image || !image->data || !channels || ratio < 2 || ratio > BOX_MAX_RATIO ||
+        threads < 0 || image->width < ratio || image->height < ratio)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_box_downscaled_image | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    int dst_width = image->width / ratio;
+    int dst_height = image->height / ratio;
+    size_t row_samples = (size_t)dst_width * ratio * channels;
+
+    int bands_count = 1;
+    if ((long long)image->width * image->height >= BOX_THREADING_MIN_PIXELS)
+    {
+        bands_count = threads ? threads : get_cpu_count();
+        if (bands_count > BOX_MAX_THREADS)
+            bands_count = BOX_MAX_THREADS;
+        if (bands_count > dst_height)
+            bands_count = dst_height;
+    }
+
+    box_band_t bands[BOX_MAX_THREADS] = {0};
+    image_t* scaled = (image_t*)malloc(sizeof(image_t));
+    uint16_t* sums = (uint16_t*)malloc(row_samples * bands_count * sizeof(uint16_t));
+    if (!scaled || !sums)
+        goto error;
+
+    scaled->width = dst_width;
+    scaled->height = dst_height;
+    scaled->size = (size_t)dst_width * dst_height * channels;
+    scaled->data = (uint8_t*)malloc(scaled->size);
+    if (!scaled->data)
+        goto error;
+
+    for (int i = 0; i < bands_count; ++i)
+        bands[i] = (box_band_t){.src = image,
+                                .dst = scaled,
+                                .ratio = ratio,
+                                .channels = channels,
+                                .first_row = (int)((long long)dst_height * i / bands_count),
+                                .last_row = (int)((long long)dst_height * (i + 1) / bands_count),
+                                .sums = sums + row_samples * i,
+                                .status = RTN_ERROR};
+
+    if (_run_bands(bands, bands_count))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_box_downscaled_image | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        free(sums);
+        free_image(scaled);
+        return NULL;
+    }
+
+    free(sums);
+    return scaled;
+
+error:
+    write_msg_to_fd(STDERR_FILENO,
+                    "(f) get_box_downscaled_image | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+    if (scaled)
+    {
+        scaled->data = NULL;
+        free_image(scaled);
+    }
+    free(sums);
+    return NULL;
+}
+
+/**
+ * @brief Builds a half-size copy of a raw RGB or grayscale image with a 2x2 box filter.
+ *
+ * A trailing odd row or column is dropped.
+ *
+ * @param image  Pointer to the source image_t (RGB24 or GRAY8, at least 2x2 pixels).
+ *
+ * @return Pointer to a newly allocated half-size image_t, or NULL on failure.
+ *
+ * @note The caller is responsible for freeing the returned image with free_image().
+ */
+image_t* get_half_size_image(const image_t* image)
+{
+    return get_box_downscaled_image(image, 2, 0);
+}
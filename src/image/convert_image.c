@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | convert_image.c
     ::  ::          ::  ::    Created  | 2025-06-20
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -25,15 +25,15 @@
  * @brief Converts an input image to the specified output format.
  *
  * This function takes an input image and conversion options, checks for valid arguments,
- * and converts the image to the desired output format (JPG, JPEG, PNG, or PPM) with the specified
- * quality.
+ * and converts the image to the desired output format (JPG, JPEG, PNG, PPM or PGM) with the
+ * specified quality. Grayscale images asked for as PPM are written as PGM.
  *
  * @param options Pointer to options_t structure containing conversion options.
  * @param image Pointer to image_t structure representing the input image.
  *
  * @return Pointer to a newly allocated image_t structure in the desired format, or NULL on error.
  */
-image_t* get_converted_image(options_t* options, image_t* image)
+image_t* get_converted_image(const options_t* options, image_t* image)
 {
     if (!options || !image)
     {
@@ -68,7 +68,12 @@ image_t* get_converted_image(options_t* options, image_t* image)
                                    options->image_quality);
             break;
         case IMAGE_FORMAT_PPM:
-            result = get_ppm_image(image->data, image->size, image->width, image->height);
+        case IMAGE_FORMAT_PGM:
+            if (get_image_channels(image->size, image->width, image->height) ==
+                GRAY_BYTES_PER_PIXEL)
+                result = get_pgm_image(image->data, image->size, image->width, image->height);
+            else
+                result = get_ppm_image(image->data, image->size, image->width, image->height);
             break;
         case IMAGE_FORMAT_UNKNOWN:
         default:
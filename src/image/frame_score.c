@@ -0,0 +1,217 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | frame_score.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "process.h"
+
+#define SCORE_CHUNK_SAMPLES 1024  // Samples per row chunk, keeps the 32-bit lane sums exact.
+#define SCORE_MID_GRAY 128.0      // Mean luma of a perfectly exposed frame.
+
+/* Halves the image into a luma plane: 2x2 boxes of gray samples, or of (R + 2G + B) / 4 */
+static void _downsample_luma(const uint8_t* data, int linesize, int channels, uint8_t* luma,
+                             int luma_width, int luma_height)
+{
+    for (int y = 0; y < luma_height; ++y, luma += luma_width)
+    {
+        const uint8_t* top = data + (ptrdiff_t)(2 * y) * linesize;
+        const uint8_t* bottom = top + linesize;
+
+        if (channels == GRAY_BYTES_PER_PIXEL)
+        {
+            for (int x = 0; x < luma_width; ++x)
+                luma[x] = (uint8_t)((top[2 * x] + top[2 * x + 1] + bottom[2 * x] +
+                                     bottom[2 * x + 1] + 2) >> 2);
+            continue;
+        }
+
+        for (int x = 0; x < luma_width; ++x)
+        {
+            unsigned int sum = 0;
+            for (int i = 0; i < 2; ++i)
+            {
+                const uint8_t* t = top + (size_t)(2 * x + i) * RGB_BYTES_PER_PIXEL;
+                const uint8_t* b = bottom + (size_t)(2 * x + i) * RGB_BYTES_PER_PIXEL;
+                sum += t[0] + 2u * t[1] + t[2] + b[0] + 2u * b[1] + b[2];
+            }
+            luma[x] = (uint8_t)((sum + 8) >> 4);
+        }
+    }
+}
+
+/**
+ * @brief Adds the 4-neighbour Laplacian of `count` samples of a luma row to the running sums.
+ *
+ * @param up      Pointer to the first sample above.
+ * @param mid     Pointer to the first sample (its left neighbour must be readable).
+ * @param down    Pointer to the first sample below.
+ * @param count   Number of samples, at most SCORE_CHUNK_SAMPLES.
+ * @param sum     Pointer to the sum of the Laplacian.
+ * @param sum_sq  Pointer to the sum of the squared Laplacian.
+ */
+static void _laplacian_chunk(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                             int count, long long* sum, long long* sum_sq)
+{
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256i sums = _mm256_setzero_si256();
+    __m256i squares = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i c = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(mid + i)));
+        __m256i l = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(mid + i - 1)));
+        __m256i r = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(mid + i + 1)));
+        __m256i u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(up + i)));
+        __m256i d = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(down + i)));
+        __m256i lap = _mm256_sub_epi16(
+            _mm256_slli_epi16(c, 2),
+            _mm256_add_epi16(_mm256_add_epi16(l, r), _mm256_add_epi16(u, d)));
+        sums = _mm256_add_epi32(sums, _mm256_madd_epi16(lap, ones));
+        squares = _mm256_add_epi32(squares, _mm256_madd_epi16(lap, lap));
+    }
+
+    int32_t lanes[8], square_lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, sums);
+    _mm256_storeu_si256((__m256i*)square_lanes, squares);
+    for (int k = 0; k < 8; ++k)
+    {
+        *sum += lanes[k];
+        *sum_sq += square_lanes[k];
+    }
+#elif defined(__SSE2__)
+    __m128i sums = _mm_setzero_si128();
+    __m128i squares = _mm_setzero_si128();
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(mid + i)), zero);
+        __m128i l = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(mid + i - 1)), zero);
+        __m128i r = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(mid + i + 1)), zero);
+        __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(up + i)), zero);
+        __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(down + i)), zero);
+        __m128i lap = _mm_sub_epi16(_mm_slli_epi16(c, 2),
+                                    _mm_add_epi16(_mm_add_epi16(l, r), _mm_add_epi16(u, d)));
+        sums = _mm_add_epi32(sums, _mm_madd_epi16(lap, ones));
+        squares = _mm_add_epi32(squares, _mm_madd_epi16(lap, lap));
+    }
+
+    int32_t lanes[4], square_lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, sums);
+    _mm_storeu_si128((__m128i*)square_lanes, squares);
+    for (int k = 0; k < 4; ++k)
+    {
+        *sum += lanes[k];
+        *sum_sq += square_lanes[k];
+    }
+#elif defined(__ARM_NEON)
+    int32x4_t sums = vdupq_n_s32(0);
+    int32x4_t squares = vdupq_n_s32(0);
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x8_t c = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(mid + i)));
+        int16x8_t l = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(mid + i - 1)));
+        int16x8_t r = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(mid + i + 1)));
+        int16x8_t u = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(up + i)));
+        int16x8_t d = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(down + i)));
+        int16x8_t lap =
+            vsubq_s16(vshlq_n_s16(c, 2), vaddq_s16(vaddq_s16(l, r), vaddq_s16(u, d)));
+        sums = vpadalq_s16(sums, lap);
+        squares = vmlal_s16(squares, vget_low_s16(lap), vget_low_s16(lap));
+        squares = vmlal_s16(squares, vget_high_s16(lap), vget_high_s16(lap));
+    }
+
+    int32_t lanes[4], square_lanes[4];
+    vst1q_s32(lanes, sums);
+    vst1q_s32(square_lanes, squares);
+    for (int k = 0; k < 4; ++k)
+    {
+        *sum += lanes[k];
+        *sum_sq += square_lanes[k];
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        int lap = 4 * mid[i] - mid[i - 1] - mid[i + 1] - up[i] - down[i];
+        *sum += lap;
+        *sum_sq += (long long)lap * lap;
+    }
+}
+
+/**
+ * @brief Scores a frame for --best-of: sharpness weighted by how well it is exposed.
+ *
+ * The frame is halved into a luma plane, whose Laplacian variance measures the sharpness
+ * (motion blur and defocus flatten it). The variance is weighted by 1 - ((mean - 128) / 128)^2,
+ * so black, washed-out and IR-switch frames lose against a frame of normal brightness.
+ *
+ * @param data      Pointer to the first row of the RGB24 or GRAY8 frame.
+ * @param linesize  Bytes between the starts of two rows.
+ * @param width     Width of the frame in pixels.
+ * @param height    Height of the frame in pixels.
+ * @param channels  RGB_BYTES_PER_PIXEL or GRAY_BYTES_PER_PIXEL.
+ * @param luma      Scratch buffer of at least (width / 2) * (height / 2) bytes.
+ *
+ * @return The score (higher is better), or 0 for a frame too small to be scored.
+ */
+double get_frame_score(const uint8_t* data, int linesize, int width, int height, int channels,
+                       uint8_t* luma)
+{
+    int luma_width = width / 2;
+    int luma_height = height / 2;
+    if (!data || !luma || luma_width < 3 || luma_height < 3 ||
+        (channels != RGB_BYTES_PER_PIXEL && channels != GRAY_BYTES_PER_PIXEL))
+        return 0;
+
+    _downsample_luma(data, linesize, channels, luma, luma_width, luma_height);
+
+    unsigned long long luma_sum = 0;
+    for (size_t i = 0; i < (size_t)luma_width * luma_height; ++i) luma_sum += luma[i];
+    double mean = (double)luma_sum / ((double)luma_width * luma_height);
+
+    long long sum = 0, sum_sq = 0;
+    for (int y = 1; y < luma_height - 1; ++y)
+    {
+        const uint8_t* mid = luma + (size_t)y * luma_width;
+        for (int x = 1; x < luma_width - 1; x += SCORE_CHUNK_SAMPLES)
+        {
+            int count = luma_width - 1 - x;
+            if (count > SCORE_CHUNK_SAMPLES)
+                count = SCORE_CHUNK_SAMPLES;
+            _laplacian_chunk(mid - luma_width + x, mid + x, mid + luma_width + x, count, &sum,
+                             &sum_sq);
+        }
+    }
+
+    double samples = (double)(luma_width - 2) * (luma_height - 2);
+    double laplacian_mean = sum / samples;
+    double variance = sum_sq / samples - laplacian_mean * laplacian_mean;
+    double deviation = (mean - SCORE_MID_GRAY) / SCORE_MID_GRAY;
+
+    return (variance > 0 ? variance : 0) * (1.0 - deviation * deviation);
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | jpg_image.cc
     ::  ::          ::  ::    Created  | 2025-06-20
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -24,13 +24,14 @@
 #include "utilities.h"
 
 /**
- * @brief Generates a JPEG image from raw RGB data.
+ * @brief Generates a JPEG image from raw RGB or grayscale data.
  *
- * This function creates a JPEG image using the provided raw RGB pixel data.
+ * This function creates a JPEG image using the provided raw pixel data.
  * It constructs the appropriate JPEG header and concatenates it with the
- * pixel data to produce a complete JPEG image.
+ * pixel data to produce a complete JPEG image. Data of one byte per pixel
+ * is encoded as a single-component grayscale JPEG.
  *
- * @param data     Pointer to the raw RGB pixel data.
+ * @param data     Pointer to the raw RGB or grayscale pixel data.
  * @param size     Size of the raw data in bytes.
  * @param width    Width of the image in pixels.
  * @param height   Height of the image in pixels.
@@ -42,8 +43,8 @@
  */
 image_t* get_jpg_image(const uint8_t* data, size_t size, int width, int height, short quality)
 {
-    if (!data || size != (size_t)(width * height * RGB_BYTES_PER_PIXEL) || width <= 0 ||
-        height <= 0 || quality < 0 || quality > 100)
+    int channels = get_image_channels(size, width, height);
+    if (!data || !channels || quality < 0 || quality > 100)
     {
         write_msg_to_fd(STDERR_FILENO, "(f) get_jpg_image | " ERROR_INVALID_ARGUMENTS "\n");
         return NULL;
@@ -61,14 +62,14 @@ image_t* get_jpg_image(const uint8_t* data, size_t size, int width, int height,
 
     cinfo.image_width = width;
     cinfo.image_height = height;
-    cinfo.input_components = RGB_BYTES_PER_PIXEL;
-    cinfo.in_color_space = JCS_RGB;
+    cinfo.input_components = channels;
+    cinfo.in_color_space = channels == GRAY_BYTES_PER_PIXEL ? JCS_GRAYSCALE : JCS_RGB;
 
     jpeg_set_defaults(&cinfo);
     jpeg_set_quality(&cinfo, quality, TRUE);
 
     jpeg_start_compress(&cinfo, TRUE);
-    int row_stride = width * RGB_BYTES_PER_PIXEL;
+    int row_stride = width * channels;
     while (cinfo.next_scanline < cinfo.image_height)
     {
         row_pointer[0] = (unsigned char*)&data[cinfo.next_scanline * row_stride];
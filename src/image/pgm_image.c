@@ -0,0 +1,80 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | pgm_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+
+/**
+ * @brief Generates a PGM (Portable Graymap) image from raw grayscale data.
+ *
+ * This function creates a PGM image in the "P5" binary format using the provided
+ * raw 8-bit luma data. It constructs the appropriate PGM header and concatenates
+ * it with the pixel data to produce a complete PGM image.
+ *
+ * @param data     Pointer to the raw grayscale pixel data.
+ * @param size     Size of the raw data in bytes.
+ * @param width    Width of the image in pixels.
+ * @param height   Height of the image in pixels.
+ *
+ * @return         Pointer to the newly allocated PGM image on success, or NULL on failure.
+ *
+ * @note           The caller is responsible for freeing the returned buffer.
+ */
+image_t* get_pgm_image(const uint8_t* data, size_t size, int width, int height)
+{
+    if (!data || get_image_channels(size, width, height) != GRAY_BYTES_PER_PIXEL)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_pgm_image | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    char header[64];
+    int header_len = snprintf(header, sizeof(header), "P5\n%d %d\n255\n", width, height);
+
+    if (header_len < 0 || (size_t)header_len >= sizeof(header))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_pgm_image | " ERROR_FAILED_TO_FORMAT_HEADER "\n");
+        return NULL;
+    }
+
+    image_t* pgm_image = (image_t*)malloc(sizeof(image_t));
+    if (!pgm_image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_pgm_image | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return NULL;
+    }
+
+    pgm_image->data = (uint8_t*)malloc(header_len + size);
+    if (!pgm_image->data)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_pgm_image | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        free(pgm_image);
+        return NULL;
+    }
+
+    memcpy(pgm_image->data, header, (size_t)header_len);
+    memcpy(pgm_image->data + header_len, data, size);
+
+    pgm_image->size = header_len + size;
+    pgm_image->width = width;
+    pgm_image->height = height;
+
+    return pgm_image;
+}
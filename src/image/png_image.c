@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | png_image.c
     ::  ::          ::  ::    Created  | 2025-06-20
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -25,13 +25,14 @@
 #include "utilities.h"
 
 /**
- * @brief Generates a PNG image from raw RGB data.
+ * @brief Generates a PNG image from raw RGB or grayscale data.
  *
- * This function creates a PNG image using the provided raw RGB pixel data.
+ * This function creates a PNG image using the provided raw pixel data.
  * It constructs the appropriate PNG header and concatenates it with the
- * pixel data to produce a complete PNG image.
+ * pixel data to produce a complete PNG image. Data of one byte per pixel
+ * is encoded as a grayscale PNG.
  *
- * @param data     Pointer to the raw RGB pixel data.
+ * @param data     Pointer to the raw RGB or grayscale pixel data.
  * @param size     Size of the raw data in bytes.
  * @param width    Width of the image in pixels.
  * @param height   Height of the image in pixels.
@@ -43,8 +44,8 @@
  */
 image_t* get_png_image(const uint8_t* data, size_t size, int width, int height, short quality)
 {
-    if (!data || size != (size_t)(width * height * RGB_BYTES_PER_PIXEL) || width <= 0 ||
-        height <= 0 || quality < 0 || quality > 100)
+    int channels = get_image_channels(size, width, height);
+    if (!data || !channels || quality < 0 || quality > 100)
     {
         write_msg_to_fd(STDERR_FILENO, "(f) get_png_image | " ERROR_INVALID_ARGUMENTS "\n");
         return NULL;
@@ -66,7 +67,7 @@ image_t* get_png_image(const uint8_t* data, size_t size, int width, int height,
     }
 
     for (int y = 0; y < height; y++)
-        row_pointers[y] = (png_bytep)(data + y * width * RGB_BYTES_PER_PIXEL);
+        row_pointers[y] = (png_bytep)(data + y * width * channels);
 
     memfp = open_memstream((char**)&png_buffer, &png_size);
     if (!memfp)
@@ -104,7 +105,8 @@ image_t* get_png_image(const uint8_t* data, size_t size, int width, int height,
     int png_compression = (int)((100 - quality) * 9 / 100);
     png_set_compression_level(png_ptr, png_compression);
 
-    png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+    int color_type = channels == GRAY_BYTES_PER_PIXEL ? PNG_COLOR_TYPE_GRAY : PNG_COLOR_TYPE_RGB;
+    png_set_IHDR(png_ptr, info_ptr, width, height, 8, color_type, PNG_INTERLACE_NONE,
                  PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
     png_write_info(png_ptr, info_ptr);
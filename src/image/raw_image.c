@@ -7,13 +7,14 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | raw_image.c
     ::  ::          ::  ::    Created  | 2025-06-19
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#include <string.h>
 #include <unistd.h>
 
 #include "errors.h"
@@ -25,7 +26,9 @@
  * @brief Initializes a image_t structure using the provided process, stream, and options.
  *
  * This function allocates and initializes a image_t object based on the image size
- * specified in the process, and the width and height from the stream's codec context.
+ * specified in the process, and the width and height of the stream's processed region.
+ * The pixels are the average of the accumulated frames (weighted by their durations with
+ * --weight-by-duration), or the best frame of --best-of.
  *
  * @param process   Pointer to the process_t structure containing image size and sum buffer.
  * @param stream    Pointer to the stream_t structure containing codec context and frame count.
@@ -58,8 +61,8 @@ image_t* _init_raw_image(const process_t* process, const stream_t* stream, const
     }
 
     raw_image->size = process->image_size;
-    raw_image->width = stream->codec_context->width;
-    raw_image->height = stream->codec_context->height;
+    raw_image->width = stream->region.width;
+    raw_image->height = stream->region.height;
 
     if (stream->number_of_frames_to_read == 0)
     {
@@ -67,8 +70,14 @@ image_t* _init_raw_image(const process_t* process, const stream_t* stream, const
         goto error;
     }
 
-    for (size_t i = 0; i < process->image_size; ++i)
-        raw_image->data[i] = (uint8_t)(process->sum_buffer[i] / stream->number_of_frames_to_read);
+    unsigned long long divisor = options->weight_by_duration && process->sum_weight
+                                     ? process->sum_weight
+                                     : stream->number_of_frames_to_read;
+    if (process->best_frame)
+        memcpy(raw_image->data, process->best_buffer, process->image_size);
+    else
+        for (size_t i = 0; i < process->image_size; ++i)
+            raw_image->data[i] = (uint8_t)(process->sum_buffer[i] / divisor);
 
     if (options->debug)
     {
@@ -90,6 +99,30 @@ error:
     return NULL;
 }
 
+/**
+ * @brief Returns the number of 8-bit channels per pixel of raw image data.
+ *
+ * @param size    Size of the raw data in bytes.
+ * @param width   Width of the image in pixels.
+ * @param height  Height of the image in pixels.
+ *
+ * @return RGB_BYTES_PER_PIXEL for RGB24 data, GRAY_BYTES_PER_PIXEL for grayscale data,
+ *         or 0 if the size matches neither layout.
+ */
+int get_image_channels(size_t size, int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    size_t pixels = (size_t)width * height;
+    if (size == pixels * RGB_BYTES_PER_PIXEL)
+        return RGB_BYTES_PER_PIXEL;
+    if (size == pixels * GRAY_BYTES_PER_PIXEL)
+        return GRAY_BYTES_PER_PIXEL;
+
+    return 0;
+}
+
 /**
  * @brief Frees the memory allocated for a image_t structure and its associated data buffer.
  *
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | scale_image.c
     ::  ::          ::  ::    Created  | 2025-06-19
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -19,6 +19,7 @@
 #include "errors.h"
 #include "libswscale/swscale.h"
 #include "process.h"
+#include "scaler.h"
 #include "utilities.h"
 
 /**
@@ -118,29 +119,64 @@ int _get_sws_flags(const options_t* options)
 }
 
 /**
- * @brief Scales a raw RGB image according to the specified options.
+ * @brief Reduces a raw RGB or grayscale image by an exact integer ratio with the box downscaler.
  *
- * This function resizes a raw RGB image in-place using the scale factor or target dimensions
- * provided in the options structure. It uses libswscale for high-quality scaling and updates
- * the image_t structure with the new image data, dimensions, and size.
+ * @param raw_image     Pointer to the source image_t.
+ * @param ratio         Reduction ratio returned by get_box_downscale_ratio().
+ * @param options       Pointer to an options_t structure with the thread count and debug flag.
+ * @param scaled_image  Pointer to a image_t structure receiving the scaled image.
  *
- * @param raw_image Pointer to a image_t structure containing the image data to be scaled.
- * @param options   Pointer to an options_t structure specifying scaling parameters and debug
- * options.
+ * @return 0 on success, or -1 on failure.
+ */
+static short _box_scale_image_data(const image_t* raw_image, int ratio, const options_t* options,
+                                   image_t* scaled_image)
+{
+    image_t* boxed = get_box_downscaled_image(raw_image, ratio, options->scale_threads);
+    if (!boxed)
+        return RTN_ERROR;
+
+    *scaled_image = *boxed;
+    free(boxed);
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET
+                         " Box downscaled image by 1/%d to size: %zu bytes, width: %d pixels, "
+                         "height: %d pixels\n",
+               ratio, scaled_image->size, scaled_image->width, scaled_image->height);
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Scales a raw RGB or grayscale image into a newly allocated buffer according to the
+ * specified options.
+ *
+ * The source image is not modified, so several callers may scale the same image concurrently.
+ * If the options do not require scaling, `scaled_image->data` is left NULL and the caller
+ * should use the source image as is. Exact 1/2, 1/3 and 1/4 reductions go through the box
+ * downscaler; every other factor falls back to libswscale.
+ *
+ * @param raw_image     Pointer to a image_t structure containing the image data to be scaled.
+ * @param options       Pointer to an options_t structure specifying scaling parameters.
+ * @param scaled_image  Pointer to a image_t structure receiving the scaled image; its data
+ *                      buffer is allocated by this function and owned by the caller.
  *
  * @return 0 on success, or -1 on failure.
  */
-short _scale_image(image_t* raw_image, const options_t* options)
+short _scale_image_data(const image_t* raw_image, const options_t* options, image_t* scaled_image)
 {
-    if (!raw_image || !options)
+    if (!raw_image || !options || !scaled_image)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_INVALID_ARGUMENTS "\n");
+        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image_data | " ERROR_INVALID_ARGUMENTS "\n");
         return RTN_ERROR;
     }
 
-    if (raw_image->width <= 0 || raw_image->height <= 0)
+    scaled_image->data = NULL;
+
+    int channels = get_image_channels(raw_image->size, raw_image->width, raw_image->height);
+    if (!channels)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_INVALID_IMAGE_SIZE "\n");
+        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image_data | " ERROR_INVALID_IMAGE_SIZE "\n");
         return RTN_ERROR;
     }
 
@@ -155,19 +191,28 @@ short _scale_image(image_t* raw_image, const options_t* options)
     if (dst_width <= 0 || dst_height <= 0)
     {
         write_msg_to_fd(STDERR_FILENO,
-                        "(f) _scale_image | " ERROR_INVALID_DESTINATION_DIMENSIONS "\n");
+                        "(f) _scale_image_data | " ERROR_INVALID_DESTINATION_DIMENSIONS "\n");
         return RTN_ERROR;
     }
 
-    if (dst_width < MIN_RESIZE_WIDTH || dst_width > MAX_RESIZE_WIDTH ||
-        dst_height < MIN_RESIZE_HEIGHT || dst_height > MAX_RESIZE_HEIGHT)
+    // A pyramid base may be as small as its levels
+    int min_width = options->pyramid_levels > 0 ? MIN_PYRAMID_WIDTH : MIN_RESIZE_WIDTH;
+    int min_height = options->pyramid_levels > 0 ? MIN_PYRAMID_HEIGHT : MIN_RESIZE_HEIGHT;
+    if (dst_width < min_width || dst_width > MAX_RESIZE_WIDTH || dst_height < min_height ||
+        dst_height > MAX_RESIZE_HEIGHT)
     {
         write_msg_to_fd(STDERR_FILENO,
-                        "(f) _scale_image | " ERROR_INVALID_DESTINATION_DIMENSIONS "\n");
+                        "(f) _scale_image_data | " ERROR_INVALID_DESTINATION_DIMENSIONS "\n");
         return RTN_ERROR;
     }
 
-    size_t dst_size = dst_width * dst_height * RGB_BYTES_PER_PIXEL;
+    int box_ratio = get_box_downscale_ratio(raw_image->width, raw_image->height, scale_factor);
+    if (box_ratio)
+        return _box_scale_image_data(raw_image, box_ratio, options, scaled_image);
+
+    size_t dst_size = (size_t)dst_width * dst_height * channels;
+    enum AVPixelFormat pixel_format =
+        channels == GRAY_BYTES_PER_PIXEL ? AV_PIX_FMT_GRAY8 : AV_PIX_FMT_RGB24;
 
     if (options->debug)
     {
@@ -176,49 +221,115 @@ short _scale_image(image_t* raw_image, const options_t* options)
                dst_size, dst_width, dst_height);
     }
 
-    uint8_t* dst_data = (uint8_t*)malloc(dst_width * dst_height * RGB_BYTES_PER_PIXEL);
+    struct SwsContext* scale_context = NULL;
+    AVFrame* src_frame = NULL;
+    AVFrame* dst_frame = NULL;
+    uint8_t* dst_data = (uint8_t*)malloc(dst_size);
     if (!dst_data)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _scale_image_data | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
         goto error;
     }
 
     int sws_flags = _get_sws_flags(options);
     if (sws_flags < 0)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_INVALID_ARGUMENTS "\n");
+        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image_data | " ERROR_INVALID_ARGUMENTS "\n");
         goto error;
     }
 
-    struct SwsContext* scale_context =
-        sws_getContext(raw_image->width, raw_image->height, AV_PIX_FMT_RGB24, dst_width, dst_height,
-                       AV_PIX_FMT_RGB24, sws_flags, NULL, NULL, NULL);
+    sws_key_t key = {.src_width = raw_image->width,
+                     .src_height = raw_image->height,
+                     .src_format = pixel_format,
+                     .dst_width = dst_width,
+                     .dst_height = dst_height,
+                     .dst_format = pixel_format,
+                     .flags = sws_flags,
+                     .threads = options->scale_threads};
+    scale_context = acquire_sws_context(&key);
     if (!scale_context)
     {
         write_msg_to_fd(STDERR_FILENO,
-                        "(f) _scale_image | " ERROR_FAILED_TO_CREATE_SWS_CONTEXT "\n");
+                        "(f) _scale_image_data | " ERROR_FAILED_TO_CREATE_SWS_CONTEXT "\n");
         goto error;
     }
 
-    const uint8_t* src_slices[1] = {raw_image->data};
-    int src_strides[1] = {raw_image->width * RGB_BYTES_PER_PIXEL};
-    uint8_t* dst_slices[1] = {dst_data};
-    int dst_strides[1] = {dst_width * RGB_BYTES_PER_PIXEL};
-    int scaled = sws_scale(scale_context, src_slices, src_strides, 0, raw_image->height, dst_slices,
-                           dst_strides);
-    sws_freeContext(scale_context);
-    if (scaled != dst_height)
+    src_frame = av_frame_alloc();
+    dst_frame = av_frame_alloc();
+    if (!src_frame || !dst_frame)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _scale_image_data | " ERROR_FAILED_TO_ALLOCATE_IMAGE_FRAME "\n");
+        goto error;
+    }
+
+    // The source is only read, the wrapper just lets the slice threads share it without a copy
+    if (wrap_frame_buffer(src_frame, raw_image->data, raw_image->width, raw_image->height,
+                          pixel_format) ||
+        wrap_frame_buffer(dst_frame, dst_data, dst_width, dst_height, pixel_format) ||
+        scale_frame(scale_context, dst_frame, src_frame))
         goto error;
+
+    av_frame_free(&src_frame);
+    av_frame_free(&dst_frame);
+    release_sws_context(scale_context);
+
+    scaled_image->data = dst_data;
+    scaled_image->width = dst_width;
+    scaled_image->height = dst_height;
+    scaled_image->size = dst_size;
+
+    return RTN_SUCCESS;
+
+error:
+    if (src_frame)
+        av_frame_free(&src_frame);
+    if (dst_frame)
+        av_frame_free(&dst_frame);
+    if (scale_context)
+        release_sws_context(scale_context);
+    if (dst_data)
+        free(dst_data);
+
+    return RTN_ERROR;
+}
+
+/**
+ * @brief Scales a raw RGB or grayscale image according to the specified options.
+ *
+ * This function resizes a raw RGB image in-place using the scale factor or target dimensions
+ * provided in the options structure. It uses the box downscaler for integer reductions and
+ * libswscale otherwise, and updates the image_t structure with the new image data,
+ * dimensions, and size.
+ *
+ * @param raw_image Pointer to a image_t structure containing the image data to be scaled.
+ * @param options   Pointer to an options_t structure specifying scaling parameters and debug
+ * options.
+ *
+ * @return 0 on success, or -1 on failure.
+ */
+short _scale_image(image_t* raw_image, const options_t* options)
+{
+    if (!raw_image || !options)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _scale_image | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
     }
 
+    image_t scaled_image;
+    if (_scale_image_data(raw_image, options, &scaled_image))
+        return RTN_ERROR;
+
+    if (!scaled_image.data)
+        return RTN_SUCCESS;
+
     free(raw_image->data);
 
-    raw_image->data = dst_data;
-    raw_image->width = dst_width;
-    raw_image->height = dst_height;
-    raw_image->size = dst_size;
+    raw_image->data = scaled_image.data;
+    raw_image->width = scaled_image.width;
+    raw_image->height = scaled_image.height;
+    raw_image->size = scaled_image.size;
 
     if (options->debug)
     {
@@ -229,10 +340,4 @@ short _scale_image(image_t* raw_image, const options_t* options)
     }
 
     return RTN_SUCCESS;
-
-error:
-    if (dst_data)
-        free(dst_data);
-
-    return RTN_ERROR;
 }
@@ -0,0 +1,323 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | scaler.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include "scaler.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libavutil/buffer.h"
+#include "libavutil/imgutils.h"
+#include "libavutil/opt.h"
+#include "utilities.h"
+
+/* One SwsContext kept for reuse; busy while a caller holds it */
+typedef struct sws_cache_entry_s
+{
+    sws_key_t key;                // Parameters the context was created for.
+    struct SwsContext* context;   // Cached context (NULL: free slot).
+    char busy;                    // Acquired and not yet released (0: idle, 1: busy).
+    unsigned long long last_use;  // Cache clock at the last release, for LRU eviction.
+} sws_cache_entry_t;
+
+static pthread_mutex_t _sws_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+static sws_cache_entry_t _sws_cache[SWS_CACHE_CAPACITY];
+static unsigned long long _sws_cache_clock = 0;
+static sws_cache_stats_t _sws_cache_stats = {0};
+
+/* Buffers wrapped by wrap_frame_buffer() stay owned by the caller */
+static void _keep_buffer(void* opaque, uint8_t* data)
+{
+    (void)opaque;
+    (void)data;
+}
+
+/**
+ * @brief Creates a SwsContext that converts and scales frames on several threads.
+ *
+ * libswscale only splits the work into slices for contexts configured through its
+ * AVOptions, so the context is allocated with sws_alloc_context() and its `threads`
+ * option is set before sws_init_context(). Frames must then be converted with
+ * scale_frame(); the legacy sws_scale() entry point stays single-threaded.
+ *
+ * @param src_width   Width of the source frames in pixels.
+ * @param src_height  Height of the source frames in pixels.
+ * @param src_format  Pixel format of the source frames.
+ * @param dst_width   Width of the destination frames in pixels.
+ * @param dst_height  Height of the destination frames in pixels.
+ * @param dst_format  Pixel format of the destination frames.
+ * @param flags       SWS_* flags selecting the scaling algorithm.
+ * @param threads     Number of slice threads (0: one per CPU, 1: no threading).
+ *
+ * @return Pointer to the initialized SwsContext, or NULL on failure.
+ *
+ * @note The caller is responsible for freeing the context with sws_freeContext().
+ */
+struct SwsContext* create_sws_context(int src_width, int src_height, enum AVPixelFormat src_format,
+                                      int dst_width, int dst_height, enum AVPixelFormat dst_format,
+                                      int flags, int threads)
+{
+    struct SwsContext* context = sws_alloc_context();
+    if (!context)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) create_sws_context | " ERROR_FAILED_TO_CREATE_SWS_CONTEXT "\n");
+        return NULL;
+    }
+
+    if (av_opt_set_int(context, "srcw", src_width, 0) < 0 ||
+        av_opt_set_int(context, "srch", src_height, 0) < 0 ||
+        av_opt_set_int(context, "src_format", src_format, 0) < 0 ||
+        av_opt_set_int(context, "dstw", dst_width, 0) < 0 ||
+        av_opt_set_int(context, "dsth", dst_height, 0) < 0 ||
+        av_opt_set_int(context, "dst_format", dst_format, 0) < 0 ||
+        av_opt_set_int(context, "sws_flags", flags, 0) < 0 ||
+        av_opt_set_int(context, "threads", threads, 0) < 0 ||
+        sws_init_context(context, NULL, NULL) < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) create_sws_context | " ERROR_FAILED_TO_CREATE_SWS_CONTEXT "\n");
+        sws_freeContext(context);
+        return NULL;
+    }
+
+    return context;
+}
+
+/**
+ * @brief Points a frame at a caller-owned image buffer without copying it.
+ *
+ * The buffer is attached as a reference-counted AVBufferRef whose free callback does
+ * nothing, which lets sws_scale_frame() read from or write into it directly instead
+ * of allocating a buffer of its own.
+ *
+ * @param frame   Pointer to the frame to set up.
+ * @param data    Pointer to the image buffer (tightly packed rows).
+ * @param width   Width of the image in pixels.
+ * @param height  Height of the image in pixels.
+ * @param format  Pixel format of the image.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short wrap_frame_buffer(AVFrame* frame, uint8_t* data, int width, int height,
+                        enum AVPixelFormat format)
+{
+    if (!frame || !data || width <= 0 || height <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) wrap_frame_buffer | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    int size = av_image_fill_arrays(frame->data, frame->linesize, data, format, width, height, 1);
+    if (size < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) wrap_frame_buffer | " ERROR_FAILED_TO_FILL_IMAGE_ARRAYS "\n");
+        return RTN_ERROR;
+    }
+
+    frame->buf[0] = av_buffer_create(data, (size_t)size, _keep_buffer, NULL, 0);
+    if (!frame->buf[0])
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) wrap_frame_buffer | " ERROR_FAILED_TO_ALLOCATE_BUFFER "\n");
+        return RTN_ERROR;
+    }
+
+    frame->width = width;
+    frame->height = height;
+    frame->format = format;
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Converts and scales a whole frame, on the slice threads of the context.
+ *
+ * @param context  Pointer to a SwsContext created by create_sws_context().
+ * @param dst      Pointer to the destination frame (e.g. set up with wrap_frame_buffer()).
+ * @param src      Pointer to the reference-counted source frame.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short scale_frame(struct SwsContext* context, AVFrame* dst, const AVFrame* src)
+{
+    if (!context || !dst || !src)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) scale_frame | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    if (sws_scale_frame(context, dst, src) < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) scale_frame | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* Keys are compared field by field, so struct padding never matters */
+static char _is_same_sws_key(const sws_key_t* a, const sws_key_t* b)
+{
+    return a->src_width == b->src_width && a->src_height == b->src_height &&
+           a->src_format == b->src_format && a->dst_width == b->dst_width &&
+           a->dst_height == b->dst_height && a->dst_format == b->dst_format &&
+           a->flags == b->flags && a->threads == b->threads;
+}
+
+/* Returns a free slot, or the least recently used idle one after freeing its context */
+static sws_cache_entry_t* _get_sws_cache_slot(void)
+{
+    sws_cache_entry_t* victim = NULL;
+
+    for (int i = 0; i < SWS_CACHE_CAPACITY; ++i)
+    {
+        sws_cache_entry_t* entry = &_sws_cache[i];
+        if (!entry->context)
+            return entry;
+        if (!entry->busy && (!victim || entry->last_use < victim->last_use))
+            victim = entry;
+    }
+
+    if (victim)
+    {
+        sws_freeContext(victim->context);
+        victim->context = NULL;
+        _sws_cache_stats.evictions++;
+    }
+
+    return victim;
+}
+
+/**
+ * @brief Returns a SwsContext for the given parameters, reusing an idle cached one if possible.
+ *
+ * Contexts are kept in a small LRU cache shared by frame conversion and image scaling, so
+ * repeated captures of the same geometry skip the filter setup, which is expensive for
+ * Lanczos or Gauss at large sizes. A SwsContext is not thread-safe: an acquired context is
+ * marked busy until release_sws_context(), and concurrent callers with the same key get
+ * contexts of their own. When every slot is busy the new context is simply not cached.
+ *
+ * @param key  Pointer to the parameters of the requested context.
+ *
+ * @return Pointer to a ready SwsContext, or NULL on failure.
+ *
+ * @note Every acquired context must be handed back with release_sws_context().
+ */
+struct SwsContext* acquire_sws_context(const sws_key_t* key)
+{
+    if (!key)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) acquire_sws_context | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&_sws_cache_mutex);
+    for (int i = 0; i < SWS_CACHE_CAPACITY; ++i)
+    {
+        sws_cache_entry_t* entry = &_sws_cache[i];
+        if (entry->context && !entry->busy && _is_same_sws_key(&entry->key, key))
+        {
+            entry->busy = 1;
+            _sws_cache_stats.hits++;
+            pthread_mutex_unlock(&_sws_cache_mutex);
+            return entry->context;
+        }
+    }
+    _sws_cache_stats.misses++;
+    pthread_mutex_unlock(&_sws_cache_mutex);
+
+    // Filter setup can take a while, so it runs outside the lock
+    struct SwsContext* context = create_sws_context(
+        key->src_width, key->src_height, key->src_format, key->dst_width, key->dst_height,
+        key->dst_format, key->flags, key->threads);
+    if (!context)
+        return NULL;
+
+    pthread_mutex_lock(&_sws_cache_mutex);
+    sws_cache_entry_t* slot = _get_sws_cache_slot();
+    if (slot)
+        *slot = (sws_cache_entry_t){.key = *key, .context = context, .busy = 1, .last_use = 0};
+    pthread_mutex_unlock(&_sws_cache_mutex);
+
+    return context;
+}
+
+/**
+ * @brief Hands a context obtained from acquire_sws_context() back to the cache.
+ *
+ * Contexts that did not fit into the cache are freed.
+ *
+ * @param context  Pointer to the context to release. If NULL, the function does nothing.
+ */
+void release_sws_context(struct SwsContext* context)
+{
+    if (!context)
+        return;
+
+    pthread_mutex_lock(&_sws_cache_mutex);
+    for (int i = 0; i < SWS_CACHE_CAPACITY; ++i)
+    {
+        if (_sws_cache[i].context == context)
+        {
+            _sws_cache[i].busy = 0;
+            _sws_cache[i].last_use = ++_sws_cache_clock;
+            pthread_mutex_unlock(&_sws_cache_mutex);
+            return;
+        }
+    }
+    pthread_mutex_unlock(&_sws_cache_mutex);
+
+    sws_freeContext(context);
+}
+
+/**
+ * @brief Returns the hit, miss and eviction counters of the SwsContext cache.
+ *
+ * @return A snapshot of the cache counters.
+ */
+sws_cache_stats_t get_sws_cache_stats(void)
+{
+    pthread_mutex_lock(&_sws_cache_mutex);
+    sws_cache_stats_t stats = _sws_cache_stats;
+    pthread_mutex_unlock(&_sws_cache_mutex);
+
+    return stats;
+}
+
+/**
+ * @brief Frees every idle context of the SwsContext cache.
+ *
+ * Busy contexts stay owned by their holders, which free them on release.
+ */
+void free_sws_cache(void)
+{
+    pthread_mutex_lock(&_sws_cache_mutex);
+    for (int i = 0; i < SWS_CACHE_CAPACITY; ++i)
+    {
+        sws_cache_entry_t* entry = &_sws_cache[i];
+        if (!entry->context)
+            continue;
+
+        if (!entry->busy)
+            sws_freeContext(entry->context);
+        memset(entry, 0, sizeof(*entry));
+    }
+    pthread_mutex_unlock(&_sws_cache_mutex);
+}
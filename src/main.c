@@ -7,17 +7,20 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | main.c
     ::  ::          ::  ::    Created  | 2025-06-04
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#include <stdio.h>
 #include <unistd.h>
 
 #include "errors.h"
+#include "output.h"
 #include "process.h"
+#include "scaler.h"
 #include "stream.h"
 #include "utilities.h"
 
@@ -32,7 +35,6 @@ int main(int argc, char* argv[])
 
     short error_code = 0;
     image_t* raw_image = NULL;
-    image_t* image = NULL;
     options_t* options = get_options(argc, argv);
     if (!options)
     {
@@ -52,7 +54,14 @@ int main(int argc, char* argv[])
         error_code = MAIN_SUCCESS_CODE;
         goto end;
     }
-    else if (!options->debug && !options->output_file_path && options->output_file_fd < 0)
+    else if (options->batch_file)
+    {
+        if (install_stop_handlers() || run_batch(options))
+            error_code = MAIN_ERROR_CODE;
+        goto end;
+    }
+    else if (!options->debug && !options->output_file_path && options->output_file_fd < 0 &&
+             !options->shm_name && !options->outputs_count)
     {
         write_msg_to_fd(STDERR_FILENO, "(f) main | " ERROR_NO_OUTPUT_SPECIFIED "\n");
         print_help(argv[0]);
@@ -60,49 +69,63 @@ int main(int argc, char* argv[])
         goto end;
     }
 
-    raw_image = get_raw_image(options);
-    if (!raw_image)
+    start_deadline(options->deadline_ms);
+
+    if ((options->shm_name || options->interval_sec) && install_stop_handlers())
     {
         error_code = MAIN_ERROR_CODE;
         goto end;
     }
 
-    if (options->output_file_fd < 0 && !options->output_file_path)
+    if (options->interval_sec)
+    {
+        if (run_timelapse(options))
+            error_code = MAIN_ERROR_CODE;
         goto end;
+    }
+    else if (options->burst_frames)
+    {
+        if (run_burst(options))
+            error_code = MAIN_ERROR_CODE;
+        goto end;
+    }
 
-    image = get_converted_image(options, raw_image);
-    if (!image)
+    raw_image = get_raw_image(options);
+    if (!raw_image)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) main | " ERROR_FAILED_TO_CONVERT_IMAGE "\n");
         error_code = MAIN_ERROR_CODE;
         goto end;
     }
 
-    if (options->output_file_path)
+    set_deadline_stage("encode");
+    if (deadline_exceeded() || write_outputs(options, raw_image))
+        error_code = MAIN_ERROR_CODE;
+
+end:
+    // A late capture fails even if it was written, naming the stage that ran out of budget
+    if (deadline_exceeded())
     {
-        if (write_data_to_file(options->output_file_path, image->data, image->size) < 0)
-            error_code = MAIN_ERROR_CODE;
-        else if (options->debug)
-            printf(ANSI_BLUE "Debug:" ANSI_RESET " Saved converted image to: %s\n",
-                   options->output_file_path);
+        char error_msg[128];
+        snprintf(error_msg, sizeof(error_msg), "(f) main | " ERROR_DEADLINE_EXCEEDED " Stage: %s\n",
+                 get_deadline_exhausted_stage());
+        write_msg_to_fd(STDERR_FILENO, error_msg);
+        error_code = MAIN_ERROR_CODE;
     }
 
-    if (options->output_file_fd != -1)
+    if (options && options->debug)
     {
-        if (write_data_to_fd(options->output_file_fd, image->data, image->size) < 0)
-            error_code = MAIN_ERROR_CODE;
-        else if (options->debug)
-            printf(ANSI_BLUE "Debug:" ANSI_RESET " Saved converted image to file descriptor: %d\n",
-                   options->output_file_fd);
+        sws_cache_stats_t sws_stats = get_sws_cache_stats();
+        printf(ANSI_BLUE "Debug:" ANSI_RESET
+                         " SwsContext cache: %llu hits, %llu misses, %llu evictions\n",
+               sws_stats.hits, sws_stats.misses, sws_stats.evictions);
     }
+    free_sws_cache();
+    free_box_downscale_pool();
 
-end:
     if (options)
         free_options(options);
     if (raw_image)
         free_image(raw_image);
-    if (image)
-        free_image(image);
 
     return error_code;
 }
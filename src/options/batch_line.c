@@ -0,0 +1,79 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | batch_line.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <ctype.h>
+#include <stddef.h>
+
+#include "options.h"
+
+/**
+ * @brief Splits one line of a batch file into an argument vector in place.
+ *
+ * Arguments are separated by whitespace; single or double quotes group an argument that
+ * contains whitespace (the quotes are removed). argv[0] is set to "streamshot" so the vector
+ * can be handed to get_options() like the command line of a single capture.
+ *
+ * Example: -i "rtsp://cam1/main" -o '/srv/snap/cam 1.jpg' -w 320
+ *
+ * @param line      The line to split; it is modified and the arguments point into it.
+ * @param argv      Array receiving the arguments, followed by a NULL terminator.
+ * @param max_args  Capacity of argv, including argv[0] and the terminator.
+ *
+ * @return Number of arguments including argv[0] (1 for a blank line), or -1 on an
+ *         unterminated quote or when the line has more arguments than argv can hold.
+ */
+int split_batch_line(char* line, char* argv[], int max_args)
+{
+    if (!line || !argv || max_args < 2)
+        return -1;
+
+    int argc = 0;
+    argv[argc++] = "streamshot";
+
+    char* read = line;
+    while (*read)
+    {
+        while (isspace((unsigned char)*read)) ++read;
+        if (!*read)
+            break;
+
+        if (argc >= max_args - 1)
+            return -1;
+
+        char* write = read;
+        argv[argc++] = write;
+        while (*read && !isspace((unsigned char)*read))
+        {
+            if (*read == '"' || *read == '\'')
+            {
+                char quote = *read++;
+                while (*read && *read != quote) *write++ = *read++;
+                if (!*read)
+                    return -1;
+                ++read;
+            }
+            else
+                *write++ = *read++;
+        }
+
+        if (*read)
+            ++read;
+        *write = '\0';
+    }
+
+    argv[argc] = NULL;
+    return argc;
+}
@@ -0,0 +1,95 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | crop.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "options.h"
+#include "utilities.h"
+
+#define CROP_SPEC_VALUES 4
+#define CROP_SPEC_SEPARATOR ','
+
+/**
+ * @brief Parses a region-of-interest specification "x,y,w,h" into a crop.
+ *
+ * The values are source pixels ("640,360,1280,720") or fractions of the frame
+ * ("0.25,0.25,0.5,0.5"). A specification is taken as normalised when every value
+ * is within [0, 1] and at least one of them is written with a decimal point, so
+ * "0,0,1,1" still means a 1x1 pixel region.
+ *
+ * @param spec  The crop specification string.
+ * @param crop  Pointer to the crop_t structure to populate.
+ *
+ * @return 0 if the specification was parsed successfully, or -1 on error.
+ *
+ * @note Range checks against the frame are left to the stream, which knows its size.
+ */
+short parse_crop(const char* spec, crop_t* crop)
+{
+    if (!spec || !crop)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_crop | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    float values[CROP_SPEC_VALUES];
+    char has_fraction = 0;
+    char in_unit_range = 1;
+    const char* cursor = spec;
+
+    for (int i = 0; i < CROP_SPEC_VALUES; ++i)
+    {
+        // Only plain non-negative numbers: no sign, whitespace, "inf" or "nan"
+        if (!isdigit((unsigned char)*cursor) && *cursor != '.')
+            goto error;
+
+        char* end = NULL;
+        values[i] = strtof(cursor, &end);
+        if (end == cursor)
+            goto error;
+
+        if (memchr(cursor, '.', (size_t)(end - cursor)))
+            has_fraction = 1;
+        if (values[i] > 1.0f)
+            in_unit_range = 0;
+
+        if (i < CROP_SPEC_VALUES - 1 && *end != CROP_SPEC_SEPARATOR)
+            goto error;
+        if (i == CROP_SPEC_VALUES - 1 && *end != '\0')
+            goto error;
+
+        cursor = end + 1;
+    }
+
+    if (values[2] <= 0.0f || values[3] <= 0.0f)
+        goto error;
+
+    crop->x = values[0];
+    crop->y = values[1];
+    crop->width = values[2];
+    crop->height = values[3];
+    crop->normalized = has_fraction && in_unit_range;
+
+    return RTN_SUCCESS;
+
+error:
+    write_msg_to_fd(STDERR_FILENO, "(f) parse_crop | " ERROR_INVALID_CROP "\n");
+    return RTN_ERROR;
+}
@@ -0,0 +1,56 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | exposure_end.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <string.h>
+
+#include "options.h"
+
+/* Helper function to get string representation of exposure_end_t */
+const char* exposure_end_to_string(exposure_end_t mode)
+{
+    switch (mode)
+    {
+        case EXPOSURE_END_FRAMES:
+            return "frames";
+        case EXPOSURE_END_PTS:
+            return "pts";
+        default:
+            return "unknown mode";
+    }
+}
+
+/* Helper function to convert string to exposure_end_t */
+exposure_end_t string_to_exposure_end(const char* str)
+{
+    if (!str)
+        return EXPOSURE_END_UNKNOWN;
+
+    char lower_str[16];
+    size_t i;
+    for (i = 0; i < sizeof(lower_str) - 1 && str[i]; ++i)
+        lower_str[i] = (char)tolower((unsigned char)str[i]);
+    lower_str[i] = '\0';
+
+    if (strcmp(lower_str, "frames") == 0)
+        return EXPOSURE_END_FRAMES;
+    else if (strcmp(lower_str, "pts") == 0)
+        return EXPOSURE_END_PTS;
+    else
+        return EXPOSURE_END_UNKNOWN;
+}
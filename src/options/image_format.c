@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | image_format.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -34,11 +34,32 @@ const char* image_format_to_string(image_format_t format)
             return "png";
         case IMAGE_FORMAT_PPM:
             return "ppm";
+        case IMAGE_FORMAT_PGM:
+            return "pgm";
         default:
             return "unknown format";
     }
 }
 
+/* Helper function to get the MIME type of image_format_t */
+const char* image_format_to_mime_type(image_format_t format)
+{
+    switch (format)
+    {
+        case IMAGE_FORMAT_JPG:
+        case IMAGE_FORMAT_JPEG:
+            return "image/jpeg";
+        case IMAGE_FORMAT_PNG:
+            return "image/png";
+        case IMAGE_FORMAT_PPM:
+            return "image/x-portable-pixmap";
+        case IMAGE_FORMAT_PGM:
+            return "image/x-portable-graymap";
+        default:
+            return "application/octet-stream";
+    }
+}
+
 /* Helper function to convert string to image_format_t */
 image_format_t string_to_image_format(const char* str)
 {
@@ -59,6 +80,8 @@ image_format_t string_to_image_format(const char* str)
         return IMAGE_FORMAT_PNG;
     else if (strcmp(lower_str, "ppm") == 0)
         return IMAGE_FORMAT_PPM;
+    else if (strcmp(lower_str, "pgm") == 0)
+        return IMAGE_FORMAT_PGM;
     else
         return IMAGE_FORMAT_UNKNOWN;
 }
@@ -0,0 +1,71 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | input_profile.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "options.h"
+#include "utilities.h"
+
+/**
+ * @brief Parses an input profile specification ("WxH=url") into an input profile.
+ *
+ * Example: "3840x2160=rtsp://camera/main" or "640x360=rtsp://camera/sub".
+ *
+ * @param spec     The input profile specification string.
+ * @param profile  Pointer to the input_profile_t structure to populate.
+ *
+ * @return 0 if the specification was parsed successfully, or -1 on error.
+ *
+ * @note On success profile->url is dynamically allocated and must be freed by the caller.
+ *       URL checks are left to validate_options().
+ */
+short parse_input_profile(const char* spec, input_profile_t* profile)
+{
+    if (!spec || !profile)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_input_profile | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    profile->width = 0;
+    profile->height = 0;
+    profile->url = NULL;
+
+    int consumed = 0;
+    if (sscanf(spec, "%dx%d=%n", &profile->width, &profile->height, &consumed) != 2 ||
+        !consumed || profile->width <= 0 || profile->height <= 0 || spec[consumed] == '\0')
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) parse_input_profile | " ERROR_INVALID_INPUT_PROFILE "\n");
+        return RTN_ERROR;
+    }
+
+    profile->url = strdup(spec + consumed);
+    if (!profile->url)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) parse_input_profile | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
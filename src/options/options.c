@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | options.c
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -48,6 +48,7 @@ static options_t* _init_options(void)
     }
 
     options->rtsp_url = NULL;
+    options->input_alt = NULL;
     options->timeout_sec = DEFAULT_TIMEOUT_SEC;
     options->output_file_path = NULL;
     options->output_file_fd = -1;
@@ -66,6 +67,38 @@ static options_t* _init_options(void)
         free(options);
         return NULL;
     }
+    options->shm_name = NULL;
+    options->shm_slots = DEFAULT_SHM_SLOTS;
+    options->shm_format = DEFAULT_SHM_FORMAT;
+    options->write_timeout_ms = DEFAULT_WRITE_TIMEOUT_MS;
+    options->atomic_write = 0;
+    options->fsync = 0;
+    options->outputs = NULL;
+    options->outputs_count = 0;
+    options->inputs = NULL;
+    options->inputs_count = 0;
+    options->pyramid_levels = 0;
+    options->scale_threads = DEFAULT_SCALE_THREADS;
+    options->crop = (crop_t){0};
+    options->gray = 0;
+    options->interval_sec = DEFAULT_INTERVAL_SEC;
+    options->count = DEFAULT_TIMELAPSE_COUNT;
+    options->pipeline_depth = DEFAULT_PIPELINE_DEPTH;
+    options->burst_frames = DEFAULT_BURST_FRAMES;
+    options->best_of = DEFAULT_BEST_OF;
+    options->stack_mode = DEFAULT_STACK_MODE;
+    options->exposure_end = EXPOSURE_END_FRAMES;
+    options->weight_by_duration = 0;
+    options->fast_start = 0;
+    options->profile_cache_dir = NULL;
+    options->video_track = DEFAULT_VIDEO_TRACK;
+    options->transport = DEFAULT_TRANSPORT;
+    options->buffer_size = DEFAULT_BUFFER_SIZE;
+    options->reorder_queue = DEFAULT_REORDER_QUEUE;
+    options->max_loss = DEFAULT_MAX_LOSS;
+    options->deadline_ms = DEFAULT_DEADLINE_MS;
+    options->batch_file = NULL;
+    options->jobs = DEFAULT_JOBS;
     options->help = 0;
     options->version = 0;
     return options;
@@ -138,6 +171,12 @@ void free_options(options_t* options)
         options->rtsp_url = NULL;
     }
 
+    if (options->input_alt)
+    {
+        free(options->input_alt);
+        options->input_alt = NULL;
+    }
+
     if (options->output_file_path)
     {
         free(options->output_file_path);
@@ -150,6 +189,44 @@ void free_options(options_t* options)
         options->debug_dir = NULL;
     }
 
+    if (options->shm_name)
+    {
+        free(options->shm_name);
+        options->shm_name = NULL;
+    }
+
+    if (options->batch_file)
+    {
+        free(options->batch_file);
+        options->batch_file = NULL;
+    }
+
+    if (options->profile_cache_dir)
+    {
+        free(options->profile_cache_dir);
+        options->profile_cache_dir = NULL;
+    }
+
+    if (options->outputs)
+    {
+        for (int i = 0; i < options->outputs_count; ++i)
+            free(options->outputs[i].path);
+
+        free(options->outputs);
+        options->outputs = NULL;
+        options->outputs_count = 0;
+    }
+
+    if (options->inputs)
+    {
+        for (int i = 0; i < options->inputs_count; ++i)
+            free(options->inputs[i].url);
+
+        free(options->inputs);
+        options->inputs = NULL;
+        options->inputs_count = 0;
+    }
+
     free(options);
     options = NULL;
 }
@@ -0,0 +1,152 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | output_spec.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "options.h"
+#include "utilities.h"
+
+#define OUTPUT_SPEC_SEPARATOR ':'
+#define OUTPUT_SPEC_PATH_KEY "path="
+
+/* Returns the next ':'-separated token of the spec, or NULL when the spec is exhausted */
+static char* _next_token(char** cursor)
+{
+    if (!*cursor)
+        return NULL;
+
+    char* token = *cursor;
+    char* separator = strchr(token, OUTPUT_SPEC_SEPARATOR);
+    if (separator)
+    {
+        *separator = '\0';
+        *cursor = separator + 1;
+    }
+    else
+        *cursor = NULL;
+
+    return token;
+}
+
+/**
+ * @brief Parses an output specification into an output variant.
+ *
+ * The specification starts with the image format, followed by optional
+ * ':'-separated key=value pairs:
+ *   - q=<uint>     : Image quality.
+ *   - w=<uint>     : Resize to fit specified width.
+ *   - h=<uint>     : Resize to fit specified height.
+ *   - s=<float>    : Image scale factor (disables w and h, as --scale does).
+ *   - fd=<uint>    : Output file descriptor.
+ *   - path=<path>  : Output file path. Must be the last key; the rest of the
+ *                    specification is taken verbatim, so the path may contain ':'.
+ *
+ * Example: "jpg:q=85:w=1920:path=/snapshots/full.jpg" or "png:w=320:fd=4".
+ *
+ * @param spec     The output specification string.
+ * @param variant  Pointer to the output_variant_t structure to populate.
+ *
+ * @return 0 if the specification was parsed successfully, or -1 on error.
+ *
+ * @note On success variant->path is dynamically allocated and must be freed by the caller.
+ *       Range checks are left to validate_options().
+ */
+short parse_output_spec(const char* spec, output_variant_t* variant)
+{
+    if (!spec || !variant)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_output_spec | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    variant->format = IMAGE_FORMAT_UNKNOWN;
+    variant->image_quality = DEFAULT_IMAGE_QUALITY;
+    variant->scale_factor = DEFAULT_SCALE_FACTOR;
+    variant->resize_width = 0;
+    variant->resize_height = 0;
+    variant->path = NULL;
+    variant->fd = -1;
+
+    char* copy = strdup(spec);
+    if (!copy)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) parse_output_spec | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+
+    char* cursor = copy;
+    variant->format = string_to_image_format(_next_token(&cursor));
+    if (variant->format == IMAGE_FORMAT_UNKNOWN)
+        goto error;
+
+    while (cursor)
+    {
+        if (strncmp(cursor, OUTPUT_SPEC_PATH_KEY, strlen(OUTPUT_SPEC_PATH_KEY)) == 0)
+        {
+            const char* path = cursor + strlen(OUTPUT_SPEC_PATH_KEY);
+            if (variant->path || *path == '\0')
+                goto error;
+
+            variant->path = strdup(path);
+            if (!variant->path)
+                goto error;
+
+            break;
+        }
+
+        char* key = _next_token(&cursor);
+        char* value = strchr(key, '=');
+        if (!value || value[1] == '\0')
+            goto error;
+
+        *value++ = '\0';
+
+        if (strcmp(key, "q") == 0)
+            variant->image_quality = atoi(value);
+        else if (strcmp(key, "w") == 0)
+            variant->resize_width = atoi(value);
+        else if (strcmp(key, "h") == 0)
+            variant->resize_height = atoi(value);
+        else if (strcmp(key, "s") == 0)
+            variant->scale_factor = atof(value);
+        else if (strcmp(key, "fd") == 0)
+            variant->fd = atoi(value);
+        else
+            goto error;
+    }
+
+    if (variant->scale_factor != DEFAULT_SCALE_FACTOR)
+    {
+        variant->resize_width = -1;   // Disable width resize if scale is set.
+        variant->resize_height = -1;  // Disable height resize if scale is set.
+    }
+
+    free(copy);
+    return RTN_SUCCESS;
+
+error:
+    write_msg_to_fd(STDERR_FILENO, "(f) parse_output_spec | " ERROR_INVALID_OUTPUT_SPEC "\n");
+    free(copy);
+    free(variant->path);
+    variant->path = NULL;
+    return RTN_ERROR;
+}
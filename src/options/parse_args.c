@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | parse_args.c
     ::  ::          ::  ::    Created  | 2025-06-07
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -53,14 +53,99 @@ static void _free_argument(_argument_t* argument)
     }
 }
 
+/**
+ * @brief Parses an --output specification and appends it to options->outputs.
+ *
+ * @param options  Pointer to the options_t structure to extend.
+ * @param value    The raw --output flag value.
+ *
+ * @return 0 on success, or -1 if the specification is invalid or too many were given.
+ */
+static short _add_output_variant(options_t* options, const char* value)
+{
+    if (options->outputs_count >= MAX_OUTPUT_VARIANTS)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_args | " ERROR_TOO_MANY_OUTPUTS "\n");
+        return RTN_ERROR;
+    }
+
+    output_variant_t* outputs =
+        realloc(options->outputs, sizeof(output_variant_t) * (options->outputs_count + 1));
+    if (!outputs)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_args | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+    options->outputs = outputs;
+
+    char* spec = trim_flag_value(value);
+    short result = parse_output_spec(spec, &options->outputs[options->outputs_count]);
+    free(spec);
+    if (result)
+        return RTN_ERROR;
+
+    options->outputs_count++;
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Parses an --input-profile specification and appends it to options->inputs.
+ *
+ * @param options  Pointer to the options_t structure to extend.
+ * @param value    The raw --input-profile flag value.
+ *
+ * @return 0 on success, or -1 if the specification is invalid or too many were given.
+ */
+static short _add_input_profile(options_t* options, const char* value)
+{
+    if (options->inputs_count >= MAX_INPUT_PROFILES)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_args | " ERROR_TOO_MANY_INPUT_PROFILES "\n");
+        return RTN_ERROR;
+    }
+
+    input_profile_t* inputs =
+        realloc(options->inputs, sizeof(input_profile_t) * (options->inputs_count + 1));
+    if (!inputs)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) parse_args | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+    options->inputs = inputs;
+
+    char* spec = trim_flag_value(value);
+    short result = parse_input_profile(spec, &options->inputs[options->inputs_count]);
+    free(spec);
+    if (result)
+        return RTN_ERROR;
+
+    options->inputs_count++;
+    return RTN_SUCCESS;
+}
+
+/* Flags that are standalone keys and never take a value */
+static const char* _standalone_flags[] = {
+    "-v", "--version", "-h", "--help", "-d", "--debug", "--atomic-write", "--fsync",
+    "--gray", "--weight-by-duration", "--fast-start", NULL};
+
+static short _is_standalone_flag(const char* key)
+{
+    for (size_t i = 0; _standalone_flags[i]; ++i)
+        if (strcmp(key, _standalone_flags[i]) == 0)
+            return 1;
+
+    return 0;
+}
+
 /**
  * @brief Parses a command-line argument at the specified index and returns it as an _argument_t
  * structure.
  *
  * This function processes the argument at the given index in the argv array, extracting the key and
  * value if present. It supports arguments in the form of "key=value" as well as "key value" pairs.
- * Special flags such as "-v", "--version", "-h", "--help", "-d", and "--debug" are handled as
- * standalone keys without values.
+ * Special flags such as "-v", "--version", "-h", "--help", "-d", "--debug", "--atomic-write",
+ * "--fsync", "--gray", "--weight-by-duration" and "--fast-start" are handled as standalone keys
+ * without values.
  *
  * @param argc   The count of command-line arguments.
  * @param argv   The array of command-line argument strings.
@@ -122,11 +207,11 @@ static _argument_t* _get_argument(int argc, char* argv[], int* index)
         }
 
         strcpy(argument->key, argv[*index]);
-        if (strcmp(argument->key, "-v") != 0 && strcmp(argument->key, "--version") != 0 &&
-            strcmp(argument->key, "-h") != 0 && strcmp(argument->key, "--help") != 0 &&
-            strcmp(argument->key, "-d") != 0 && strcmp(argument->key, "--debug") != 0)
+        if (!_is_standalone_flag(argument->key))
         {
-            if (*index + 1 < argc && argv[*index + 1][0] != '-')
+            // A lone "-" is a value: standard input (--batch -)
+            if (*index + 1 < argc &&
+                (argv[*index + 1][0] != '-' || strcmp(argv[*index + 1], "-") == 0))
                 argument->value = argv[++(*index)];
             else
                 goto error;
@@ -154,6 +239,8 @@ error:
  *   - -v, --version           : Print version information and exit.
  *   - -h, --help              : Print help message and exit.
  *   - -i, --input             : Set the RTSP input URL.
+ *   -   , --input-alt         : Set an alternative RTSP URL raced against the input.
+ *   -   , --input-profile     : Add a resolution profile of the input ("WxH=url").
  *   - -t, --timeout           : Set RTSP stream connection timeout in seconds.
  *   - -o, --output-file       : Set the output file path.
  *   - -O, --output-fd         : Set the output file descriptor.
@@ -166,6 +253,35 @@ error:
  *   - -d, --debug             : Enable debug mode.
  *   -   , --debug-step        : Set the debug step value.
  *   -   , --debug-dir         : Set the debug directory.
+ *   -   , --publish-shm       : Set the shared-memory ring name to publish frames to.
+ *   -   , --publish-slots     : Set the number of slots in the shared-memory ring.
+ *   -   , --publish-format    : Set the pixel layout of published frames.
+ *   -   , --write-timeout     : Set the output file descriptor write deadline in ms.
+ *   -   , --atomic-write      : Write the output file via a temp file and rename it into place.
+ *   -   , --fsync             : Flush the output file to stable storage before publishing it.
+ *   -   , --output            : Add an output variant ("fmt:q=..:w=..:h=..:s=..:fd=..:path=..").
+ *   -   , --pyramid           : Set the number of halving pyramid levels to save.
+ *   -   , --crop              : Set the region of interest cut from every frame ("x,y,w,h").
+ *   -   , --scale-threads     : Set the number of threads for colour conversion and scaling.
+ *   -   , --gray              : Capture and encode the luma plane only.
+ *   -   , --interval          : Set the timelapse interval in seconds.
+ *   -   , --count             : Set the number of timelapse snapshots.
+ *   -   , --pipeline          : Set the encoder queue depth of a pipelined timelapse.
+ *   -   , --burst             : Set the number of consecutive frames saved as separate images.
+ *   -   , --best-of           : Set the number of frames scored to keep the sharpest one.
+ *   -   , --stack             : Set the frames an exposure accumulates (all or keyframes).
+ *   -   , --exposure-end      : Set what ends an exposure (frames or pts).
+ *   -   , --weight-by-duration: Weight exposure frames by their duration.
+ *   -   , --fast-start        : Bound stream probing to reach the first frame sooner.
+ *   -   , --profile-cache     : Set the directory of cached stream profiles.
+ *   -   , --video-track       : Set the video track to decode (0: first).
+ *   -   , --transport         : Set the RTSP lower transport (tcp, udp, udp_multicast, http, auto).
+ *   -   , --buffer-size       : Set the UDP socket receive buffer in bytes.
+ *   -   , --reorder-queue     : Set the number of RTP packets held for reordering.
+ *   -   , --max-loss          : Set the tolerated share of lost or corrupt frames in percent.
+ *   -   , --deadline-ms       : Set the end-to-end budget of a capture in milliseconds.
+ *   -   , --batch             : Run the capture jobs listed in a file ("-": stdin).
+ *   -   , --jobs              : Set the number of concurrent batch captures.
  *
  * If an invalid argument is encountered, an error message is written to stderr
  * and the function returns an error code.
@@ -211,6 +327,16 @@ short parse_args(int argc, char* argv[], options_t* options)
         }
         else if (MATCH("-i", "--input"))
             options->rtsp_url = trim_flag_value(value);
+        else if (MATCH("--input-alt", "--input-alt"))
+            options->input_alt = trim_flag_value(value);
+        else if (MATCH("--input-profile", "--input-profile"))
+        {
+            if (_add_input_profile(options, value))
+            {
+                _free_argument(argument);
+                return RTN_ERROR;
+            }
+        }
         else if (MATCH("-t", "--timeout") && value && strlen(value) > 0)
             options->timeout_sec = atoi(value);
         else if (MATCH("-o", "--output-file"))
@@ -253,6 +379,98 @@ short parse_args(int argc, char* argv[], options_t* options)
             options->debug_step = atoi(value);
         else if (MATCH("--debug-dir", "--debug-dir"))
             options->debug_dir = trim_flag_value(value);
+        else if (MATCH("--publish-shm", "--publish-shm"))
+            options->shm_name = trim_flag_value(value);
+        else if (MATCH("--publish-slots", "--publish-slots") && value && strlen(value) > 0)
+            options->shm_slots = atoi(value);
+        else if (MATCH("--publish-format", "--publish-format"))
+        {
+            char* format_arg = trim_flag_value(value);
+            options->shm_format = string_to_shm_format(format_arg);
+            free(format_arg);
+        }
+        else if (MATCH("--write-timeout", "--write-timeout") && value && strlen(value) > 0)
+            options->write_timeout_ms = atoi(value);
+        else if (MATCH("--atomic-write", "--atomic-write"))
+            options->atomic_write = 1;
+        else if (MATCH("--fsync", "--fsync"))
+        {
+            options->atomic_write = 1;
+            options->fsync = 1;
+        }
+        else if (MATCH("--pyramid", "--pyramid") && value && strlen(value) > 0)
+            options->pyramid_levels = atoi(value);
+        else if (MATCH("--scale-threads", "--scale-threads") && value && strlen(value) > 0)
+            options->scale_threads = atoi(value);
+        else if (MATCH("--gray", "--gray"))
+            options->gray = 1;
+        else if (MATCH("--interval", "--interval") && value && strlen(value) > 0)
+            options->interval_sec = atoi(value);
+        else if (MATCH("--count", "--count") && value && strlen(value) > 0)
+            options->count = atoi(value);
+        else if (MATCH("--pipeline", "--pipeline") && value && strlen(value) > 0)
+            options->pipeline_depth = atoi(value);
+        else if (MATCH("--burst", "--burst") && value && strlen(value) > 0)
+            options->burst_frames = atoi(value);
+        else if (MATCH("--best-of", "--best-of") && value && strlen(value) > 0)
+            options->best_of = atoi(value);
+        else if (MATCH("--exposure-end", "--exposure-end"))
+        {
+            char* mode_arg = trim_flag_value(value);
+            options->exposure_end = string_to_exposure_end(mode_arg);
+            free(mode_arg);
+        }
+        else if (MATCH("--weight-by-duration", "--weight-by-duration"))
+            options->weight_by_duration = 1;
+        else if (MATCH("--fast-start", "--fast-start"))
+            options->fast_start = 1;
+        else if (MATCH("--profile-cache", "--profile-cache"))
+            options->profile_cache_dir = trim_flag_value(value);
+        else if (MATCH("--video-track", "--video-track") && value && strlen(value) > 0)
+            options->video_track = atoi(value);
+        else if (MATCH("--transport", "--transport"))
+        {
+            char* transport_arg = trim_flag_value(value);
+            options->transport = string_to_transport(transport_arg);
+            free(transport_arg);
+        }
+        else if (MATCH("--buffer-size", "--buffer-size") && value && strlen(value) > 0)
+            options->buffer_size = atoi(value);
+        else if (MATCH("--reorder-queue", "--reorder-queue") && value && strlen(value) > 0)
+            options->reorder_queue = atoi(value);
+        else if (MATCH("--max-loss", "--max-loss") && value && strlen(value) > 0)
+            options->max_loss = atoi(value);
+        else if (MATCH("--deadline-ms", "--deadline-ms") && value && strlen(value) > 0)
+            options->deadline_ms = atoi(value);
+        else if (MATCH("--batch", "--batch"))
+            options->batch_file = trim_flag_value(value);
+        else if (MATCH("--jobs", "--jobs") && value && strlen(value) > 0)
+            options->jobs = atoi(value);
+        else if (MATCH("--stack", "--stack"))
+        {
+            char* mode_arg = trim_flag_value(value);
+            options->stack_mode = string_to_stack_mode(mode_arg);
+            free(mode_arg);
+        }
+        else if (MATCH("--crop", "--crop"))
+        {
+            char* crop_arg = trim_flag_value(value);
+            short result = parse_crop(crop_arg, &options->crop);
+            free(crop_arg);
+            if (result)
+            {
+                _free_argument(argument);
+                return RTN_ERROR;
+            }
+        }
+        else if (MATCH("--output", "--output"))
+        {
+            if (_add_output_variant(options, value))
+            {
+                _free_argument(argument);
+                return RTN_ERROR;
+            }
+        }
         else
         {
             char err_msg[256];
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | printer.c
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -40,6 +40,11 @@ void print_options(const options_t* options)
     }
 
     printf("RTSP url: %s\n", options->rtsp_url ? options->rtsp_url : "NULL");
+    printf("Alternative RTSP url: %s\n", options->input_alt ? options->input_alt : "NULL");
+    printf("Input Profiles: %d\n", options->inputs_count);
+    for (int i = 0; i < options->inputs_count; ++i)
+        printf("  [%d] %dx%d: %s\n", i, options->inputs[i].width, options->inputs[i].height,
+               options->inputs[i].url);
     printf("Timeout: %d seconds\n", options->timeout_sec);
     printf("Output File Path: %s\n",
            options->output_file_path ? options->output_file_path : "NULL");
@@ -56,4 +61,51 @@ void print_options(const options_t* options)
     printf("Debug Mode: %s\n", options->debug ? "Enabled" : "Disabled");
     printf("Debug Step Interval: %d steps\n", options->debug_step);
     printf("Debug Directory: %s\n", options->debug_dir ? options->debug_dir : "NULL");
+    printf("Publish Shared Memory: %s\n", options->shm_name ? options->shm_name : "NULL");
+    printf("Publish Slots: %d\n", options->shm_slots);
+    printf("Publish Format: %s\n", shm_format_to_string(options->shm_format));
+    printf("Write Timeout (ms): %d\n", options->write_timeout_ms);
+    printf("Atomic Write: %s\n", options->atomic_write ? "Enabled" : "Disabled");
+    printf("Fsync: %s\n", options->fsync ? "Enabled" : "Disabled");
+    printf("Pyramid Levels: %d\n", options->pyramid_levels);
+    printf("Scale Threads: %d%s\n", options->scale_threads,
+           options->scale_threads ? "" : " (one per CPU)");
+    if (options->crop.width > 0.0f)
+        printf("Crop: %g,%g,%g,%g (%s)\n", options->crop.x, options->crop.y, options->crop.width,
+               options->crop.height, options->crop.normalized ? "normalized" : "pixels");
+    else
+        printf("Crop: Disabled\n");
+    printf("Gray: %s\n", options->gray ? "Enabled" : "Disabled");
+    printf("Timelapse Interval (sec): %d\n", options->interval_sec);
+    printf("Timelapse Count: %d%s\n", options->count,
+           options->count ? "" : " (until signalled)");
+    printf("Pipeline Depth: %d%s\n", options->pipeline_depth,
+           options->pipeline_depth ? "" : " (off)");
+    printf("Burst Frames: %d%s\n", options->burst_frames, options->burst_frames ? "" : " (off)");
+    printf("Best Of: %d%s\n", options->best_of, options->best_of ? " frames" : " (off)");
+    printf("Stack Mode: %s\n", stack_mode_to_string(options->stack_mode));
+    printf("Exposure End: %s\n", exposure_end_to_string(options->exposure_end));
+    printf("Weight By Duration: %s\n", options->weight_by_duration ? "Enabled" : "Disabled");
+    printf("Fast Start: %s\n", options->fast_start ? "Enabled" : "Disabled");
+    printf("Profile Cache: %s\n", options->profile_cache_dir ? options->profile_cache_dir : "NULL");
+    printf("Video Track: %d\n", options->video_track);
+    printf("Transport: %s\n", transport_to_string(options->transport));
+    printf("Buffer Size: %d%s\n", options->buffer_size,
+           options->buffer_size ? " bytes" : " (system default)");
+    printf("Reorder Queue: %d%s\n", options->reorder_queue,
+           options->reorder_queue < 0 ? " (demuxer default)" : " packets");
+    printf("Max Loss: %d%%\n", options->max_loss);
+    printf("Deadline: %d%s\n", options->deadline_ms, options->deadline_ms ? " ms" : " (none)");
+    printf("Batch: %s\n", options->batch_file ? options->batch_file : "NULL");
+    printf("Jobs: %d%s\n", options->jobs, options->jobs ? "" : " (one per CPU)");
+    printf("Output Variants: %d\n", options->outputs_count);
+    for (int i = 0; i < options->outputs_count; ++i)
+    {
+        const output_variant_t* variant = &options->outputs[i];
+        printf("  [%d] Format: %s, Quality: %d, Scale: %.2f, Width: %d, Height: %d, Path: %s, "
+               "FD: %d\n",
+               i, image_format_to_string(variant->format), variant->image_quality,
+               variant->scale_factor, variant->resize_width, variant->resize_height,
+               variant->path ? variant->path : "NULL", variant->fd);
+    }
 }
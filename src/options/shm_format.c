@@ -0,0 +1,56 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | shm_format.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <string.h>
+
+#include "options.h"
+
+/* Helper function to get string representation of shm_format_t */
+const char* shm_format_to_string(shm_format_t format)
+{
+    switch (format)
+    {
+        case SHM_FORMAT_RGB:
+            return "rgb";
+        case SHM_FORMAT_YUV:
+            return "yuv";
+        default:
+            return "unknown format";
+    }
+}
+
+/* Helper function to convert string to shm_format_t */
+shm_format_t string_to_shm_format(const char* str)
+{
+    if (!str)
+        return SHM_FORMAT_UNKNOWN;
+
+    char lower_str[16];
+    size_t i;
+    for (i = 0; i < sizeof(lower_str) - 1 && str[i]; ++i)
+        lower_str[i] = (char)tolower((unsigned char)str[i]);
+    lower_str[i] = '\0';
+
+    if (strcmp(lower_str, "rgb") == 0)
+        return SHM_FORMAT_RGB;
+    else if (strcmp(lower_str, "yuv") == 0)
+        return SHM_FORMAT_YUV;
+    else
+        return SHM_FORMAT_UNKNOWN;
+}
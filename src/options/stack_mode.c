@@ -0,0 +1,56 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | stack_mode.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <string.h>
+
+#include "options.h"
+
+/* Helper function to get string representation of stack_mode_t */
+const char* stack_mode_to_string(stack_mode_t mode)
+{
+    switch (mode)
+    {
+        case STACK_MODE_ALL:
+            return "all";
+        case STACK_MODE_KEYFRAMES:
+            return "keyframes";
+        default:
+            return "unknown mode";
+    }
+}
+
+/* Helper function to convert string to stack_mode_t */
+stack_mode_t string_to_stack_mode(const char* str)
+{
+    if (!str)
+        return STACK_MODE_UNKNOWN;
+
+    char lower_str[16];
+    size_t i;
+    for (i = 0; i < sizeof(lower_str) - 1 && str[i]; ++i)
+        lower_str[i] = (char)tolower((unsigned char)str[i]);
+    lower_str[i] = '\0';
+
+    if (strcmp(lower_str, "all") == 0)
+        return STACK_MODE_ALL;
+    else if (strcmp(lower_str, "keyframes") == 0)
+        return STACK_MODE_KEYFRAMES;
+    else
+        return STACK_MODE_UNKNOWN;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | transport.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <string.h>
+
+#include "options.h"
+
+/* Helper function to get string representation of transport_t */
+const char* transport_to_string(transport_t transport)
+{
+    switch (transport)
+    {
+        case TRANSPORT_TCP:
+            return "tcp";
+        case TRANSPORT_UDP:
+            return "udp";
+        case TRANSPORT_UDP_MULTICAST:
+            return "udp_multicast";
+        case TRANSPORT_HTTP:
+            return "http";
+        case TRANSPORT_AUTO:
+            return "auto";
+        default:
+            return "unknown transport";
+    }
+}
+
+/* Helper function to convert string to transport_t */
+transport_t string_to_transport(const char* str)
+{
+    if (!str)
+        return TRANSPORT_UNKNOWN;
+
+    char lower_str[16];
+    size_t i;
+    for (i = 0; i < sizeof(lower_str) - 1 && str[i]; ++i)
+        lower_str[i] = (char)tolower((unsigned char)str[i]);
+    lower_str[i] = '\0';
+
+    if (strcmp(lower_str, "tcp") == 0)
+        return TRANSPORT_TCP;
+    else if (strcmp(lower_str, "udp") == 0)
+        return TRANSPORT_UDP;
+    else if (strcmp(lower_str, "udp_multicast") == 0)
+        return TRANSPORT_UDP_MULTICAST;
+    else if (strcmp(lower_str, "http") == 0)
+        return TRANSPORT_HTTP;
+    else if (strcmp(lower_str, "auto") == 0)
+        return TRANSPORT_AUTO;
+    else
+        return TRANSPORT_UNKNOWN;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | usage.c
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -41,7 +41,18 @@ void print_help(const char* prog_name)
 
     printf("Options:\n");
 
-    printf("  -i, --input           <string>   RTSP URL to connect to (required).\n");
+    printf(
+        "  -i, --input           <string>   RTSP URL to connect to (required without "
+        "--input-profile).\n");
+
+    printf(
+        "      --input-alt       <string>   Second RTSP URL raced against --input; the smallest "
+        "stream covering every output wins\n");
+
+    printf(
+        "      --input-profile   <string>   Resolution profile WxH=url (repeatable, up to %d); "
+        "replaces --input with the smallest profile the output needs\n",
+        MAX_INPUT_PROFILES);
 
     printf(
         "  -t, --timeout         <uint>     RTSP stream connection timeout in seconds (default: "
@@ -59,9 +70,12 @@ void print_help(const char* prog_name)
         "                                   If omitted, snapshot is from the first I-frame; "
         "otherwise, averages frames over this time.\n");
 
-    printf("  -f, --output-format   <string>   Output image format: %s, %s, %s (default: %s)\n",
-           image_format_to_string(IMAGE_FORMAT_JPG), image_format_to_string(IMAGE_FORMAT_PNG),
-           image_format_to_string(IMAGE_FORMAT_PPM), image_format_to_string(IMAGE_FORMAT_JPG));
+    printf(
+        "  -f, --output-format   <string>   Output image format: %s, %s, %s, %s with --gray "
+        "(default: %s)\n",
+        image_format_to_string(IMAGE_FORMAT_JPG), image_format_to_string(IMAGE_FORMAT_PNG),
+        image_format_to_string(IMAGE_FORMAT_PPM), image_format_to_string(IMAGE_FORMAT_PGM),
+        image_format_to_string(IMAGE_FORMAT_JPG));
 
     printf(
         "  -s, --scale           <uint>     Image scale factor (default: %.1f, min: %.1f, max: "
@@ -99,6 +113,176 @@ void print_help(const char* prog_name)
     printf("      --debug-dir       <string>   Directory for debug files (default: %s)\n",
            DEFAULT_DEBUG_DIR);
 
+    printf(
+        "      --publish-shm     <string>   Continuously publish decoded frames to a "
+        "shared-memory ring with this name.\n");
+
+    printf(
+        "                                   Capture runs until SIGINT/SIGTERM; the snapshot (if "
+        "any output is set) is written afterwards.\n");
+
+    printf(
+        "      --publish-slots   <uint>     Shared-memory ring slots (default: %u, min: %u, max: "
+        "%u)\n",
+        DEFAULT_SHM_SLOTS, MIN_SHM_SLOTS, MAX_SHM_SLOTS);
+
+    printf("      --publish-format  <string>   Published pixel layout: %s, %s (default: %s)\n",
+           shm_format_to_string(SHM_FORMAT_RGB), shm_format_to_string(SHM_FORMAT_YUV),
+           shm_format_to_string(DEFAULT_SHM_FORMAT));
+
+    printf(
+        "      --write-timeout   <uint>     Deadline in ms for writing to --output-fd (default: "
+        "%u, max: %u, 0: none)\n",
+        DEFAULT_WRITE_TIMEOUT_MS, MAX_WRITE_TIMEOUT_MS);
+
+    printf(
+        "      --atomic-write               Write --output-file via a temp file renamed into "
+        "place\n");
+
+    printf(
+        "      --fsync                      Sync --output-file to disk before renaming it (implies "
+        "--atomic-write)\n");
+
+    printf(
+        "      --output          <string>   Add an output variant from the same capture (up to "
+        "%u):\n",
+        MAX_OUTPUT_VARIANTS);
+
+    printf(
+        "                                   \"fmt[:q=<uint>][:w=<uint>][:h=<uint>][:s=<float>]"
+        "[:fd=<uint>][:path=<string>]\"\n");
+
+    printf(
+        "                                   e.g. --output \"jpg:q=85:w=1920:path=a.jpg\" "
+        "--output \"png:w=320:fd=4\"\n");
+
+    printf(
+        "      --pyramid         <uint>     Build N halving levels: --output-file, then the "
+        "smaller levels as <name>_<width>.<ext>\n");
+
+    printf("                                   (max: %u levels, down to %ux%u pixels; "
+           "the resize minimum drops to the same size)\n",
+           MAX_PYRAMID_LEVELS, MIN_PYRAMID_WIDTH, MIN_PYRAMID_HEIGHT);
+
+    printf(
+        "      --crop            <string>   Cut the region \"x,y,w,h\" from every frame before "
+        "conversion\n");
+
+    printf(
+        "                                   (source pixels, or fractions of the frame, e.g. "
+        "\"0.25,0,0.5,1\")\n");
+
+    printf(
+        "      --scale-threads   <uint>     Threads for colour conversion and scaling "
+        "(0: one per CPU, max: %u,\n",
+        MAX_SCALE_THREADS);
+
+    printf("                                   default: %u)\n", DEFAULT_SCALE_THREADS);
+
+    printf(
+        "      --gray                       Capture the luma plane only and encode single-channel "
+        "images\n");
+
+    printf(
+        "      --interval        <uint>     Timelapse: take a snapshot every N seconds from one "
+        "session (max: %u)\n",
+        MAX_INTERVAL_SEC);
+
+    printf(
+        "                                   Output paths are templates: strftime() conversions "
+        "and %%N (sequence number)\n");
+
+    printf(
+        "      --count           <uint>     Number of timelapse snapshots (max: %u, default: 0 = "
+        "until SIGINT/SIGTERM)\n",
+        MAX_TIMELAPSE_COUNT);
+
+    printf(
+        "      --pipeline        <uint>     Timelapse: encode and write snapshots on a worker "
+        "behind a queue of N (max: %u)\n",
+        MAX_PIPELINE_DEPTH);
+
+    printf(
+        "                                   so reading never pauses; snapshots that find it full "
+        "are dropped\n");
+
+    printf(
+        "      --burst           <uint>     Save N consecutive frames from the first I-frame as "
+        "separate images (max: %u)\n",
+        MAX_BURST_FRAMES);
+
+    printf(
+        "                                   to <name>_<NNNNNN>.<ext> (or a %%N template), and/or "
+        "as a multipart stream to --output-fd\n");
+
+    printf(
+        "      --best-of         <uint>     Decode N frames from the first I-frame and keep the "
+        "sharpest, well-exposed one (max: %u)\n",
+        MAX_BEST_OF);
+
+    printf(
+        "      --stack           <string>   Frames an exposure accumulates: %s, %s (one per GOP, "
+        "decodes keyframes only) (default: %s)\n",
+        stack_mode_to_string(STACK_MODE_ALL), stack_mode_to_string(STACK_MODE_KEYFRAMES),
+        stack_mode_to_string(DEFAULT_STACK_MODE));
+
+    printf(
+        "      --exposure-end    <string>   End of an exposure: %s (estimated from the frame "
+        "rate), %s (stream time) (default: %s)\n",
+        exposure_end_to_string(EXPOSURE_END_FRAMES), exposure_end_to_string(EXPOSURE_END_PTS),
+        exposure_end_to_string(EXPOSURE_END_FRAMES));
+
+    printf(
+        "      --weight-by-duration         Weight each exposure frame by its duration (for "
+        "variable-frame-rate cameras)\n");
+
+    printf(
+        "      --fast-start                 Bound stream probing and skip it when the SDP carries "
+        "the codec extradata\n");
+
+    printf(
+        "      --profile-cache   <string>   Directory caching the codec parameters of each camera "
+        "to skip probing\n");
+
+    printf(
+        "      --video-track     <uint>     Video track to decode when the camera advertises "
+        "several, e.g. 1 for a sub stream (default: %d, max: %d)\n",
+        DEFAULT_VIDEO_TRACK, MAX_VIDEO_TRACK);
+
+    printf("      --transport       <string>   RTSP transport: %s, %s, %s, %s, %s (default: %s)\n",
+           transport_to_string(TRANSPORT_TCP), transport_to_string(TRANSPORT_UDP),
+           transport_to_string(TRANSPORT_UDP_MULTICAST), transport_to_string(TRANSPORT_HTTP),
+           transport_to_string(TRANSPORT_AUTO), transport_to_string(DEFAULT_TRANSPORT));
+
+    printf(
+        "      --buffer-size     <uint>     UDP socket receive buffer in bytes (default: system, "
+        "max: %d)\n",
+        MAX_BUFFER_SIZE);
+
+    printf(
+        "      --reorder-queue   <uint>     RTP packets held to reorder UDP delivery (default: "
+        "demuxer's, max: %d)\n",
+        MAX_REORDER_QUEUE);
+
+    printf(
+        "      --max-loss        <uint>     Lost or corrupt frames tolerated in percent; corrupt "
+        "frames are skipped below 100 (default: %d)\n",
+        DEFAULT_MAX_LOSS);
+
+    printf(
+        "      --deadline-ms     <uint>     End-to-end budget from connect to encode in "
+        "milliseconds (default: none, max: %d)\n",
+        MAX_DEADLINE_MS);
+
+    printf(
+        "      --batch           <string>   Run the capture jobs of a file (\"-\": stdin), one "
+        "line of options each; reports JSON lines\n");
+
+    printf(
+        "      --jobs            <uint>     Concurrent batch captures (default: 0 = one per CPU, "
+        "max: %d)\n",
+        MAX_JOBS);
+
     printf("  -h, --help                       Show this help message\n");
 
     printf("  -v, --version                    Show version information\n");
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | validate_options.c
     ::  ::          ::  ::    Created  | 2025-06-09
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -33,6 +33,44 @@ static short _validate_rtsp_url(const char* rtsp_url)
     return RTN_SUCCESS;
 }
 
+/* Both streams of the race must serve the same single capture, pixel crops fit only one */
+static short _validate_input_alt(const options_t* options)
+{
+    if (!options->input_alt)
+        return RTN_SUCCESS;
+
+    if (strlen(options->input_alt) < 8 || strncmp(options->input_alt, "rtsp://", 7) != 0 ||
+        options->interval_sec || options->shm_name || options->burst_frames ||
+        (options->crop.width && !options->crop.normalized))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_input_alt | " ERROR_INVALID_INPUT_ALT "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* Profiles replace --input; pixel crops and a race would fit only one of their resolutions */
+static short _validate_inputs(const options_t* options)
+{
+    short invalid = options->inputs_count > MAX_INPUT_PROFILES || options->rtsp_url ||
+                    options->input_alt || (options->crop.width && !options->crop.normalized);
+    for (int i = 0; i < options->inputs_count && !invalid; ++i)
+    {
+        const input_profile_t* profile = &options->inputs[i];
+        invalid = profile->width <= 0 || profile->height <= 0 || !profile->url ||
+                  strlen(profile->url) < 8 || strncmp(profile->url, "rtsp://", 7) != 0;
+    }
+
+    if (invalid)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_inputs | " ERROR_INVALID_INPUT_PROFILE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
 static short _validate_timeout_sec(int timeout_sec)
 {
     if (timeout_sec < 1 || timeout_sec > MAX_TIMEOUT_SEC)
@@ -103,9 +141,11 @@ static short _validate_scale_factor(float scale_factor)
     return RTN_SUCCESS;
 }
 
-static short _validate_resize_height(int resize_height)
+/* A pyramid base may be as small as a pyramid level (MIN_PYRAMID_HEIGHT) */
+static short _validate_resize_height(int resize_height, short pyramid)
 {
-    if (resize_height && (resize_height < MIN_RESIZE_HEIGHT || resize_height > MAX_RESIZE_HEIGHT) &&
+    int min_height = pyramid ? MIN_PYRAMID_HEIGHT : MIN_RESIZE_HEIGHT;
+    if (resize_height && (resize_height < min_height || resize_height > MAX_RESIZE_HEIGHT) &&
         resize_height != -1)
     {
         write_msg_to_fd(STDERR_FILENO,
@@ -116,9 +156,11 @@ static short _validate_resize_height(int resize_height)
     return RTN_SUCCESS;
 }
 
-static short _validate_resize_width(int resize_width)
+/* A pyramid base may be as narrow as a pyramid level (MIN_PYRAMID_WIDTH) */
+static short _validate_resize_width(int resize_width, short pyramid)
 {
-    if (resize_width && (resize_width < MIN_RESIZE_WIDTH || resize_width > MAX_RESIZE_WIDTH) &&
+    int min_width = pyramid ? MIN_PYRAMID_WIDTH : MIN_RESIZE_WIDTH;
+    if (resize_width && (resize_width < min_width || resize_width > MAX_RESIZE_WIDTH) &&
         resize_width != -1)
     {
         write_msg_to_fd(STDERR_FILENO,
@@ -180,6 +222,339 @@ error:
     return RTN_ERROR;
 }
 
+static short _validate_profile_cache_dir(const char* profile_cache_dir)
+{
+    struct stat st = {0};
+    if (profile_cache_dir && (stat(profile_cache_dir, &st) == -1 || !S_ISDIR(st.st_mode) ||
+                              access(profile_cache_dir, W_OK) == -1))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_profile_cache_dir | " ERROR_INVALID_PROFILE_CACHE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_video_track(int video_track)
+{
+    if (video_track < 0 || video_track > MAX_VIDEO_TRACK)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_video_track | " ERROR_INVALID_VIDEO_TRACK "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* A socket buffer only applies to RTP over UDP, which auto may pick */
+static short _validate_transport(const options_t* options)
+{
+    short udp = options->transport == TRANSPORT_UDP ||
+                options->transport == TRANSPORT_UDP_MULTICAST ||
+                options->transport == TRANSPORT_AUTO;
+    if (options->transport < TRANSPORT_TCP || options->transport >= TRANSPORT_UNKNOWN ||
+        options->buffer_size < 0 || options->buffer_size > MAX_BUFFER_SIZE ||
+        options->reorder_queue < -1 || options->reorder_queue > MAX_REORDER_QUEUE ||
+        (!udp && options->buffer_size))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_transport | " ERROR_INVALID_TRANSPORT "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_max_loss(int max_loss)
+{
+    if (max_loss < 0 || max_loss > 100)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_max_loss | " ERROR_INVALID_MAX_LOSS "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* The budget covers a single capture, not a timelapse or a publisher that runs until stopped */
+static short _validate_deadline_ms(const options_t* options)
+{
+    if (options->deadline_ms < 0 || options->deadline_ms > MAX_DEADLINE_MS ||
+        (options->deadline_ms && (options->interval_sec || options->shm_name)))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_deadline_ms | " ERROR_INVALID_DEADLINE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* A batch takes its inputs and outputs from its lines, the command line only sets concurrency */
+static short _validate_batch(const options_t* options)
+{
+    if (options->jobs < 0 || options->jobs > MAX_JOBS ||
+        (!options->batch_file && options->jobs != DEFAULT_JOBS) ||
+        (options->batch_file &&
+         (!*options->batch_file || options->rtsp_url || options->inputs_count ||
+          options->output_file_path || options->output_file_fd != -1 || options->outputs_count)))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_batch | " ERROR_INVALID_BATCH "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_shm_name(const char* shm_name)
+{
+    if (shm_name && (strlen(shm_name) < 2 || shm_name[0] != '/' || strchr(shm_name + 1, '/')))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_shm_name | " ERROR_INVALID_SHM_NAME "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_shm_slots(int shm_slots)
+{
+    if (shm_slots < MIN_SHM_SLOTS || shm_slots > MAX_SHM_SLOTS)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_shm_slots | " ERROR_INVALID_SHM_SLOTS "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_shm_format(shm_format_t shm_format)
+{
+    if (shm_format == SHM_FORMAT_UNKNOWN)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_shm_format | " ERROR_INVALID_SHM_FORMAT "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_write_timeout_ms(int write_timeout_ms)
+{
+    if (write_timeout_ms < 0 || write_timeout_ms > MAX_WRITE_TIMEOUT_MS)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_write_timeout_ms | " ERROR_INVALID_WRITE_TIMEOUT "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_pyramid_levels(int pyramid_levels, const char* output_file_path)
+{
+    if (pyramid_levels < 0 || pyramid_levels > MAX_PYRAMID_LEVELS ||
+        (pyramid_levels && !output_file_path))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_pyramid_levels | " ERROR_INVALID_PYRAMID_LEVELS "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_scale_threads(int scale_threads)
+{
+    if (scale_threads < 0 || scale_threads > MAX_SCALE_THREADS)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_scale_threads | " ERROR_INVALID_SCALE_THREADS "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_crop(const crop_t* crop)
+{
+    if (crop->width == 0.0f && crop->height == 0.0f)
+        return RTN_SUCCESS;
+
+    if (crop->x < 0.0f || crop->y < 0.0f || crop->width <= 0.0f || crop->height <= 0.0f ||
+        (crop->normalized && (crop->x + crop->width > 1.0f || crop->y + crop->height > 1.0f)))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_crop | " ERROR_INVALID_CROP "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_timelapse(const options_t* options)
+{
+    short result = 0;
+
+    if (options->interval_sec < 0 || options->interval_sec > MAX_INTERVAL_SEC ||
+        (options->interval_sec && options->shm_name))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_timelapse | " ERROR_INVALID_INTERVAL "\n");
+        result = RTN_ERROR;
+    }
+
+    if (options->count < 0 || options->count > MAX_TIMELAPSE_COUNT ||
+        (options->count && !options->interval_sec))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_timelapse | " ERROR_INVALID_COUNT "\n");
+        result = RTN_ERROR;
+    }
+
+    if (options->pipeline_depth < 0 || options->pipeline_depth > MAX_PIPELINE_DEPTH ||
+        (options->pipeline_depth && !options->interval_sec))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_timelapse | " ERROR_INVALID_PIPELINE_DEPTH "\n");
+        result = RTN_ERROR;
+    }
+
+    return result;
+}
+
+static short _validate_burst(const options_t* options)
+{
+    if (!options->burst_frames)
+        return RTN_SUCCESS;
+
+    if (options->burst_frames < 0 || options->burst_frames > MAX_BURST_FRAMES ||
+        options->exposure_sec || options->interval_sec || options->shm_name ||
+        options->outputs_count || options->pyramid_levels)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_burst | " ERROR_INVALID_BURST "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+static short _validate_best_of(const options_t* options)
+{
+    if (!options->best_of)
+        return RTN_SUCCESS;
+
+    if (options->best_of < 0 || options->best_of > MAX_BEST_OF || options->exposure_sec ||
+        options->burst_frames)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_best_of | " ERROR_INVALID_BEST_OF "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* Keyframe stacking samples an exposure, and frames published to shm must not skip */
+static short _validate_stack_mode(const options_t* options)
+{
+    if (options->stack_mode == STACK_MODE_ALL)
+        return RTN_SUCCESS;
+
+    if (options->stack_mode != STACK_MODE_KEYFRAMES || options->exposure_sec <= 0 ||
+        options->shm_name)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_stack_mode | " ERROR_INVALID_STACK_MODE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* Both end or weight an exposure by stream time, which a single frame does not have */
+static short _validate_exposure_end(const options_t* options)
+{
+    if (options->exposure_end == EXPOSURE_END_UNKNOWN ||
+        ((options->exposure_end == EXPOSURE_END_PTS || options->weight_by_duration) &&
+         options->exposure_sec <= 0))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) validate_exposure_end | " ERROR_INVALID_EXPOSURE_END "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/* PGM holds a single channel, and RGB publishing needs the chroma that --gray never converts */
+static short _validate_gray(const options_t* options)
+{
+    short result = 0;
+
+    for (int i = -1; !options->gray && i < options->outputs_count; ++i)
+        if ((i < 0 ? options->output_format : options->outputs[i].format) == IMAGE_FORMAT_PGM)
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) validate_gray | " ERROR_INVALID_OUTPUT_FORMAT "\n");
+            result = RTN_ERROR;
+            break;
+        }
+
+    if (options->gray && options->shm_name && options->shm_format == SHM_FORMAT_RGB)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) validate_gray | " ERROR_INVALID_SHM_FORMAT "\n");
+        result = RTN_ERROR;
+    }
+
+    return result;
+}
+
+/* Two outputs writing to the same path or descriptor would clobber or interleave each other */
+static short _is_duplicate_output(const options_t* options, int index)
+{
+    const output_variant_t* variant = &options->outputs[index];
+
+    for (int i = -1; i < index; ++i)
+    {
+        const char* path = i < 0 ? options->output_file_path : options->outputs[i].path;
+        int fd = i < 0 ? options->output_file_fd : options->outputs[i].fd;
+
+        if ((variant->path && path && strcmp(variant->path, path) == 0) ||
+            (variant->fd != -1 && variant->fd == fd))
+            return 1;
+    }
+
+    return 0;
+}
+
+static short _validate_outputs(const options_t* options)
+{
+    short result = 0;
+
+    for (int i = 0; i < options->outputs_count; ++i)
+    {
+        const output_variant_t* variant = &options->outputs[i];
+
+        if (!variant->path && variant->fd == -1)
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) validate_outputs | " ERROR_INVALID_OUTPUT_SPEC "\n");
+            result |= RTN_ERROR;
+        }
+        else if (_is_duplicate_output(options, i))
+        {
+            write_msg_to_fd(STDERR_FILENO, "(f) validate_outputs | " ERROR_DUPLICATE_OUTPUT "\n");
+            result |= RTN_ERROR;
+        }
+
+        result |= _validate_output_file_path(variant->path);
+        result |= _validate_output_file_fd(variant->fd);
+        result |= _validate_output_format(variant->format);
+        result |= _validate_scale_factor(variant->scale_factor);
+        result |= _validate_resize_height(variant->resize_height, 0);
+        result |= _validate_resize_width(variant->resize_width, 0);
+        result |= _validate_image_quality(variant->image_quality);
+    }
+
+    return result ? RTN_ERROR : RTN_SUCCESS;
+}
+
 /**
  * @brief Validates the provided options structure.
  *
@@ -199,18 +574,48 @@ short validate_options(const options_t* options)
     if (options->help || options->version)
         return RTN_SUCCESS;  // No need to validate further if help or version is requested.
 
+    if (options->batch_file)
+        return _validate_batch(options);  // Every batch line is validated as it is read.
+
     short result = 0;
 
-    result |= _validate_rtsp_url(options->rtsp_url);
+    if (options->inputs_count)
+        result |= _validate_inputs(options);
+    else
+        result |= _validate_rtsp_url(options->rtsp_url);
+    result |= _validate_input_alt(options);
     result |= _validate_timeout_sec(options->timeout_sec);
     result |= _validate_output_file_path(options->output_file_path);
     result |= _validate_output_file_fd(options->output_file_fd);
     result |= _validate_exposure_sec(options->exposure_sec);
     result |= _validate_output_format(options->output_format);
     result |= _validate_scale_factor(options->scale_factor);
-    result |= _validate_resize_height(options->resize_height);
-    result |= _validate_resize_width(options->resize_width);
+    result |= _validate_resize_height(options->resize_height, options->pyramid_levels > 0);
+    result |= _validate_resize_width(options->resize_width, options->pyramid_levels > 0);
     result |= _validate_image_quality(options->image_quality);
+    result |= _validate_write_timeout_ms(options->write_timeout_ms);
+    result |= _validate_outputs(options);
+    result |= _validate_pyramid_levels(options->pyramid_levels, options->output_file_path);
+    result |= _validate_crop(&options->crop);
+    result |= _validate_scale_threads(options->scale_threads);
+    result |= _validate_gray(options);
+    result |= _validate_timelapse(options);
+    result |= _validate_burst(options);
+    result |= _validate_best_of(options);
+    result |= _validate_stack_mode(options);
+    result |= _validate_exposure_end(options);
+    result |= _validate_profile_cache_dir(options->profile_cache_dir);
+    result |= _validate_video_track(options->video_track);
+    result |= _validate_transport(options);
+    result |= _validate_max_loss(options->max_loss);
+    result |= _validate_deadline_ms(options);
+    result |= _validate_batch(options);
+    if (options->shm_name)
+    {
+        result |= _validate_shm_name(options->shm_name);
+        result |= _validate_shm_slots(options->shm_slots);
+        result |= _validate_shm_format(options->shm_format);
+    }
     if (options->debug)
     {
         result |= _validate_debug_step(options->debug_step);
@@ -0,0 +1,156 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | output_variants.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+#include "workers.h"
+
+short _scale_image_data(const image_t* raw_image, const options_t* options, image_t* scaled_image);
+
+typedef struct _variant_job_s
+{
+    options_t options;   // Shallow copy of the base options with the variant applied.
+    image_t* raw_image;  // Shared, read-only captured image.
+    int index;           // Variant index, for debug output.
+    short result;        // Result of the job (0: success, -1: error).
+} _variant_job_t;
+
+/* Applies an output variant on top of a shallow copy of the base options */
+static void _apply_variant(options_t* options, const output_variant_t* variant)
+{
+    options->output_format = variant->format;
+    options->image_quality = variant->image_quality;
+    options->scale_factor = variant->scale_factor;
+    options->resize_width = variant->resize_width;
+    options->resize_height = variant->resize_height;
+    options->output_file_path = variant->path;
+    options->output_file_fd = variant->fd;
+    options->pyramid_levels = 0;  // Pyramids are built for --output-file only
+}
+
+/* Worker task: scales, encodes and writes one variant of the shared raw image */
+static void _run_variant_job(void* arg)
+{
+    _variant_job_t* job = (_variant_job_t*)arg;
+    job->result = RTN_ERROR;
+
+    image_t scaled_image;
+    if (_scale_image_data(job->raw_image, &job->options, &scaled_image))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _run_variant_job | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        return;
+    }
+
+    image_t* source = scaled_image.data ? &scaled_image : job->raw_image;
+    if (job->options.pyramid_levels)
+    {
+        job->result = write_pyramid(&job->options, source);
+        free(scaled_image.data);
+        return;
+    }
+
+    image_t* image = get_converted_image(&job->options, source);
+    if (!image)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _run_variant_job | " ERROR_FAILED_TO_CONVERT_IMAGE "\n");
+        free(scaled_image.data);
+        return;
+    }
+
+    job->result = write_image(&job->options, image);
+
+    if (job->options.debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Output variant %d: %s %dx%d, %zu bytes%s\n",
+               job->index, image_format_to_string(job->options.output_format), source->width,
+               source->height, image->size, job->result ? " (write failed)" : "");
+
+    free(scaled_image.data);
+    free_image(image);
+}
+
+/**
+ * @brief Produces every configured output from one captured image in parallel.
+ *
+ * Each --output variant, plus the single-output options (--output-file / --output-fd) if set,
+ * is scaled, encoded and written by its own task on a pool of worker threads. The raw image
+ * is shared read-only between all tasks.
+ *
+ * @param options    Pointer to the options_t structure holding the output variants.
+ * @param raw_image  Pointer to the unscaled captured image.
+ *
+ * @return 0 if every output was written, or -1 if at least one failed.
+ */
+short write_output_variants(const options_t* options, image_t* raw_image)
+{
+    if (!options || !raw_image || !raw_image->data)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) write_output_variants | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    char has_legacy_output = options->output_file_path || options->output_file_fd != -1;
+    int jobs_count = options->outputs_count + has_legacy_output;
+
+    _variant_job_t* jobs = (_variant_job_t*)calloc(jobs_count, sizeof(_variant_job_t));
+    if (!jobs)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_output_variants | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+
+    for (int i = 0; i < jobs_count; ++i)
+    {
+        jobs[i].options = *options;
+        jobs[i].raw_image = raw_image;
+        jobs[i].index = i;
+        jobs[i].result = RTN_ERROR;
+        if (i < options->outputs_count)
+            _apply_variant(&jobs[i].options, &options->outputs[i]);
+    }
+
+    int threads_count = jobs_count < get_cpu_count() ? jobs_count : get_cpu_count();
+    worker_pool_t* pool = create_worker_pool(threads_count, jobs_count);
+    worker_group_t group;
+    if (!pool || init_worker_group(&group))
+    {
+        free_worker_pool(pool);
+        free(jobs);
+        return RTN_ERROR;
+    }
+
+    for (int i = 0; i < jobs_count; ++i)
+        if (submit_worker_task(pool, &group, _run_variant_job, &jobs[i]))
+            break;
+
+    wait_worker_group(&group);
+    destroy_worker_group(&group);
+    free_worker_pool(pool);
+
+    short result = RTN_SUCCESS;
+    for (int i = 0; i < jobs_count; ++i)
+        if (jobs[i].result)
+            result = RTN_ERROR;
+
+    free(jobs);
+    return result;
+}
@@ -0,0 +1,176 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | pyramid.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+#include "workers.h"
+
+typedef struct _level_job_s
+{
+    options_t options;  // Shallow copy of the base options with the level destination.
+    image_t* image;     // Image of this level (read-only while the job runs).
+    char* path;         // Output path of this level.
+    short result;       // Result of the job (0: success, -1: error).
+} _level_job_t;
+
+/**
+ * @brief Builds the output path of a pyramid level by inserting "_<width>" before the extension.
+ *
+ * @param path   The --output-file path.
+ * @param width  Width of the level in pixels.
+ *
+ * @return Newly allocated path (e.g. "snap_480.jpg" for "snap.jpg"), or NULL on failure.
+ */
+char* get_pyramid_level_path(const char* path, int width)
+{
+    if (!path || width <= 0)
+        return NULL;
+
+    const char* slash = strrchr(path, '/');
+    const char* dot = strrchr(path, '.');
+    if (!dot || (slash && dot < slash) || dot == (slash ? slash + 1 : path))
+        dot = path + strlen(path);  // No extension (or a hidden file name): append the suffix
+
+    size_t size = strlen(path) + 16;
+    char* level_path = (char*)malloc(size);
+    if (!level_path)
+        return NULL;
+
+    snprintf(level_path, size, "%.*s_%d%s", (int)(dot - path), path, width, dot);
+    return level_path;
+}
+
+/* Worker task: encodes and writes one pyramid level */
+static void _run_level_job(void* arg)
+{
+    _level_job_t* job = (_level_job_t*)arg;
+
+    image_t* image = get_converted_image(&job->options, job->image);
+    if (!image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _run_level_job | " ERROR_FAILED_TO_CONVERT_IMAGE "\n");
+        job->result = RTN_ERROR;
+        return;
+    }
+
+    job->result = write_image(&job->options, image);
+    free_image(image);
+}
+
+/**
+ * @brief Saves a pyramid of halving renditions of an image.
+ *
+ * Level 0 is the image itself; every following level is built from the previous one with a
+ * 2x2 box filter, so the whole pyramid costs little more than one full-resolution pass. Each
+ * level is encoded on a worker thread as soon as it is built, while the cascade continues.
+ * Level 0 is written to --output-file itself and every further level to "<name>_<width>.<ext>"
+ * next to it; the output file descriptor, if set, receives level 0 only. The cascade stops
+ * early when the next level would be smaller than MIN_PYRAMID_WIDTH x MIN_PYRAMID_HEIGHT, which
+ * is also the smallest size level 0 may be resized to.
+ *
+ * @param options     Pointer to the options_t structure (pyramid_levels, output destinations).
+ * @param base_image  Pointer to the scaled image used as level 0.
+ *
+ * @return 0 if every level was written, or -1 on failure.
+ */
+short write_pyramid(const options_t* options, image_t* base_image)
+{
+    if (!options || !base_image || !options->output_file_path || options->pyramid_levels <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) write_pyramid | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    int levels_count = options->pyramid_levels;
+    _level_job_t jobs[MAX_PYRAMID_LEVELS];
+    memset(jobs, 0, sizeof(jobs));
+
+    int threads_count = levels_count < get_cpu_count() ? levels_count : get_cpu_count();
+    worker_pool_t* pool = create_worker_pool(threads_count, levels_count);
+    worker_group_t group;
+    if (!pool || init_worker_group(&group))
+    {
+        free_worker_pool(pool);
+        return RTN_ERROR;
+    }
+
+    short result = RTN_SUCCESS;
+    int submitted = 0;
+    image_t* level = base_image;
+
+    for (int i = 0; i < levels_count && level; ++i)
+    {
+        _level_job_t* job = &jobs[i];
+        job->options = *options;
+        job->image = level;
+        job->path = i ? get_pyramid_level_path(options->output_file_path, level->width)
+                      : strdup(options->output_file_path);
+        job->options.output_file_path = job->path;
+        job->options.output_file_fd = i == 0 ? options->output_file_fd : -1;
+        if (!job->path || submit_worker_task(pool, &group, _run_level_job, job))
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) write_pyramid | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+            result = RTN_ERROR;
+            break;
+        }
+        submitted++;
+
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Pyramid level %d: %dx%d -> %s\n", i,
+                   level->width, level->height, job->path);
+
+        if (i + 1 == levels_count)
+            break;
+
+        if (level->width / 2 < MIN_PYRAMID_WIDTH || level->height / 2 < MIN_PYRAMID_HEIGHT)
+        {
+            if (options->debug)
+                printf(ANSI_BLUE "Debug:" ANSI_RESET
+                                 " Pyramid stopped after %d levels (minimum size %dx%d)\n",
+                       i + 1, MIN_PYRAMID_WIDTH, MIN_PYRAMID_HEIGHT);
+            break;
+        }
+
+        // The source level stays untouched while its encode job runs concurrently
+        level = get_half_size_image(level);
+        if (!level)
+            result = RTN_ERROR;
+    }
+
+    wait_worker_group(&group);
+    destroy_worker_group(&group);
+    free_worker_pool(pool);
+
+    for (int i = 0; i < levels_count; ++i)
+    {
+        if (i < submitted && jobs[i].result)
+            result = RTN_ERROR;
+        if (jobs[i].image && jobs[i].image != base_image)
+            free_image(jobs[i].image);
+        free(jobs[i].path);
+    }
+
+    return result;
+}
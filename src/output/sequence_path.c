@@ -0,0 +1,131 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | sequence_path.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+
+#define SEQUENCE_PATH_MAX 4096  // Maximum length of an expanded output path.
+
+/**
+ * @brief Expands an output path template for one snapshot of a timelapse.
+ *
+ * "%N" is replaced with the zero-padded sequence number (000001, 000002, ...) and every other
+ * conversion is expanded by strftime() with the local time of the snapshot, so
+ * "cam_%Y%m%d_%H%M%S_%N.jpg" gives "cam_20261018_120000_000001.jpg". "%%" is a literal '%'.
+ * A template without conversions is returned unchanged and every snapshot overwrites it.
+ *
+ * @param path_template  The --output-file (or --output path=) template.
+ * @param sequence       Sequence number of the snapshot, starting at 1.
+ * @param when           Capture time of the snapshot.
+ *
+ * @return Newly allocated expanded path, or NULL on failure.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ */
+char* get_sequence_path(const char* path_template, unsigned long long sequence, time_t when)
+{
+    if (!path_template || !*path_template)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_sequence_path | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    // Substitute the sequence number first, strftime() does not know about it
+    char format[SEQUENCE_PATH_MAX];
+    size_t length = 0;
+    for (const char* c = path_template; *c && length < sizeof(format) - 1; ++c)
+    {
+        if (c[0] == '%' && c[1] == 'N')
+        {
+            length += snprintf(format + length, sizeof(format) - length, "%06llu", sequence);
+            ++c;
+        }
+        else if (c[0] == '%' && c[1] == '%')
+        {
+            length += snprintf(format + length, sizeof(format) - length, "%%%%");
+            ++c;
+        }
+        else
+            format[length++] = *c;
+    }
+
+    struct tm local_time;
+    char path[SEQUENCE_PATH_MAX];
+    if (length < sizeof(format) - 1)
+        format[length] = '\0';
+
+    if (length >= sizeof(format) - 1 || !localtime_r(&when, &local_time) ||
+        !strftime(path, sizeof(path), format, &local_time))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_sequence_path | " ERROR_FAILED_TO_FORMAT_OUTPUT_PATH "\n");
+        return NULL;
+    }
+
+    return strdup(path);
+}
+
+/**
+ * @brief Builds the output path of one frame of a burst.
+ *
+ * A path with '%' conversions is expanded by get_sequence_path(); otherwise the zero-padded
+ * frame number is inserted before the extension, so "incident.jpg" gives
+ * "incident_000001.jpg", "incident_000002.jpg", ...
+ *
+ * @param path   The --output-file path or template.
+ * @param frame  Number of the frame in the burst, starting at 1.
+ * @param when   Capture time of the burst.
+ *
+ * @return Newly allocated path, or NULL on failure.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ */
+char* get_burst_frame_path(const char* path, unsigned long long frame, time_t when)
+{
+    if (!path || !*path)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_burst_frame_path | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    if (strchr(path, '%'))
+        return get_sequence_path(path, frame, when);
+
+    const char* slash = strrchr(path, '/');
+    const char* dot = strrchr(path, '.');
+    if (!dot || (slash && dot < slash) || dot == (slash ? slash + 1 : path))
+        dot = path + strlen(path);  // No extension (or a hidden file name): append the number
+
+    size_t size = strlen(path) + 32;
+    char* frame_path = (char*)malloc(size);
+    if (!frame_path)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_burst_frame_path | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return NULL;
+    }
+
+    snprintf(frame_path, size, "%.*s_%06llu%s", (int)(dot - path), path, frame, dot);
+    return frame_path;
+}
@@ -0,0 +1,122 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | write_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+
+/**
+ * @brief Writes an encoded image to the output file and/or file descriptor set in the options.
+ *
+ * The output file is written atomically (temp file + rename) when options->atomic_write is set.
+ * Writes to the output file descriptor honour options->write_timeout_ms.
+ *
+ * @param options  Pointer to the options_t structure holding the output destinations.
+ * @param image    Pointer to the encoded image to write.
+ *
+ * @return 0 if every configured destination was written, or -1 on failure.
+ */
+short write_image(const options_t* options, const image_t* image)
+{
+    if (!options || !image || !image->data)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) write_image | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    short result = RTN_SUCCESS;
+
+    if (options->output_file_path)
+    {
+        ssize_t written = options->atomic_write
+                              ? write_data_to_file_atomic(options->output_file_path, image->data,
+                                                          image->size, options->fsync)
+                              : write_data_to_file(options->output_file_path, image->data,
+                                                   image->size);
+        if (written < 0)
+            result = RTN_ERROR;
+        else if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Saved converted image to: %s\n",
+                   options->output_file_path);
+    }
+
+    if (options->output_file_fd != -1)
+    {
+        write_stats_t write_stats;
+        if (write_data_to_fd_with_deadline(options->output_file_fd, image->data, image->size,
+                                           options->write_timeout_ms, &write_stats) < 0)
+            result = RTN_ERROR;
+        else if (options->debug)
+        {
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Saved converted image to file descriptor: %d\n",
+                   options->output_file_fd);
+            printf(ANSI_BLUE "Debug:" ANSI_RESET
+                             " Wrote %zu bytes in %.3f ms (%.2f MiB/s), stalled %.3f ms over "
+                             "%u polls\n",
+                   write_stats.bytes, write_stats.elapsed_us / 1000.0,
+                   write_stats.elapsed_us > 0
+                       ? write_stats.bytes / (1024.0 * 1024.0) / (write_stats.elapsed_us / 1e6)
+                       : 0.0,
+                   write_stats.stall_us / 1000.0, write_stats.polls);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Encodes a raw image and writes it to every destination configured in the options.
+ *
+ * Output variants and pyramid levels are handled by write_output_variants() and write_pyramid();
+ * otherwise the image is converted to options->output_format and written with write_image().
+ * Nothing is written when no destination is configured.
+ *
+ * @param options    Pointer to the options_t structure holding the output destinations.
+ * @param raw_image  Pointer to the raw image (already scaled unless output variants are set).
+ *
+ * @return 0 if every configured destination was written, or -1 on failure.
+ */
+short write_outputs(const options_t* options, image_t* raw_image)
+{
+    if (!options || !raw_image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) write_outputs | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    if (options->outputs_count)
+        return write_output_variants(options, raw_image);
+
+    if (options->output_file_fd < 0 && !options->output_file_path)
+        return RTN_SUCCESS;
+
+    if (options->pyramid_levels)
+        return write_pyramid(options, raw_image);
+
+    image_t* image = get_converted_image(options, raw_image);
+    if (!image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) write_outputs | " ERROR_FAILED_TO_CONVERT_IMAGE "\n");
+        return RTN_ERROR;
+    }
+
+    short result = write_image(options, image);
+    free_image(image);
+    return result;
+}
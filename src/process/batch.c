@@ -0,0 +1,327 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | batch.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "process.h"
+#include "utilities.h"
+#include "workers.h"
+
+/* State shared by every job of a batch */
+typedef struct _batch_s
+{
+    worker_pool_t* encoders;       // Encoder pool shared by every job.
+    worker_group_t encode_group;   // Group the encode tasks are accounted in.
+    pthread_mutex_t report_mutex;  // Keeps the JSON status lines whole.
+    atomic_uint failed;            // Number of jobs that failed.
+} _batch_t;
+
+/* One line of the batch, from its capture on a capture worker to its encode on an encoder */
+typedef struct _batch_job_s
+{
+    options_t* options;    // Options parsed from the line, owned by the job.
+    unsigned long line;    // Line number of the job in the batch file.
+    long long started_at;  // Time the job was read in microseconds.
+    image_t* raw_image;    // Unscaled raw image, owned by the job (NULL until captured).
+    _batch_t* batch;       // Batch the job belongs to.
+} _batch_job_t;
+
+/* Writes a JSON string literal, escaping quotes, backslashes and control characters */
+static void _print_json_string(const char* str)
+{
+    if (!str)
+    {
+        fputs("null", stdout);
+        return;
+    }
+
+    putchar('"');
+    for (const unsigned char* c = (const unsigned char*)str; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            printf("\\%c", *c);
+        else if (*c < 0x20)
+            printf("\\u%04x", *c);
+        else
+            putchar(*c);
+    }
+    putchar('"');
+}
+
+/**
+ * @brief Prints the JSON status line of a job.
+ *
+ * Example: {"line":3,"url":"rtsp://cam3/main","status":"error","stage":"capture","ms":5012}
+ *
+ * @param batch       Pointer to the batch the job belongs to.
+ * @param line        Line number of the job in the batch file.
+ * @param url         Input URL of the job (or NULL if its options could not be parsed).
+ * @param stage       Stage that failed, or NULL if the job succeeded.
+ * @param started_at  Time the job was read in microseconds.
+ */
+static void _report_job(_batch_t* batch, unsigned long line, const char* url, const char* stage,
+                        long long started_at)
+{
+    long long elapsed_ms = (monotonic_time_in_microseconds() - started_at) / 1000;
+
+    if (stage)
+        atomic_fetch_add(&batch->failed, 1);
+
+    pthread_mutex_lock(&batch->report_mutex);
+    printf("{\"line\":%lu,\"url\":", line);
+    _print_json_string(url);
+    printf(",\"status\":\"%s\",\"stage\":", stage ? "error" : "ok");
+    _print_json_string(stage);
+    printf(",\"ms\":%lld}\n", elapsed_ms);
+    fflush(stdout);
+    pthread_mutex_unlock(&batch->report_mutex);
+}
+
+/* Reports a job and releases it together with its options and image */
+static void _finish_job(_batch_job_t* job, const char* stage)
+{
+    _report_job(job->batch, job->line, job->options->rtsp_url, stage, job->started_at);
+
+    if (job->raw_image)
+        free_image(job->raw_image);
+    free_options(job->options);
+    free(job);
+}
+
+/* Encoder task: scales, encodes and writes the outputs of one job */
+static void _run_encode_job(void* arg)
+{
+    _batch_job_t* job = (_batch_job_t*)arg;
+    _finish_job(job, write_outputs(job->options, job->raw_image) ? "encode" : NULL);
+}
+
+/**
+ * @brief Capture task: opens the stream of one job and captures its raw image.
+ *
+ * The raw image is handed to the shared encoder pool, so a capture worker moves on to the
+ * next camera while the previous frame is still being encoded. A burst encodes its frames
+ * on its own pool as part of the capture.
+ */
+static void _run_capture_job(void* arg)
+{
+    _batch_job_t* job = (_batch_job_t*)arg;
+
+    if (job->options->burst_frames)
+    {
+        _finish_job(job, run_burst(job->options) ? "burst" : NULL);
+        return;
+    }
+
+    job->raw_image = get_raw_image(job->options);
+    if (!job->raw_image)
+    {
+        _finish_job(job, "capture");
+        return;
+    }
+
+    // Blocks while the encoder queue is full, which holds back further captures
+    if (submit_worker_task(job->batch->encoders, &job->batch->encode_group, _run_encode_job,
+                           job))
+        _finish_job(job, "encode");
+}
+
+/**
+ * @brief Parses one line of the batch into the options of a capture job.
+ *
+ * Every line is a single capture of its own: it needs an output path and cannot run a
+ * timelapse, publish to shared memory, set a deadline (the deadline is process-wide), write
+ * to a file descriptor (stdout carries the status lines) or start a nested batch.
+ *
+ * @param line  The line to parse; it is split in place.
+ *
+ * @return Pointer to the options of the job, or NULL if the line is not a valid job.
+ */
+static options_t* _parse_batch_job(char* line)
+{
+    char* argv[MAX_BATCH_ARGS];
+    int argc = split_batch_line(line, argv, MAX_BATCH_ARGS);
+    if (argc < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _parse_batch_job | " ERROR_FAILED_TO_PARSE_BATCH_LINE "\n");
+        return NULL;
+    }
+
+    options_t* options = get_options(argc, argv);
+    if (options && (options->help || options->version || options->batch_file ||
+                    options->interval_sec || options->shm_name || options->deadline_ms ||
+                    options->output_file_fd >= 0 ||
+                    (!options->output_file_path && !options->outputs_count)))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _parse_batch_job | " ERROR_INVALID_BATCH_JOB "\n");
+        free_options(options);
+        return NULL;
+    }
+
+    return options;
+}
+
+/* Returns 1 for lines without a job: blank lines and # comments */
+static short _is_blank_batch_line(const char* line)
+{
+    while (*line == ' ' || *line == '\t' || *line == '\r' || *line == '\n') ++line;
+    return *line == '\0' || *line == '#';
+}
+
+/**
+ * @brief Reads the batch and queues one capture job per line.
+ *
+ * submit_worker_task() blocks while the capture queue is full, so no more lines are read
+ * than the capture workers can take.
+ *
+ * @return 0 if the batch was read, or -1 if the batch could not be read or queued.
+ */
+static short _queue_batch_jobs(FILE* file, _batch_t* batch, worker_pool_t* captures,
+                               worker_group_t* capture_group)
+{
+    char* line = NULL;
+    size_t capacity = 0;
+    unsigned long line_number = 0;
+    short result = RTN_SUCCESS;
+
+    while (!stop_requested() && getline(&line, &capacity, file) != -1)
+    {
+        ++line_number;
+        if (_is_blank_batch_line(line))
+            continue;
+
+        long long started_at = monotonic_time_in_microseconds();
+        options_t* options = _parse_batch_job(line);
+        if (!options)
+        {
+            _report_job(batch, line_number, NULL, "options", started_at);
+            continue;
+        }
+
+        _batch_job_t* job = (_batch_job_t*)calloc(1, sizeof(_batch_job_t));
+        if (!job)
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) _queue_batch_jobs | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+            free_options(options);
+            result = RTN_ERROR;
+            break;
+        }
+
+        *job = (_batch_job_t){
+            .options = options, .line = line_number, .started_at = started_at, .batch = batch};
+        if (submit_worker_task(captures, capture_group, _run_capture_job, job))
+        {
+            free_options(options);
+            free(job);
+            result = RTN_ERROR;
+            break;
+        }
+    }
+
+    free(line);
+    return result;
+}
+
+/**
+ * @brief Runs the capture jobs of a batch file concurrently in one process (--batch).
+ *
+ * Every non-blank line of the file (or of stdin for "-") holds the options of one capture,
+ * as on the command line: e.g. "-i rtsp://cam1/main -o /srv/snap/cam1.jpg -w 320". Lines
+ * starting with # are comments. Each job gets its own options, stream and process and is
+ * captured on a pool of --jobs workers; the raw images are scaled, encoded and written on
+ * one encoder pool shared by the whole batch. A JSON status line per job is printed to
+ * stdout as the job finishes, in completion order.
+ *
+ * @param options  Pointer to the options_t structure with the batch file and --jobs.
+ *
+ * @return 0 if every job succeeded, or -1 if a job failed or the batch could not be run.
+ */
+short run_batch(options_t* options)
+{
+    if (!options || !options->batch_file)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) run_batch | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    short from_stdin = strcmp(options->batch_file, "-") == 0;
+    FILE* file = from_stdin ? stdin : fopen(options->batch_file, "r");
+    if (!file)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) run_batch | " ERROR_FAILED_TO_OPEN_BATCH "\n");
+        return RTN_ERROR;
+    }
+
+    int jobs = options->jobs ? options->jobs : get_cpu_count();
+    _batch_t batch = {.report_mutex = PTHREAD_MUTEX_INITIALIZER};
+    worker_group_t capture_group;
+    short capture_group_ready = 0;
+    short encode_group_ready = 0;
+    short result = RTN_ERROR;
+
+    atomic_init(&batch.failed, 0);
+    worker_pool_t* captures = create_worker_pool(jobs, jobs);
+    batch.encoders = create_worker_pool(get_cpu_count(), get_cpu_count());
+    if (!captures || !batch.encoders || init_worker_group(&capture_group))
+        goto end;
+    capture_group_ready = 1;
+    if (init_worker_group(&batch.encode_group))
+        goto end;
+    encode_group_ready = 1;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Running batch %s on %d capture and %d encode "
+                         "workers...\n",
+               options->batch_file, jobs, get_cpu_count());
+
+    result = _queue_batch_jobs(file, &batch, captures, &capture_group);
+
+    // Every encode task is submitted by a capture task, so captures are waited for first
+    wait_worker_group(&capture_group);
+    wait_worker_group(&batch.encode_group);
+
+    if (atomic_load(&batch.failed))
+        result = RTN_ERROR;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Batch finished, %u job(s) failed.\n",
+               atomic_load(&batch.failed));
+
+end:
+    if (captures)
+        free_worker_pool(captures);
+    if (batch.encoders)
+        free_worker_pool(batch.encoders);
+    if (capture_group_ready)
+        destroy_worker_group(&capture_group);
+    if (encode_group_ready)
+        destroy_worker_group(&batch.encode_group);
+    pthread_mutex_destroy(&batch.report_mutex);
+    if (!from_stdin)
+        fclose(file);
+
+    return result;
+}
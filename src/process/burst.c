@@ -0,0 +1,324 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | burst.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libavutil/imgutils.h"
+#include "output.h"
+#include "process.h"
+#include "scaler.h"
+#include "stream.h"
+#include "utilities.h"
+#include "workers.h"
+
+#define BURST_BOUNDARY "streamshot-burst"  // Boundary of the --output-fd multipart stream.
+
+/* One frame of the burst handed to the encode workers */
+typedef struct _burst_job_s
+{
+    const options_t* options;    // Options with the output path and encoding settings.
+    image_t frame;               // View of the converted frame in the frame pool (not owned).
+    unsigned long long number;   // Number of the frame in the burst, starting at 1.
+    time_t when;                 // Capture time of the burst.
+    image_t* encoded;            // Encoded frame kept for the --output-fd stream (or NULL).
+    short result;                // Result of the job (0: encoded and written, -1: failed).
+} _burst_job_t;
+
+/* Preallocated frames the burst is decoded into */
+typedef struct _frame_pool_s
+{
+    uint8_t* data;     // One buffer holding every frame of the pool.
+    AVFrame** frames;  // Frames wrapping consecutive slices of the buffer.
+    int count;         // Number of frames in the pool.
+} _frame_pool_t;
+
+process_t* _init_process(const stream_t* stream, const options_t* options);
+short _calculate_limits(stream_t* stream, const options_t* options);
+short _check_process_status(const process_t* process, const stream_t* stream);
+short _read_frame(stream_t* stream, process_t* process, const options_t* options);
+short _scale_image_data(const image_t* raw_image, const options_t* options, image_t* scaled_image);
+
+/* Releases the frames of the pool and the buffer they wrap */
+static void _free_frame_pool(_frame_pool_t* pool)
+{
+    for (int i = 0; pool->frames && i < pool->count; ++i)
+        if (pool->frames[i])
+            av_frame_free(&pool->frames[i]);
+
+    free(pool->frames);
+    av_free(pool->data);
+    pool->frames = NULL;
+    pool->data = NULL;
+}
+
+/**
+ * @brief Allocates every frame of the burst before the first one is decoded.
+ *
+ * The frames share one buffer of count * process->image_size bytes and have the pixel format
+ * and dimensions of the process image frame, so the decode loop only converts into them.
+ *
+ * @param pool     Pointer to the pool to initialise.
+ * @param process  Pointer to the process with the image size and the image frame format.
+ * @param count    Number of frames of the burst.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static short _init_frame_pool(_frame_pool_t* pool, const process_t* process, int count)
+{
+    pool->count = count;
+    pool->data = (uint8_t*)av_malloc(process->image_size * (size_t)count);
+    pool->frames = (AVFrame**)calloc((size_t)count, sizeof(AVFrame*));
+    if (!pool->data || !pool->frames)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _init_frame_pool | " ERROR_FAILED_TO_ALLOCATE_BUFFER "\n");
+        goto error;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        pool->frames[i] = av_frame_alloc();
+        if (!pool->frames[i])
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) _init_frame_pool | " ERROR_FAILED_TO_ALLOCATE_IMAGE_FRAME "\n");
+            goto error;
+        }
+
+        if (wrap_frame_buffer(pool->frames[i], pool->data + process->image_size * (size_t)i,
+                              process->image_frame->width, process->image_frame->height,
+                              (enum AVPixelFormat)process->image_frame->format))
+            goto error;
+    }
+
+    return RTN_SUCCESS;
+
+error:
+    _free_frame_pool(pool);
+    return RTN_ERROR;
+}
+
+/* Worker task: scales and encodes one frame of the burst, then writes it to its numbered file */
+static void _run_burst_job(void* arg)
+{
+    _burst_job_t* job = (_burst_job_t*)arg;
+    job->result = RTN_ERROR;
+
+    image_t scaled_image;
+    if (_scale_image_data(&job->frame, job->options, &scaled_image))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _run_burst_job | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        return;
+    }
+
+    image_t* image = get_converted_image(job->options, scaled_image.data ? &scaled_image
+                                                                          : &job->frame);
+    free(scaled_image.data);
+    if (!image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _run_burst_job | " ERROR_FAILED_TO_CONVERT_IMAGE "\n");
+        return;
+    }
+
+    job->result = RTN_SUCCESS;
+    if (job->options->output_file_path)
+    {
+        options_t frame_options = *job->options;
+        frame_options.output_file_fd = -1;
+        frame_options.output_file_path =
+            get_burst_frame_path(job->options->output_file_path, job->number, job->when);
+
+        if (!frame_options.output_file_path || write_image(&frame_options, image))
+            job->result = RTN_ERROR;
+        free(frame_options.output_file_path);
+    }
+
+    // The descriptor receives the frames in order once the whole burst is encoded
+    if (job->options->output_file_fd != -1)
+        job->encoded = image;
+    else
+        free_image(image);
+}
+
+/**
+ * @brief Writes the encoded burst to the output descriptor as one multipart stream.
+ *
+ * Every frame is one part of a multipart/x-mixed-replace body (the MJPEG-over-HTTP framing),
+ * with its Content-Type and Content-Length, in the order the frames were decoded. Frames
+ * that failed to encode are skipped.
+ *
+ * @param options  Pointer to the options_t structure holding the descriptor and write timeout.
+ * @param jobs     Pointer to the finished burst jobs.
+ * @param count    Number of jobs.
+ *
+ * @return 0 if every part was written, or -1 on failure.
+ */
+static short _write_burst_stream(const options_t* options, const _burst_job_t* jobs, int count)
+{
+    const char* mime_type = image_format_to_mime_type(options->output_format);
+    char header[256];
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!jobs[i].encoded)
+            continue;
+
+        int length = snprintf(header, sizeof(header),
+                              "--" BURST_BOUNDARY "\r\nContent-Type: %s\r\nContent-Length: %zu\r\n"
+                              "X-Frame-Number: %llu\r\n\r\n",
+                              mime_type, jobs[i].encoded->size, jobs[i].number);
+
+        if (write_data_to_fd_with_deadline(options->output_file_fd, header, (size_t)length,
+                                           options->write_timeout_ms, NULL) < 0 ||
+            write_data_to_fd_with_deadline(options->output_file_fd, jobs[i].encoded->data,
+                                           jobs[i].encoded->size, options->write_timeout_ms,
+                                           NULL) < 0 ||
+            write_data_to_fd_with_deadline(options->output_file_fd, "\r\n", 2,
+                                           options->write_timeout_ms, NULL) < 0)
+            return RTN_ERROR;
+    }
+
+    const char* closing = "--" BURST_BOUNDARY "--\r\n";
+    if (write_data_to_fd_with_deadline(options->output_file_fd, closing, strlen(closing),
+                                       options->write_timeout_ms, NULL) < 0)
+        return RTN_ERROR;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET
+                         " Wrote burst as multipart stream to file descriptor: %d\n",
+               options->output_file_fd);
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Captures options->burst_frames consecutive frames, starting at the first I-frame, as
+ * separate images.
+ *
+ * Every frame of the burst is converted into a frame pool allocated up front, so the decode
+ * loop never allocates. As soon as a frame lands in the pool it is handed to a worker pool
+ * that scales, encodes and writes it to its numbered file while the next frames are decoded.
+ * The descriptor set with --output-fd receives the whole burst, in order, as one multipart
+ * stream. Frames decoded before the stream failed are still written.
+ *
+ * @param options  Pointer to the options_t structure containing configuration options.
+ *
+ * @return 0 if every frame was captured and written, or -1 on failure.
+ */
+short run_burst(options_t* options)
+{
+    if (!options || options->burst_frames <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) run_burst | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    int count = options->burst_frames;
+    _frame_pool_t frame_pool = {0};
+    _burst_job_t* jobs = NULL;
+    worker_pool_t* pool = NULL;
+    worker_group_t group;
+    short group_ready = 0;
+    short result = RTN_ERROR;
+    int submitted = 0;
+
+    stream_t* stream = get_stream(options);
+    process_t* process = stream ? _init_process(stream, options) : NULL;
+    if (!process || _calculate_limits(stream, options) ||
+        _init_frame_pool(&frame_pool, process, count))
+        goto end;
+
+    jobs = (_burst_job_t*)calloc((size_t)count, sizeof(_burst_job_t));
+    if (!jobs)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) run_burst | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        goto end;
+    }
+
+    // Leave a core to the demuxer and decoder
+    int threads_count = get_cpu_count() > 1 ? get_cpu_count() - 1 : 1;
+    pool = create_worker_pool(threads_count < count ? threads_count : count, count);
+    if (!pool || init_worker_group(&group))
+        goto end;
+    group_ready = 1;
+
+    time_t when = time(NULL);
+    process->burst_frames = frame_pool.frames;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Starting a burst of %d frames on %d workers...\n",
+               count, threads_count < count ? threads_count : count);
+
+    short reading = 1;
+    while (submitted < count)
+    {
+        reading = reading && process->received_frames < stream->number_of_frames_to_read &&
+                  monotonic_time_in_microseconds() < stream->stop_reading_at &&
+                  !_read_frame(stream, process, options);
+
+        for (; submitted < (int)process->received_frames; ++submitted)
+        {
+            _burst_job_t* job = &jobs[submitted];
+            job->options = options;
+            job->frame.data = frame_pool.data + process->image_size * (size_t)submitted;
+            job->frame.size = process->image_size;
+            job->frame.width = frame_pool.frames[submitted]->width;
+            job->frame.height = frame_pool.frames[submitted]->height;
+            job->number = (unsigned long long)submitted + 1;
+            job->when = when;
+            job->result = RTN_ERROR;
+            if (submit_worker_task(pool, &group, _run_burst_job, job))
+                break;
+        }
+
+        if (!reading)
+            break;
+    }
+
+    set_deadline_stage("encode");
+    wait_worker_group(&group);
+
+    result = _check_process_status(process, stream);
+    for (int i = 0; i < submitted; ++i)
+        if (jobs[i].result)
+            result = RTN_ERROR;
+
+    if (options->output_file_fd != -1 && submitted &&
+        _write_burst_stream(options, jobs, submitted))
+        result = RTN_ERROR;
+
+    if (options->debug)
+    {
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Burst finished: %d of %d frames captured\n",
+               submitted, count);
+        print_transport_stats(stream);
+    }
+
+end:
+    if (group_ready)
+        destroy_worker_group(&group);
+    free_worker_pool(pool);
+    for (int i = 0; jobs && i < count; ++i) free_image(jobs[i].encoded);
+    free(jobs);
+    _free_frame_pool(&frame_pool);
+    free_process(process);
+    free_stream(stream);
+    return result;
+}
@@ -7,13 +7,14 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | calculate_limits.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-19
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#include <limits.h>
 #include <unistd.h>
 
 #include "errors.h"
@@ -21,6 +22,35 @@
 #include "stream.h"
 #include "utilities.h"
 
+/* Average frame rate of the video stream, the real frame rate as a fallback, or DEFAULT_FPS */
+static double _get_frame_rate(const stream_t* stream)
+{
+    AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
+    if (video_stream->avg_frame_rate.den && video_stream->avg_frame_rate.num)
+        return av_q2d(video_stream->avg_frame_rate);
+    else if (video_stream->r_frame_rate.den && video_stream->r_frame_rate.num)
+        return av_q2d(video_stream->r_frame_rate);
+
+    return DEFAULT_FPS;
+}
+
+/* GOP duration measured on the stream or cached in its profile, or DEFAULT_GOP_SEC */
+static double _get_gop_sec(const stream_t* stream)
+{
+    return stream->keyframe_interval_sec > 0 ? stream->keyframe_interval_sec : DEFAULT_GOP_SEC;
+}
+
+/* Wait for the first I-frame: a few learned GOPs, or I_FRAME_TIMEOUT_SEC while none is known */
+static double _get_i_frame_wait_sec(const stream_t* stream)
+{
+    if (stream->keyframe_interval_sec <= 0)
+        return I_FRAME_TIMEOUT_SEC;
+
+    double wait_sec = (MAX_MISSED_KEYFRAMES + 1) * stream->keyframe_interval_sec +
+                      FRAME_DELIVERY_LATENCY_SEC;
+    return wait_sec < I_FRAME_TIMEOUT_SEC ? wait_sec : I_FRAME_TIMEOUT_SEC;
+}
+
 /**
  * @brief Calculates and sets the number of frames to read from a video stream based on the exposure
  * time and stream properties.
@@ -28,7 +58,11 @@
  * This function determines the number of frames to read from the provided stream, using the
  * exposure time specified in the options. It uses the stream's average frame rate (or real frame
  * rate as a fallback) to compute the frame count. If the exposure time is zero, only one frame is
- * read.
+ * read; a burst or a best-of reads exactly its options->burst_frames or options->best_of
+ * frames. With --stack keyframes the count follows the GOP cadence instead of the frame rate.
+ * With --exposure-end pts the count is only an upper bound: the exposure ends when the covered
+ * stream time reaches the exposure time. The nominal frame duration in stream time base units
+ * is set as well.
  *
  * @param stream   Pointer to the stream_t structure containing stream information.
  * @param options  Pointer to the options_t structure containing configuration options.
@@ -48,29 +82,43 @@ short _number_of_frames_to_read(stream_t* stream, const options_t* options)
         return RTN_ERROR;
     }
 
-    if (options->exposure_sec == 0)
+    double fps = _get_frame_rate(stream);
+    if (fps <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _calculate_number_of_frames_to_read | " ERROR_INVALID_FPS "\n");
+        return RTN_ERROR;
+    }
+
+    AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
+    double ticks_per_frame = 1.0 / (fps * av_q2d(video_stream->time_base));
+    stream->frame_duration = ticks_per_frame >= 1 ? (int64_t)(ticks_per_frame + 0.5) : 1;
+
+    unsigned long long safe_frame_limit = ULLONG_MAX / UINT8_MAX;
+    if (safe_frame_limit > UINT_MAX)
+        safe_frame_limit = UINT_MAX;
+
+    if (options->burst_frames > 0)
+        stream->number_of_frames_to_read = (unsigned int)options->burst_frames;
+    else if (options->best_of > 0)
+        stream->number_of_frames_to_read = (unsigned int)options->best_of;
+    else if (options->exposure_sec == 0)
         stream->number_of_frames_to_read = 1;
+    else if (options->exposure_end == EXPOSURE_END_PTS)
+        stream->number_of_frames_to_read = (unsigned int)safe_frame_limit;
+    else if (options->stack_mode == STACK_MODE_KEYFRAMES)
+    {
+        // One keyframe per GOP: assume a typical GOP until _refine_keyframe_count() measures it
+        stream->number_of_frames_to_read =
+            (unsigned int)(options->exposure_sec / _get_gop_sec(stream) + 0.5);
+        if (!stream->number_of_frames_to_read)
+            stream->number_of_frames_to_read = 1;
+    }
     else
     {
-        double fps = DEFAULT_FPS;
-        AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
-        if (video_stream->avg_frame_rate.den && video_stream->avg_frame_rate.num)
-            fps = av_q2d(video_stream->avg_frame_rate);
-        else if (video_stream->r_frame_rate.den && video_stream->r_frame_rate.num)
-            fps = av_q2d(video_stream->r_frame_rate);
-
-        if (fps <= 0)
-        {
-            write_msg_to_fd(STDERR_FILENO,
-                            "(f) _calculate_number_of_frames_to_read | " ERROR_INVALID_FPS "\n");
-            return RTN_ERROR;
-        }
-
-        stream->number_of_frames_to_read = (unsigned int)(options->exposure_sec * fps + 0.5);
-
-        unsigned long long safe_frame_limit = ULLONG_MAX / UINT8_MAX;
-        if (stream->number_of_frames_to_read > safe_frame_limit)
-            stream->number_of_frames_to_read = safe_frame_limit;
+        double frames = options->exposure_sec * fps + 0.5;
+        stream->number_of_frames_to_read =
+            frames > safe_frame_limit ? (unsigned int)safe_frame_limit : (unsigned int)frames;
     }
 
     if (options->debug)
@@ -84,9 +132,14 @@ short _number_of_frames_to_read(stream_t* stream, const options_t* options)
  * @brief Calculates and sets the timestamp at which reading from the stream should stop.
  *
  * This function determines the stop time for reading from the given stream based on the provided
- * options. If the exposure time is zero, it uses a default timeout (I_FRAME_TIMEOUT_SEC). If the
- * exposure time is positive, it adds the exposure time and network jitter to the timeout. If the
- * exposure time is negative, it writes an error message to STDERR.
+ * options. If the exposure time is zero, it waits for the first I-frame (a few learned GOPs, or
+ * I_FRAME_TIMEOUT_SEC while the GOP is unknown), to which a burst or a best-of adds the delivery
+ * latency of each of its frames. If the exposure time is positive, it adds the exposure time
+ * and network jitter to the I-frame wait (and one GOP for
+ * --stack keyframes); the jitter of a --exposure-end pts exposure is a single delivery latency,
+ * since no frame count has to be estimated. If the exposure time is negative, it writes an error
+ * message to STDERR. The stop time is on the monotonic clock and never later than the
+ * --deadline-ms budget.
  *
  * @param stream   Pointer to the stream_t structure containing stream information.
  * @param options  Pointer to the options_t structure containing configuration options.
@@ -108,21 +161,40 @@ short _stop_reading_at(stream_t* stream, const options_t* options)
     else
         number_of_frames_to_read = (unsigned int)(options->exposure_sec * fps + 0.5);
 
-    if (!options->exposure_sec)
-        stream->stop_reading_at =
-            time_now_in_microseconds() + (long long)(I_FRAME_TIMEOUT_SEC * 1000000);
-    else if (options->exposure_sec > 0)
+    double i_frame_wait_sec = _get_i_frame_wait_sec(stream);
+    if (!options->exposure_sec && (options->burst_frames || options->best_of))
         stream->stop_reading_at =
-            time_now_in_microseconds() +
-            (long long)((I_FRAME_TIMEOUT_SEC + options->exposure_sec +
+            monotonic_time_in_microseconds() +
+            (long long)((i_frame_wait_sec +
                          FRAME_DELIVERY_LATENCY_SEC * number_of_frames_to_read) *
                         1000000);
+    else if (!options->exposure_sec)
+        stream->stop_reading_at =
+            monotonic_time_in_microseconds() + (long long)(i_frame_wait_sec * 1000000);
+    else if (options->exposure_sec > 0)
+    {
+        // Stream time ends a pts exposure, so only its last frame can still be in flight
+        double slack = options->exposure_end == EXPOSURE_END_PTS
+                           ? FRAME_DELIVERY_LATENCY_SEC
+                           : FRAME_DELIVERY_LATENCY_SEC * number_of_frames_to_read;
+        if (options->stack_mode == STACK_MODE_KEYFRAMES)
+            slack += _get_gop_sec(stream);
+
+        stream->stop_reading_at =
+            monotonic_time_in_microseconds() +
+            (long long)((i_frame_wait_sec + options->exposure_sec + slack) * 1000000);
+    }
     else
     {
         write_msg_to_fd(STDERR_FILENO, "(f) _stop_reading_at | " ERROR_INVALID_EXPOSURE "\n");
         return RTN_ERROR;
     }
 
+    // Reading never outlives the --deadline-ms budget
+    long long deadline_at = get_deadline_at();
+    if (deadline_at && deadline_at < stream->stop_reading_at)
+        stream->stop_reading_at = deadline_at;
+
     if (options->debug)
         printf(ANSI_BLUE "Debug:" ANSI_RESET " Stop reading at: %lld microseconds\n",
                stream->stop_reading_at);
@@ -155,3 +227,43 @@ short _calculate_limits(stream_t* stream, const options_t* options)
 
     return RTN_SUCCESS;
 }
+
+/**
+ * @brief Recomputes the number of keyframes of a --stack keyframes exposure from their PTS.
+ *
+ * Called after each stacked keyframe. The GOP duration is the average PTS distance between
+ * the keyframes stacked so far, so the exposure covers options->exposure_sec of stream time
+ * however far the camera's GOP is from DEFAULT_GOP_SEC.
+ *
+ * @param stream   Pointer to the stream_t structure with the frame count to refine.
+ * @param process  Pointer to the process with the keyframe just stacked.
+ * @param options  Pointer to the options_t structure containing the exposure time.
+ */
+void _refine_keyframe_count(stream_t* stream, process_t* process, const options_t* options)
+{
+    int64_t pts = process->video_frame->best_effort_timestamp;
+    if (pts == AV_NOPTS_VALUE)
+        return;
+
+    if (process->received_frames <= 1 || process->first_keyframe_pts == AV_NOPTS_VALUE)
+    {
+        process->first_keyframe_pts = pts;
+        return;
+    }
+
+    AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
+    double interval = (double)(pts - process->first_keyframe_pts) *
+                      av_q2d(video_stream->time_base) / (double)(process->received_frames - 1);
+    if (interval <= 0)
+        return;
+
+    unsigned int frames = (unsigned int)(options->exposure_sec / interval + 0.5);
+    if (frames < process->received_frames)
+        frames = (unsigned int)process->received_frames;
+
+    if (options->debug && frames != stream->number_of_frames_to_read)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " GOP of %.3f s measured, keyframes to read: %u\n",
+               interval, frames);
+
+    stream->number_of_frames_to_read = frames;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | get_raw_image.c
     ::  ::          ::  ::    Created  | 2025-06-19
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -41,7 +41,7 @@ short _scale_image(image_t* raw_image, const options_t* options);
  *
  * @return 0 if the required number of frames were processed, -1 otherwise.
  */
-static short _check_process_status(const process_t* process, const stream_t* stream)
+short _check_process_status(const process_t* process, const stream_t* stream)
 {
     if (!process || !stream)
     {
@@ -71,30 +71,36 @@ static short _check_process_status(const process_t* process, const stream_t* str
     return RTN_SUCCESS;
 }
 
+/* Claims the --input-alt race at the first I-frame; a stream that lost it stops reading */
+static short _race_lost(stream_t* stream, const process_t* process, const options_t* options)
+{
+    if (!stream->race)
+        return 0;
+    if (!process->got_first_i_frame)
+        return stream_race_lost(stream);
+
+    return claim_stream_race(stream, options) != RTN_SUCCESS;
+}
+
 /**
- * @brief Retrieves a raw image from a stream based on the provided options.
+ * @brief Captures a raw image from an opened stream based on the provided options.
  *
- * This function initializes the necessary stream and process structures,
- * reads frames from an RTSP stream according to the specified options,
- * and constructs a raw image from the received data.
+ * This function initializes the process structure, reads frames from the RTSP
+ * stream according to the specified options, and constructs a raw image from the
+ * received data. In publishing mode (options->shm_name set) the capture loop keeps
+ * running and publishing frames to shared memory until a stop signal is received.
+ * When output variants are configured the image is returned unscaled, as every
+ * variant scales it itself. A stream racing for --input-alt stops, silently, as
+ * soon as another stream won.
  *
+ * @param stream   Pointer to the opened stream, which the caller frees.
  * @param options  Pointer to the options_t structure containing configuration options.
  *
  * @return Pointer to a image_t structure containing the image data,
  *         or NULL if an error occurred during the process.
  */
-image_t* get_raw_image(options_t* options)
+image_t* _capture_raw_image(stream_t* stream, options_t* options)
 {
-    if (!options)
-    {
-        write_msg_to_fd(STDERR_FILENO, "(f) get_streamshot | " ERROR_INVALID_ARGUMENTS "\n");
-        return NULL;
-    }
-
-    stream_t* stream = get_stream(options);
-    if (stream == NULL)
-        return NULL;
-
     process_t* process = _init_process(stream, options);
     if (!process)
         goto error;
@@ -102,13 +108,32 @@ image_t* get_raw_image(options_t* options)
     if (_calculate_limits(stream, options))
         goto error;
 
+    if (options->shm_name)
+    {
+        process->shm_ring =
+            open_shm_ring(options, stream->region.width, stream->region.height,
+                          stream->format_context->streams[stream->video_stream_index]->time_base);
+        if (!process->shm_ring)
+            goto error;
+    }
+
     if (options->debug)
         printf(ANSI_BLUE "Debug:" ANSI_RESET " Starting to read %u frames from RTSP stream...\n",
                stream->number_of_frames_to_read);
 
-    while (process->received_frames < stream->number_of_frames_to_read &&
-           time_now_in_microseconds() < stream->stop_reading_at &&
-           !_read_frame(stream, process, options));
+    while (((process->received_frames < stream->number_of_frames_to_read &&
+             monotonic_time_in_microseconds() < stream->stop_reading_at) ||
+            (process->shm_ring && !stop_requested())) &&
+           !_read_frame(stream, process, options) && !_race_lost(stream, process, options));
+
+    if (options->debug && process->shm_ring)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Published %llu frames to shared memory %s\n",
+               process->shm_ring->published, process->shm_ring->name);
+    if (options->debug)
+        print_transport_stats(stream);
+
+    if (_race_lost(stream, process, options))
+        goto error;
 
     if (_check_process_status(process, stream))
         goto error;
@@ -120,18 +145,47 @@ image_t* get_raw_image(options_t* options)
         goto error;
     }
 
-    if (_scale_image(raw_image, options))
+    if (!options->outputs_count && _scale_image(raw_image, options))
     {
         write_msg_to_fd(STDERR_FILENO, "(f) get_raw_image | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
         goto error;
     }
 
     free_process(process);
-    free_stream(stream);
     return raw_image;
 
 error:
     free_process(process);
-    free_stream(stream);
     return NULL;
 }
+
+/**
+ * @brief Retrieves a raw image from a stream based on the provided options.
+ *
+ * This function opens the RTSP stream and captures a raw image from it, or
+ * races the --input and --input-alt streams for it when an alternative is set.
+ *
+ * @param options  Pointer to the options_t structure containing configuration options.
+ *
+ * @return Pointer to a image_t structure containing the image data,
+ *         or NULL if an error occurred during the process.
+ */
+image_t* get_raw_image(options_t* options)
+{
+    if (!options)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_streamshot | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    if (options->input_alt)
+        return race_raw_image(options);
+
+    stream_t* stream = get_stream(options);
+    if (stream == NULL)
+        return NULL;
+
+    image_t* raw_image = _capture_raw_image(stream, options);
+    free_stream(stream);
+    return raw_image;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | process.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -20,9 +20,40 @@
 
 #include "errors.h"
 #include "libavutil/imgutils.h"
+#include "scaler.h"
 #include "stream.h"
 #include "utilities.h"
 
+/**
+ * @brief Allocates the second image frame and the scoring plane of --best-of.
+ *
+ * @param process       Pointer to the process with the image size already set.
+ * @param stream        Pointer to the stream_t structure with the processed region.
+ * @param pixel_format  Pixel format of the image frame.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static short _init_best_frame(process_t* process, const stream_t* stream,
+                              enum AVPixelFormat pixel_format)
+{
+    process->best_frame = av_frame_alloc();
+    process->best_buffer = (uint8_t*)av_malloc(process->image_size);
+    process->score_buffer =
+        (uint8_t*)malloc((size_t)(stream->region.width / 2) * (stream->region.height / 2) + 1);
+    if (!process->best_frame || !process->best_buffer || !process->score_buffer)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _init_best_frame | " ERROR_FAILED_TO_ALLOCATE_BUFFER "\n");
+        return RTN_ERROR;
+    }
+
+    if (wrap_frame_buffer(process->best_frame, process->best_buffer, stream->region.width,
+                          stream->region.height, pixel_format))
+        return RTN_ERROR;
+
+    return RTN_SUCCESS;
+}
+
 /**
  * @brief Initializes a process_t structure for video frame processing.
  *
@@ -30,8 +61,11 @@
  * video frames from the given stream, including AVPacket, AVFrame structures,
  * image buffer, and sum buffer. It performs validation on input arguments and
  * handles allocation failures gracefully by cleaning up any partially allocated
- * resources. The function also sets up the image frame with the correct width,
- * height, and pixel format, and prepares the buffer for RGB24 image data.
+ * resources. The function also sets up the image frame with the width and height
+ * of the processed region of the stream, and prepares the buffer for RGB24 image data,
+ * or for GRAY8 data in --gray mode, which needs a third of the image and sum buffers.
+ * With --best-of the sum buffer is replaced by a second image frame holding the best frame
+ * so far and the scratch plane frames are scored on.
  *
  * @param stream   Pointer to the stream_t structure containing codec context and stream index.
  * @param options  Pointer to the options_t structure containing configuration options.
@@ -62,6 +96,16 @@ process_t* _init_process(const stream_t* stream, const options_t* options)
     process->received_frames = 0;
     process->got_first_i_frame = 0;
     process->stream_read_status = 0;
+    process->shm_ring = NULL;
+    process->burst_frames = NULL;
+    process->best_frame = NULL;
+    process->best_buffer = NULL;
+    process->score_buffer = NULL;
+    process->best_score = -1;
+    process->first_keyframe_pts = AV_NOPTS_VALUE;
+    process->last_pts = AV_NOPTS_VALUE;
+    process->covered_duration = 0;
+    process->sum_weight = 0;
 
     process->av_packet = av_packet_alloc();
     if (!process->av_packet)
@@ -86,10 +130,11 @@ process_t* _init_process(const stream_t* stream, const options_t* options)
         goto error;
     }
 
-    process->image_frame->width = stream->codec_context->width;
-    process->image_frame->height = stream->codec_context->height;
+    process->image_frame->width = stream->region.width;
+    process->image_frame->height = stream->region.height;
 
-    int size = av_image_get_buffer_size(AV_PIX_FMT_RGB24, process->image_frame->width,
+    enum AVPixelFormat pixel_format = options->gray ? AV_PIX_FMT_GRAY8 : AV_PIX_FMT_RGB24;
+    int size = av_image_get_buffer_size(pixel_format, process->image_frame->width,
                                         process->image_frame->height, 1);
     if (size < 0)
     {
@@ -106,23 +151,30 @@ process_t* _init_process(const stream_t* stream, const options_t* options)
         goto error;
     }
 
-    if ((ssize_t)process->image_size !=
-        (ssize_t)av_image_fill_arrays(
-            process->image_frame->data, process->image_frame->linesize, process->buffer,
-            AV_PIX_FMT_RGB24, stream->codec_context->width, stream->codec_context->height, 1))
+    // The frame refers to the buffer, so the conversion writes straight into it
+    if (wrap_frame_buffer(process->image_frame, process->buffer, stream->region.width,
+                          stream->region.height, pixel_format))
     {
         write_msg_to_fd(STDERR_FILENO,
                         "(f) _init_process | " ERROR_FAILED_TO_FILL_IMAGE_ARRAYS "\n");
         goto error;
     }
 
-    process->sum_buffer =
-        (unsigned long long*)calloc(process->image_size, sizeof(unsigned long long));
-    if (!process->sum_buffer)
+    if (options->best_of)
     {
-        write_msg_to_fd(STDERR_FILENO,
-                        "(f) _init_process | " ERROR_FAILED_TO_ALLOCATE_SUM_BUFFER "\n");
-        goto error;
+        if (_init_best_frame(process, stream, pixel_format))
+            goto error;
+    }
+    else
+    {
+        process->sum_buffer =
+            (unsigned long long*)calloc(process->image_size, sizeof(unsigned long long));
+        if (!process->sum_buffer)
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) _init_process | " ERROR_FAILED_TO_ALLOCATE_SUM_BUFFER "\n");
+            goto error;
+        }
     }
 
     process->received_frames = 0;
@@ -167,6 +219,14 @@ void free_process(process_t* process)
         av_free(process->buffer);
     if (process->sum_buffer)
         free(process->sum_buffer);
+    if (process->best_frame)
+        av_frame_free(&process->best_frame);
+    if (process->best_buffer)
+        av_free(process->best_buffer);
+    if (process->score_buffer)
+        free(process->score_buffer);
+    if (process->shm_ring)
+        close_shm_ring(process->shm_ring);
 
     free(process);
     process = NULL;
@@ -0,0 +1,121 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | race.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "process.h"
+#include "stream.h"
+#include "utilities.h"
+#include "workers.h"
+
+/* One stream of the race, opened and read on its own worker thread */
+typedef struct _race_job_s
+{
+    options_t options;    // Copy of the options with the URL of this stream (not owned).
+    stream_race_t* race;  // Race shared by both streams.
+    int index;            // Index of the stream in the race (0: --input, 1: --input-alt).
+    image_t* raw_image;   // Image captured by the winner (NULL: lost or failed).
+} _race_job_t;
+
+image_t* _capture_raw_image(stream_t* stream, options_t* options);
+
+/* Opens one stream of the race and captures from it until it wins, loses or fails */
+static void _run_race_job(void* arg)
+{
+    _race_job_t* job = (_race_job_t*)arg;
+    stream_t* stream = get_racing_stream(&job->options, job->race, job->index);
+    if (stream)
+    {
+        job->raw_image = _capture_raw_image(stream, &job->options);
+        free_stream(stream);
+    }
+
+    // A stream that failed stops the other one from waiting for it
+    leave_stream_race(job->race, job->index);
+}
+
+/**
+ * @brief Captures a raw image from whichever of --input and --input-alt is usable first.
+ *
+ * Both streams are opened and read in parallel on separate worker threads. The first one
+ * to decode an I-frame that covers the requested output size wins; the other is cancelled
+ * through its interrupt callback, whether it is still connecting, probing or reading.
+ * Cameras start the GOPs of their main and sub streams at different times, so the race cuts
+ * the wait for a keyframe. A small output lets the cheaper sub stream qualify, and it is
+ * preferred: a larger stream that qualifies first leaves it RACE_GRACE_MS to qualify too.
+ *
+ * @param options  Pointer to the options_t structure with both URLs.
+ *
+ * @return Pointer to the image captured by the winning stream, or NULL if neither delivered.
+ */
+image_t* race_raw_image(options_t* options)
+{
+    if (!options || !options->rtsp_url || !options->input_alt)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) race_raw_image | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    stream_race_t race;
+    init_stream_race(&race);
+
+    _race_job_t jobs[RACE_STREAMS];
+    for (int i = 0; i < RACE_STREAMS; ++i)
+    {
+        jobs[i] = (_race_job_t){.options = *options, .race = &race, .index = i};
+        jobs[i].options.rtsp_url = i ? options->input_alt : options->rtsp_url;
+    }
+
+    worker_group_t group;
+    worker_pool_t* pool = create_worker_pool(RACE_STREAMS, RACE_STREAMS);
+    if (!pool || init_worker_group(&group))
+    {
+        free_worker_pool(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < RACE_STREAMS; ++i)
+        if (submit_worker_task(pool, &group, _run_race_job, &jobs[i]))
+            atomic_store(&race.winner, RACE_STREAMS);  // Cancels the stream already started.
+
+    wait_worker_group(&group);
+    destroy_worker_group(&group);
+    free_worker_pool(pool);
+
+    int winner = atomic_load(&race.winner);
+    image_t* raw_image = NULL;
+    for (int i = 0; i < RACE_STREAMS; ++i)
+    {
+        if (i == winner)
+            raw_image = jobs[i].raw_image;
+        else
+            free_image(jobs[i].raw_image);
+    }
+
+    if (!raw_image)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) race_raw_image | " ERROR_NO_STREAM_WON_RACE "\n");
+        return NULL;
+    }
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Captured from %s\n",
+               winner ? "--input-alt" : "--input");
+
+    return raw_image;
+}
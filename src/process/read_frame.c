@@ -7,36 +7,47 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | read_frame.c
     ::  ::          ::  ::    Created  | 2025-06-19
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#include <string.h>
 #include <unistd.h>
 
 #include "errors.h"
 #include "process.h"
+#include "scaler.h"
 #include "stream.h"
 #include "utilities.h"
 
+void _refine_keyframe_count(stream_t* stream, process_t* process, const options_t* options);
+
 /**
  * @brief Saves the current image frame to a debug file in PPM format.
  *
  * This function checks if all required pointers and data are valid, then constructs
  * a file name using the debug directory and the number of received frames. It saves
- * the image frame data as a PPM file for debugging purposes.
+ * the image frame data as a PPM file (PGM in --gray mode) for debugging purposes.
  *
+ * @param stream  Pointer to the stream_t structure with the processed region.
  * @param process Pointer to the process structure containing the image frame and related data.
  * @param options Pointer to the options structure containing debug settings and directory path.
  */
-static void _save_debug_frame(process_t* process, const options_t* options)
+static void _save_debug_frame(const stream_t* stream, process_t* process,
+                              const options_t* options)
 {
     if (!process || !options || !options->debug_dir || !process->image_frame ||
         !process->image_frame->data[0] || !process->image_size)
         return;
 
+    // The luma plane is accumulated in place, so it only lands in the image buffer here
+    if (stream->luma_plane)
+        copy_luma_plane(stream, process->video_frame, process->image_frame->data[0],
+                        process->image_frame->linesize[0]);
+
     char debug_file_name[256];
     snprintf(debug_file_name, sizeof(debug_file_name), "%s/debug_image_%010llu.ppm",
              options->debug_dir, process->received_frames);
@@ -52,11 +63,257 @@ static void _save_debug_frame(process_t* process, const options_t* options)
                         "(f) _save_debug_frame | " ERROR_FAILED_TO_SAVE_DEBUG_FILE "\n");
 }
 
+/**
+ * @brief Publishes the current frame to the shared-memory ring attached to the process.
+ *
+ * A failed publish is reported but does not stop the capture, the next frame simply
+ * overwrites the slot.
+ *
+ * @param process Pointer to the process structure with the decoded and converted frame.
+ * @param options Pointer to the options structure containing debug settings.
+ */
+static void _publish_frame(process_t* process, const options_t* options)
+{
+    if (publish_frame(process->shm_ring, process->video_frame, process->image_frame->data[0]))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _publish_frame | " ERROR_FAILED_TO_PUBLISH_FRAME "\n");
+        return;
+    }
+
+    if (options->debug && options->debug_step &&
+        (process->shm_ring->published == 1 ||
+         process->shm_ring->published % options->debug_step == 0))
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Published frame %06llu to shared memory %s\n",
+               process->shm_ring->published, process->shm_ring->name);
+}
+
+/**
+ * @brief Narrows the decoded frame to the processed region of the stream.
+ *
+ * The crop only moves the plane pointers and shrinks the frame dimensions, so the
+ * conversion, accumulation and publishing that follow never touch pixels outside
+ * the region. The region is aligned to the chroma grid by get_crop_region(), which
+ * makes the unaligned crop exact.
+ *
+ * @param stream       Pointer to the stream_t structure with the resolved region.
+ * @param video_frame  Pointer to the decoded frame to crop in place.
+ *
+ * @return 0 on success, -1 if the frame no longer contains the region.
+ */
+static short _crop_frame(const stream_t* stream, AVFrame* video_frame)
+{
+    const region_t* region = &stream->region;
+    if (region->x == 0 && region->y == 0 && region->width == video_frame->width &&
+        region->height == video_frame->height)
+        return RTN_SUCCESS;
+
+    if (region->x + region->width > video_frame->width ||
+        region->y + region->height > video_frame->height)
+        return RTN_ERROR;
+
+    video_frame->crop_left = (size_t)region->x;
+    video_frame->crop_top = (size_t)region->y;
+    video_frame->crop_right = (size_t)(video_frame->width - region->x - region->width);
+    video_frame->crop_bottom = (size_t)(video_frame->height - region->y - region->height);
+
+    return av_frame_apply_cropping(video_frame, AV_FRAME_CROP_UNALIGNED) < 0 ? RTN_ERROR
+                                                                             : RTN_SUCCESS;
+}
+
+/* Adds `count` samples, times `weight`, to the sums (the unweighted loop stays multiply-free) */
+static inline void _add_samples(unsigned long long* sums, const uint8_t* samples, size_t count,
+                                unsigned long long weight)
+{
+    if (weight == 1)
+        for (size_t i = 0; i < count; ++i) sums[i] += samples[i];
+    else
+        for (size_t i = 0; i < count; ++i) sums[i] += weight * samples[i];
+}
+
+/* Like _add_samples(), with every sample mapped through `lut` first (limited range luma) */
+static inline void _add_mapped_samples(unsigned long long* sums, const uint8_t* samples,
+                                       size_t count, unsigned long long weight,
+                                       const uint8_t* lut)
+{
+    if (weight == 1)
+        for (size_t i = 0; i < count; ++i) sums[i] += lut[samples[i]];
+    else
+        for (size_t i = 0; i < count; ++i) sums[i] += weight * lut[samples[i]];
+}
+
+/**
+ * @brief Adds the current frame to the per-sample sums of the exposure.
+ *
+ * In --gray mode with a decoded 8-bit luma plane the Y rows are summed straight from the
+ * decoded frame, so chroma is never converted or touched (limited range luma is expanded
+ * through the stream's lookup table); otherwise the converted image frame is summed.
+ *
+ * @param stream   Pointer to the stream_t structure with the processed region.
+ * @param process  Pointer to the process structure holding the frames and the sum buffer.
+ * @param weight   Weight of the frame (1, or its duration with --weight-by-duration).
+ */
+static void _accumulate_frame(const stream_t* stream, process_t* process,
+                              unsigned long long weight)
+{
+    if (!stream->luma_plane)
+    {
+        if (process->image_frame->data[0])
+            _add_samples(process->sum_buffer, process->image_frame->data[0], process->image_size,
+                         weight);
+        return;
+    }
+
+    const AVFrame* frame = process->video_frame;
+    const uint8_t* lut = get_luma_range_lut(stream, frame);
+    unsigned long long* sums = process->sum_buffer;
+    for (int y = 0; y < stream->region.height; ++y, sums += stream->region.width)
+    {
+        const uint8_t* samples = frame->data[0] + (ptrdiff_t)y * frame->linesize[0];
+        if (lut)
+            _add_mapped_samples(sums, samples, (size_t)stream->region.width, weight, lut);
+        else
+            _add_samples(sums, samples, (size_t)stream->region.width, weight);
+    }
+}
+
+/**
+ * @brief Measures the stream time covered by the current frame of an exposure.
+ *
+ * The duration is the one set by the decoder, or else the PTS distance from the previous frame
+ * of the exposure, or else the nominal frame duration; it is added to the covered stream time.
+ *
+ * @param stream   Pointer to the stream_t structure with the nominal frame duration.
+ * @param process  Pointer to the process structure holding the decoded frame.
+ * @param options  Pointer to the options structure (--weight-by-duration).
+ *
+ * @return The weight of the frame: its duration with --weight-by-duration, otherwise 1.
+ */
+static unsigned long long _measure_frame_time(const stream_t* stream, process_t* process,
+                                              const options_t* options)
+{
+    const AVFrame* frame = process->video_frame;
+    int64_t pts = frame->best_effort_timestamp;
+    int64_t duration = stream->frame_duration;
+    if (frame->duration > 0)
+        duration = frame->duration;
+    else if (pts != AV_NOPTS_VALUE && process->last_pts != AV_NOPTS_VALUE &&
+             pts > process->last_pts)
+        duration = pts - process->last_pts;
+
+    process->last_pts = pts;
+    process->covered_duration += duration;
+
+    unsigned long long weight = options->weight_by_duration ? (unsigned long long)duration : 1;
+    process->sum_weight += weight;
+    return weight;
+}
+
+/**
+ * @brief Ends a --exposure-end pts exposure once its frames cover the exposure time.
+ *
+ * The frame count is cut to the frames received so far, which stops the read loop and makes
+ * them the divisor of the average.
+ *
+ * @param stream   Pointer to the stream_t structure with the frame count to end.
+ * @param process  Pointer to the process structure with the covered stream time.
+ * @param options  Pointer to the options structure with the exposure time.
+ */
+static void _end_exposure_at_pts(stream_t* stream, const process_t* process,
+                                 const options_t* options)
+{
+    AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
+    double covered = (double)process->covered_duration * av_q2d(video_stream->time_base);
+    if (covered < options->exposure_sec)
+        return;
+
+    stream->number_of_frames_to_read = (unsigned int)process->received_frames;
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Exposure covered %.3f s of stream time in %llu "
+                                             "frames\n",
+               covered, process->received_frames);
+}
+
+/**
+ * @brief Copies the current frame into the next preallocated frame of a burst.
+ *
+ * The luma plane of --gray mode is copied row by row, every other frame is converted by the
+ * stream's SwsContext straight into the pool, so a burst frame never allocates.
+ *
+ * @param stream   Pointer to the stream_t structure with the processed region.
+ * @param process  Pointer to the process structure holding the decoded frame and the pool.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static short _keep_burst_frame(const stream_t* stream, process_t* process)
+{
+    AVFrame* burst_frame = process->burst_frames[process->received_frames];
+    if (!stream->luma_plane)
+        return scale_frame(stream->sws_context, burst_frame, process->video_frame);
+
+    copy_luma_plane(stream, process->video_frame, burst_frame->data[0], burst_frame->linesize[0]);
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Scores the current frame and keeps it if it beats the best frame of --best-of so far.
+ *
+ * The score is taken right after the conversion, while the frame is still in cache. A new
+ * best converted frame is kept by swapping the image frame with the best frame, so no pixels
+ * are copied; in --gray mode the luma rows are copied from the decoded frame.
+ *
+ * @param stream   Pointer to the stream_t structure with the processed region.
+ * @param process  Pointer to the process structure holding the frames and the best score.
+ * @param options  Pointer to the options structure containing debug settings.
+ */
+static void _keep_best_frame(const stream_t* stream, process_t* process,
+                             const options_t* options)
+{
+    const AVFrame* frame = stream->luma_plane ? process->video_frame : process->image_frame;
+    int channels = stream->luma_plane ? GRAY_BYTES_PER_PIXEL
+                                      : get_image_channels(process->image_size,
+                                                           stream->region.width,
+                                                           stream->region.height);
+    double score = get_frame_score(frame->data[0], frame->linesize[0], stream->region.width,
+                                   stream->region.height, channels, process->score_buffer);
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Frame %06llu score: %.1f%s\n",
+               process->received_frames + 1, score,
+               score > process->best_score ? " (best so far)" : "");
+
+    if (score <= process->best_score)
+        return;
+
+    process->best_score = score;
+    if (stream->luma_plane)
+    {
+        copy_luma_plane(stream, frame, process->best_frame->data[0],
+                        process->best_frame->linesize[0]);
+        return;
+    }
+
+    AVFrame* image_frame = process->image_frame;
+    uint8_t* buffer = process->buffer;
+    process->image_frame = process->best_frame;
+    process->buffer = process->best_buffer;
+    process->best_frame = image_frame;
+    process->best_buffer = buffer;
+}
+
 /**
  * @brief Reads and processes a single frame from the input stream.
  *
  * This function reads a frame from the given multimedia stream, decodes it,
- * processes the video frame, and updates the process state accordingly.
+ * crops it to the processed region, converts it, and updates the process state
+ * accordingly. Frames are accumulated until the required number of frames is
+ * reached; when a shared-memory ring is attached, every decoded frame is also
+ * published to it. In burst mode (process->burst_frames set) each frame is kept in the
+ * next preallocated burst frame instead of being accumulated, and with --best-of only the
+ * best-scored frame is kept. With --stack keyframes, non-key packets are dropped unread, and
+ * with --exposure-end pts the exposure ends on the stream time its frames cover. Loss and
+ * reordering are counted on the way; below --max-loss 100 corrupt frames are skipped, and the
+ * read fails once the loss exceeds the limit.
  *
  * @param stream   Pointer to the stream_t structure containing stream context.
  * @param process  Pointer to the process_t structure holding processing state and buffers.
@@ -73,19 +330,41 @@ short _read_frame(stream_t* stream, process_t* process, const options_t* options
     }
 
     if (!process->av_packet || !process->video_frame || !process->image_frame || !process->buffer ||
-        !process->sum_buffer)
+        (!process->sum_buffer && !process->best_frame))
     {
         write_msg_to_fd(STDERR_FILENO, "(f) _read_frame | " ERROR_INVALID_ARGUMENTS "\n");
         return RTN_ERROR;
     }
 
-    if ((process->stream_read_status = av_read_frame(stream->format_context, process->av_packet)) <
-        0)
+    if (!process->got_first_i_frame)
+        set_deadline_stage("I-frame wait");
+
+    if ((process->stream_read_status = read_stream_packet(stream, process->av_packet)) < 0)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _read_frame | " ERROR_FAILED_TO_READ_FRAME "\n");
+        // A stream that lost the --input-alt race was cancelled, it did not fail
+        if (!stream_race_lost(stream))
+            write_msg_to_fd(STDERR_FILENO, "(f) _read_frame | " ERROR_FAILED_TO_READ_FRAME "\n");
         return RTN_ERROR;
     }
 
+    if (process->av_packet->stream_index == stream->video_stream_index)
+        count_video_packet(stream, process->av_packet);
+
+    if (check_keyframe_cadence(stream))
+    {
+        av_packet_unref(process->av_packet);
+        return RTN_ERROR;
+    }
+
+    // Keyframe stacking drops non-key packets before they cost a decode
+    if (process->av_packet->stream_index == stream->video_stream_index &&
+        options->stack_mode == STACK_MODE_KEYFRAMES &&
+        !(process->av_packet->flags & AV_PKT_FLAG_KEY))
+    {
+        av_packet_unref(process->av_packet);
+        return RTN_SUCCESS;
+    }
+
     if (process->av_packet->stream_index == stream->video_stream_index)
     {
         int ret = avcodec_send_packet(stream->codec_context, process->av_packet);
@@ -107,35 +386,103 @@ short _read_frame(stream_t* stream, process_t* process, const options_t* options
                 break;
             }
 
+            if (!stream->first_frame_us)
+            {
+                stream->first_frame_us = monotonic_time_in_microseconds() - stream->opened_at;
+                if (options->debug)
+                    printf(ANSI_BLUE "Debug:" ANSI_RESET " Time to first frame: %.1f ms\n",
+                           stream->first_frame_us / 1000.0);
+
+                if (check_stream_profile(stream, process->video_frame))
+                {
+                    av_frame_unref(process->video_frame);
+                    return RTN_ERROR;
+                }
+            }
+
+            if (process->video_frame->pict_type == AV_PICTURE_TYPE_I)
+                learn_keyframe_interval(stream, process->video_frame, options);
+
             if (!process->got_first_i_frame && process->video_frame->pict_type == AV_PICTURE_TYPE_I)
             {
                 process->got_first_i_frame = 1;
+                set_deadline_stage("decode");
                 if (options->debug)
                     printf(ANSI_BLUE "Debug:" ANSI_RESET " First I-frame received.\n");
             }
             else if (!process->got_first_i_frame)
                 continue;
 
-            sws_scale(stream->sws_context, (const uint8_t* const*)process->video_frame->data,
-                      process->video_frame->linesize, 0, stream->codec_context->height,
-                      process->image_frame->data, process->image_frame->linesize);
+            if (count_video_frame(stream, process->video_frame, options))
+            {
+                av_frame_unref(process->video_frame);
+                return RTN_ERROR;
+            }
+
+            // Below --max-loss 100 frames with concealed errors never reach an image
+            if (options->max_loss < 100 && is_corrupt_frame(process->video_frame))
+            {
+                av_frame_unref(process->video_frame);
+                continue;
+            }
+
+            if (_crop_frame(stream, process->video_frame))
+            {
+                write_msg_to_fd(STDERR_FILENO,
+                                "(f) _read_frame | " ERROR_FAILED_TO_CROP_FRAME "\n");
+                av_frame_unref(process->video_frame);
+                continue;
+            }
+
+            short accumulate = process->received_frames < stream->number_of_frames_to_read;
+            short convert = accumulate && !stream->luma_plane && !process->burst_frames;
+            if ((convert || (process->shm_ring && options->shm_format == SHM_FORMAT_RGB)) &&
+                scale_frame(stream->sws_context, process->image_frame, process->video_frame))
+            {
+                av_frame_unref(process->video_frame);
+                continue;
+            }
+
+            stream->processed_frame = 1;
+            if (process->shm_ring)
+                _publish_frame(process, options);
 
-            for (size_t i = 0; process->image_frame->data[0] && i < process->image_size; ++i)
-                process->sum_buffer[i] += (unsigned long long)process->image_frame->data[0][i];
+            if (!accumulate)
+            {
+                av_frame_unref(process->video_frame);
+                continue;
+            }
 
+            if (process->burst_frames)
+            {
+                if (_keep_burst_frame(stream, process))
+                {
+                    av_frame_unref(process->video_frame);
+                    continue;
+                }
+            }
+            else if (process->best_frame)
+                _keep_best_frame(stream, process, options);
+            else
+                _accumulate_frame(stream, process, _measure_frame_time(stream, process, options));
             process->received_frames++;
 
+            if (options->exposure_end == EXPOSURE_END_PTS)
+                _end_exposure_at_pts(stream, process, options);
+            else if (options->stack_mode == STACK_MODE_KEYFRAMES)
+                _refine_keyframe_count(stream, process, options);
+
             if (options->debug)
             {
                 printf(ANSI_BLUE "Debug:" ANSI_RESET " Processed frame %06llu/%06u [%06d bytes]\n",
                        process->received_frames, stream->number_of_frames_to_read,
                        process->av_packet->size);
 
-                if (options->debug_step &&
+                if (options->debug_step && !process->burst_frames && !process->best_frame &&
                     (process->received_frames == 1 ||
                      process->received_frames % options->debug_step == 0 ||
                      process->received_frames == stream->number_of_frames_to_read))
-                    _save_debug_frame(process, options);
+                    _save_debug_frame(stream, process, options);
             }
 
             av_frame_unref(process->video_frame);
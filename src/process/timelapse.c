@@ -0,0 +1,363 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | timelapse.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "process.h"
+#include "stream.h"
+#include "utilities.h"
+#include "workers.h"
+
+/* One captured snapshot handed to the encode/write worker (--pipeline) */
+typedef struct _snapshot_job_s
+{
+    const options_t* options;     // Options with the output path templates (read-only).
+    image_t* raw_image;           // Unscaled raw image, owned by the job.
+    unsigned long long sequence;  // Sequence number of the snapshot.
+    time_t when;                  // Capture time of the snapshot.
+    atomic_ullong* failed;        // Counter of snapshots that could not be written.
+} _snapshot_job_t;
+
+process_t* _init_process(const stream_t* stream, const options_t* options);
+image_t* _init_raw_image(const process_t* process, const stream_t* stream,
+                         const options_t* options);
+short _calculate_limits(stream_t* stream, const options_t* options);
+short _check_process_status(const process_t* process, const stream_t* stream);
+short _read_frame(stream_t* stream, process_t* process, const options_t* options);
+short _scale_image(image_t* raw_image, const options_t* options);
+
+/**
+ * @brief Keeps reading and decoding the stream until the next snapshot is due.
+ *
+ * Frames decoded while waiting are dropped (the process has already received every frame of
+ * the previous snapshot), but the socket is drained and the decoder stays in sync, so the
+ * next snapshot starts without reconnecting or waiting for an I-frame.
+ *
+ * @param stream      Pointer to the open stream.
+ * @param process     Pointer to the process whose buffers are reused for every snapshot.
+ * @param options     Pointer to the options_t structure.
+ * @param capture_at  Time of the next snapshot in microseconds.
+ *
+ * @return 0 when the snapshot is due (or a stop was requested), -1 if the stream failed.
+ */
+static short _wait_for_capture(stream_t* stream, process_t* process, const options_t* options,
+                               long long capture_at)
+{
+    while (monotonic_time_in_microseconds() < capture_at && !stop_requested())
+        if (_read_frame(stream, process, options))
+            return RTN_ERROR;
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Captures one snapshot (or exposure) with the buffers of an already running process.
+ *
+ * @param stream   Pointer to the open stream.
+ * @param process  Pointer to the process; its sums are cleared before the capture.
+ * @param options  Pointer to the options_t structure.
+ *
+ * @return Pointer to the unscaled raw image, or NULL on failure or when a stop was requested
+ *         before the capture completed.
+ */
+static image_t* _capture_snapshot(stream_t* stream, process_t* process, const options_t* options)
+{
+    if (process->sum_buffer)
+        memset(process->sum_buffer, 0, process->image_size * sizeof(unsigned long long));
+    process->best_score = -1;
+    process->last_pts = AV_NOPTS_VALUE;
+    process->covered_duration = 0;
+    process->sum_weight = 0;
+    process->received_frames = 0;
+
+    if (_calculate_limits(stream, options))
+        return NULL;
+
+    while (process->received_frames < stream->number_of_frames_to_read &&
+           monotonic_time_in_microseconds() < stream->stop_reading_at && !stop_requested() &&
+           !_read_frame(stream, process, options));
+
+    if (stop_requested() && process->received_frames < stream->number_of_frames_to_read)
+        return NULL;
+
+    if (_check_process_status(process, stream))
+        return NULL;
+
+    image_t* raw_image = _init_raw_image(process, stream, options);
+    if (!raw_image)
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _capture_snapshot | " ERROR_FAILED_TO_INIT_RAW_IMAGE "\n");
+
+    return raw_image;
+}
+
+/**
+ * @brief Scales one timelapse snapshot and writes it to the templated output paths.
+ *
+ * The output file path and the paths of the output variants are expanded with
+ * get_sequence_path() into a shallow copy of the options; file descriptors receive every
+ * snapshot one after another.
+ *
+ * @param options    Pointer to the options_t structure with the path templates.
+ * @param raw_image  Pointer to the unscaled raw image of the snapshot.
+ * @param sequence   Sequence number of the snapshot, starting at 1.
+ * @param when       Capture time of the snapshot.
+ *
+ * @return 0 if every destination was written, or -1 on failure.
+ */
+static short _finish_snapshot(const options_t* options, image_t* raw_image,
+                              unsigned long long sequence, time_t when)
+{
+    if (!options->outputs_count && _scale_image(raw_image, options))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _finish_snapshot | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        return RTN_ERROR;
+    }
+
+    options_t snapshot = *options;
+    output_variant_t variants[MAX_OUTPUT_VARIANTS];
+    short result = RTN_SUCCESS;
+
+    snapshot.output_file_path = NULL;
+    snapshot.outputs = variants;
+    for (int i = 0; i < options->outputs_count; ++i)
+    {
+        variants[i] = options->outputs[i];
+        variants[i].path = NULL;
+    }
+
+    if (options->output_file_path &&
+        !(snapshot.output_file_path = get_sequence_path(options->output_file_path, sequence, when)))
+        result = RTN_ERROR;
+
+    for (int i = 0; i < options->outputs_count; ++i)
+        if (options->outputs[i].path &&
+            !(variants[i].path = get_sequence_path(options->outputs[i].path, sequence, when)))
+            result = RTN_ERROR;
+
+    if (!result)
+        result = write_outputs(&snapshot, raw_image);
+
+    free(snapshot.output_file_path);
+    for (int i = 0; i < options->outputs_count; ++i) free(variants[i].path);
+
+    return result;
+}
+
+/* Worker task: scales, encodes and writes one snapshot, then releases it */
+static void _run_snapshot_job(void* arg)
+{
+    _snapshot_job_t* job = (_snapshot_job_t*)arg;
+
+    if (_finish_snapshot(job->options, job->raw_image, job->sequence, job->when))
+        atomic_fetch_add(job->failed, 1);
+
+    free_image(job->raw_image);
+    free(job);
+}
+
+/**
+ * @brief Hands a snapshot to the encode/write worker without ever blocking the capture loop.
+ *
+ * When the bounded queue is full the snapshot is dropped, so demuxing and decoding keep pace
+ * with the stream even if encoding or the output cannot.
+ *
+ * @param pool       Pointer to the single-threaded encode/write pool.
+ * @param group      Pointer to the group the snapshots are accounted in.
+ * @param job        Snapshot job template (copied; the raw image is taken over).
+ * @param dropped    Pointer to the counter of dropped snapshots.
+ * @param max_depth  Pointer to the deepest queue length seen so far.
+ * @param options    Pointer to the options_t structure containing debug settings.
+ */
+static void _queue_snapshot(worker_pool_t* pool, worker_group_t* group,
+                            const _snapshot_job_t* job, unsigned long long* dropped,
+                            int* max_depth, const options_t* options)
+{
+    _snapshot_job_t* queued = (_snapshot_job_t*)malloc(sizeof(_snapshot_job_t));
+    short result = queued ? RTN_SUCCESS : RTN_ERROR;
+    if (queued)
+    {
+        *queued = *job;
+        result = try_submit_worker_task(pool, group, _run_snapshot_job, queued);
+    }
+
+    if (result == RTN_SUCCESS)
+    {
+        int depth = get_worker_queue_length(pool);
+        if (depth > *max_depth)
+            *max_depth = depth;
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Snapshot %06llu queued, queue depth %d/%d\n",
+                   job->sequence, depth, options->pipeline_depth);
+        return;
+    }
+
+    if (result == WORKER_QUEUE_FULL)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _queue_snapshot | " ERROR_SNAPSHOT_DROPPED "\n");
+        (*dropped)++;
+    }
+    else
+        atomic_fetch_add(job->failed, 1);
+
+    free_image(job->raw_image);
+    free(queued);
+}
+
+/**
+ * @brief Runs a timelapse: one snapshot every options->interval_sec seconds from one session.
+ *
+ * The stream is opened once and the process buffers are allocated once; between snapshots
+ * the stream keeps being read so that no reconnect or I-frame wait is paid per snapshot.
+ * Snapshots follow a fixed cadence; a snapshot that overruns the interval delays the next
+ * one instead of queueing more. The run ends after options->count snapshots, or on
+ * SIGINT/SIGTERM when the count is 0. A snapshot that cannot be written is reported and the
+ * run continues; a stream failure ends it.
+ *
+ * With --pipeline, finished snapshots are scaled, encoded and written on a worker thread fed
+ * from a queue of options->pipeline_depth snapshots, so the capture loop goes straight back
+ * to reading the stream. Snapshots that find the queue full are dropped and reported.
+ *
+ * @param options  Pointer to the options_t structure containing configuration options.
+ *
+ * @return 0 if every snapshot was captured and written, or -1 on failure.
+ */
+short run_timelapse(options_t* options)
+{
+    if (!options || options->interval_sec <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) run_timelapse | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    worker_pool_t* pool = NULL;
+    worker_group_t group;
+    stream_t* stream = NULL;
+    process_t* process = NULL;
+
+    if (options->pipeline_depth)
+    {
+        pool = create_worker_pool(1, options->pipeline_depth);
+        if (!pool)
+            return RTN_ERROR;
+        if (init_worker_group(&group))
+        {
+            free_worker_pool(pool);
+            return RTN_ERROR;
+        }
+    }
+
+    short result = RTN_SUCCESS;
+    atomic_ullong failed = 0;
+    unsigned long long captured = 0, dropped = 0;
+    int max_depth = 0;
+
+    stream = get_stream(options);
+    process = stream ? _init_process(stream, options) : NULL;
+    if (!process)
+    {
+        result = RTN_ERROR;
+        goto end;
+    }
+
+    long long interval_us = (long long)options->interval_sec * 1000000;
+    long long capture_at = monotonic_time_in_microseconds();
+
+    for (unsigned long long sequence = 1;
+         (!options->count || sequence <= (unsigned long long)options->count) && !stop_requested();
+         ++sequence)
+    {
+        if (_wait_for_capture(stream, process, options, capture_at))
+        {
+            result = RTN_ERROR;
+            break;
+        }
+
+        time_t when = time(NULL);
+        image_t* raw_image = stop_requested() ? NULL : _capture_snapshot(stream, process, options);
+        if (!raw_image)
+        {
+            if (!stop_requested())
+                result = RTN_ERROR;
+            break;
+        }
+
+        captured++;
+        if (pool)
+        {
+            _snapshot_job_t job = {.options = options,
+                                   .raw_image = raw_image,
+                                   .sequence = sequence,
+                                   .when = when,
+                                   .failed = &failed};
+            _queue_snapshot(pool, &group, &job, &dropped, &max_depth, options);
+        }
+        else
+        {
+            if (_finish_snapshot(options, raw_image, sequence, when))
+                atomic_fetch_add(&failed, 1);
+            free_image(raw_image);
+        }
+
+        capture_at += interval_us;
+        long long now = monotonic_time_in_microseconds();
+        if (capture_at < now)
+        {
+            if (options->debug)
+                printf(ANSI_BLUE "Debug:" ANSI_RESET
+                                 " Snapshot %06llu overran the interval by %.3f s\n",
+                       sequence, (now - capture_at) / 1e6);
+            capture_at = now;
+        }
+        else if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Snapshot %06llu done, next in %.3f s\n",
+                   sequence, (capture_at - now) / 1e6);
+    }
+
+end:
+    if (pool)
+    {
+        wait_worker_group(&group);
+        destroy_worker_group(&group);
+        free_worker_pool(pool);
+    }
+
+    unsigned long long failed_count = atomic_load(&failed);
+    if (failed_count)
+        result = RTN_ERROR;
+
+    if (options->debug)
+    {
+        printf(ANSI_BLUE "Debug:" ANSI_RESET
+                         " Timelapse finished: %llu snapshots written, %llu failed, %llu dropped\n",
+               captured - failed_count - dropped, failed_count, dropped);
+        if (options->pipeline_depth)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Pipeline queue: max depth %d/%d\n", max_depth,
+                   options->pipeline_depth);
+        print_transport_stats(stream);
+    }
+
+    free_process(process);
+    free_stream(stream);
+    return result;
+}
@@ -0,0 +1,326 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | shm_ring.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libswscale/swscale.h"
+#include "publish.h"
+#include "utilities.h"
+
+/* Rounds size up to the next multiple of SHM_RING_ALIGNMENT. */
+static size_t _align_up(size_t size)
+{
+    return (size + SHM_RING_ALIGNMENT - 1) & ~((size_t)SHM_RING_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Calculates the size of one frame in the given shared-memory pixel layout.
+ *
+ * @param format  Pixel layout of the published frames.
+ * @param width   Frame width in pixels.
+ * @param height  Frame height in pixels.
+ *
+ * @return Frame size in bytes, or 0 for an unknown layout.
+ */
+static size_t _frame_size(shm_format_t format, int width, int height)
+{
+    size_t luma = (size_t)width * (size_t)height;
+    size_t chroma = (size_t)((width + 1) / 2) * (size_t)((height + 1) / 2);
+
+    switch (format)
+    {
+        case SHM_FORMAT_RGB:
+            return luma * 3;
+        case SHM_FORMAT_YUV:
+            return luma + 2 * chroma;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Returns a pointer to the slot that holds the frame with the given index.
+ */
+static shm_ring_slot_t* _get_slot(const shm_ring_t* ring, uint64_t frame_index)
+{
+    const shm_ring_header_t* header = ring->header;
+    return (shm_ring_slot_t*)(ring->base + header->slots_offset +
+                              (frame_index % header->slot_count) * header->slot_stride);
+}
+
+/**
+ * @brief Copies a decoded frame into a slot as tightly packed I420 planes.
+ *
+ * YUV420P/YUVJ420P frames are copied plane by plane. Any other decoder output is converted
+ * by swscale straight into the slot, so no intermediate buffer is needed.
+ *
+ * @param ring         Pointer to the shared-memory ring.
+ * @param video_frame  Decoded frame to copy.
+ * @param data         Destination pixel data inside the slot.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static short _copy_yuv_frame(shm_ring_t* ring, const AVFrame* video_frame, uint8_t* data)
+{
+    int width = (int)ring->header->width;
+    int height = (int)ring->header->height;
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+
+    uint8_t* planes[3] = {data, data + (size_t)width * height,
+                          data + (size_t)width * height + (size_t)chroma_width * chroma_height};
+    int strides[3] = {width, chroma_width, chroma_width};
+
+    if (video_frame->format == AV_PIX_FMT_YUV420P || video_frame->format == AV_PIX_FMT_YUVJ420P)
+    {
+        for (int plane = 0; plane < 3; ++plane)
+        {
+            int rows = plane ? chroma_height : height;
+            for (int y = 0; y < rows; ++y)
+                memcpy(planes[plane] + (size_t)y * strides[plane],
+                       video_frame->data[plane] + (size_t)y * video_frame->linesize[plane],
+                       (size_t)strides[plane]);
+        }
+
+        return RTN_SUCCESS;
+    }
+
+    ring->yuv_context = sws_getCachedContext(ring->yuv_context, width, height, video_frame->format,
+                                             width, height, AV_PIX_FMT_YUV420P, SWS_FAST_BILINEAR,
+                                             NULL, NULL, NULL);
+    if (!ring->yuv_context)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _copy_yuv_frame | " ERROR_FAILED_TO_CREATE_SWS_CONTEXT "\n");
+        return RTN_ERROR;
+    }
+
+    if (sws_scale(ring->yuv_context, (const uint8_t* const*)video_frame->data,
+                  video_frame->linesize, 0, height, planes, strides) != height)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _copy_yuv_frame | " ERROR_FAILED_TO_SCALE_IMAGE "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Creates (or re-creates) a shared-memory ring for publishing decoded frames.
+ *
+ * The POSIX shared-memory object named by options->shm_name is sized for options->shm_slots
+ * frames of the given dimensions, mapped, and its header is initialized. An existing object
+ * of the same name is unlinked first, so readers attached to a previous ring keep their
+ * mapping, and the new one is created exclusively (a concurrent writer makes the call fail).
+ * The magic number is written last, so readers that attach early never see a partially
+ * initialized header.
+ *
+ * @param options    Pointer to the options_t structure with the ring name, slots and format.
+ * @param width      Frame width in pixels.
+ * @param height     Frame height in pixels.
+ * @param time_base  Time base of the pts values stored in the slots.
+ *
+ * @return Pointer to the opened ring, or NULL on failure.
+ */
+shm_ring_t* open_shm_ring(const options_t* options, int width, int height, AVRational time_base)
+{
+    if (!options || !options->shm_name || width <= 0 || height <= 0 ||
+        options->shm_slots < MIN_SHM_SLOTS || options->shm_slots > MAX_SHM_SLOTS)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    size_t frame_size = _frame_size(options->shm_format, width, height);
+    if (!frame_size)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_INVALID_SHM_FORMAT "\n");
+        return NULL;
+    }
+
+    shm_ring_t* ring = (shm_ring_t*)malloc(sizeof(shm_ring_t));
+    if (!ring)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return NULL;
+    }
+
+    ring->name = NULL;
+    ring->fd = -1;
+    ring->base = MAP_FAILED;
+    ring->mapped_size = 0;
+    ring->header = NULL;
+    ring->yuv_context = NULL;
+    ring->published = 0;
+
+    ring->name = strdup(options->shm_name);
+    if (!ring->name)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        goto error;
+    }
+
+    size_t data_offset = _align_up(sizeof(shm_ring_slot_t));
+    size_t slot_stride = _align_up(data_offset + frame_size);
+    size_t slots_offset = _align_up(sizeof(shm_ring_header_t));
+    ring->mapped_size = slots_offset + slot_stride * (size_t)options->shm_slots;
+
+    // Never resize a ring that readers may still have mapped: shrinking it under them raises
+    // SIGBUS. Unlinking leaves their mappings intact and the ring is created afresh.
+    shm_unlink(ring->name);
+    ring->fd = shm_open(ring->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (ring->fd < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_FAILED_TO_OPEN_SHM "\n");
+        goto error;
+    }
+
+    if (ftruncate(ring->fd, (off_t)ring->mapped_size))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_FAILED_TO_OPEN_SHM "\n");
+        goto error;
+    }
+
+    ring->base = (uint8_t*)mmap(NULL, ring->mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                                ring->fd, 0);
+    if (ring->base == MAP_FAILED)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) open_shm_ring | " ERROR_FAILED_TO_MAP_SHM "\n");
+        goto error;
+    }
+
+    memset(ring->base, 0, slots_offset + data_offset);
+    for (int i = 1; i < options->shm_slots; ++i)
+        memset(ring->base + slots_offset + (size_t)i * slot_stride, 0, data_offset);
+
+    ring->header = (shm_ring_header_t*)ring->base;
+    ring->header->version = SHM_RING_VERSION;
+    ring->header->slot_count = (uint32_t)options->shm_slots;
+    ring->header->pixel_format = (uint32_t)options->shm_format;
+    ring->header->width = (uint32_t)width;
+    ring->header->height = (uint32_t)height;
+    ring->header->time_base_num = time_base.num;
+    ring->header->time_base_den = time_base.den;
+    ring->header->frame_size = frame_size;
+    ring->header->slots_offset = slots_offset;
+    ring->header->slot_stride = slot_stride;
+    ring->header->data_offset = data_offset;
+    atomic_store_explicit(&ring->header->frames_published, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    ring->header->magic = SHM_RING_MAGIC;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET
+                         " Opened shared-memory ring %s: %d slots of %zu bytes (%s %dx%d)\n",
+               ring->name, options->shm_slots, frame_size,
+               shm_format_to_string(options->shm_format), width, height);
+
+    return ring;
+
+error:
+    close_shm_ring(ring);
+    return NULL;
+}
+
+/**
+ * @brief Publishes a frame into the next slot of the shared-memory ring.
+ *
+ * The slot's seqlock is held (odd sequence) only for the duration of the copy, readers that
+ * race with the writer detect the changed sequence and retry. No locks or syscalls are involved
+ * on either side.
+ *
+ * @param ring         Pointer to the shared-memory ring.
+ * @param video_frame  Decoded frame (source of pts and, for the YUV layout, of pixel data).
+ * @param rgb_data     Packed RGB24 frame data, required for the RGB layout.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short publish_frame(shm_ring_t* ring, const AVFrame* video_frame, const uint8_t* rgb_data)
+{
+    if (!ring || !ring->header || !video_frame ||
+        (ring->header->pixel_format == SHM_FORMAT_RGB && !rgb_data))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) publish_frame | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    shm_ring_header_t* header = ring->header;
+    uint64_t frame_index = ring->published;
+    shm_ring_slot_t* slot = _get_slot(ring, frame_index);
+    uint8_t* data = (uint8_t*)slot + header->data_offset;
+
+    uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    short status = RTN_SUCCESS;
+    if (header->pixel_format == SHM_FORMAT_RGB)
+        memcpy(data, rgb_data, header->frame_size);
+    else
+        status = _copy_yuv_frame(ring, video_frame, data);
+
+    slot->frame_index = frame_index;
+    slot->pts = video_frame->best_effort_timestamp;
+    slot->width = header->width;
+    slot->height = header->height;
+    slot->size = status == RTN_SUCCESS ? header->frame_size : 0;
+
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+    if (status != RTN_SUCCESS)
+        return RTN_ERROR;
+
+    atomic_store_explicit(&header->frames_published, frame_index + 1, memory_order_release);
+    ring->published++;
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Unmaps and removes the shared-memory ring and frees the ring structure.
+ *
+ * Readers that already mapped the ring keep their mapping; the name is unlinked so that new
+ * readers do not attach to frames that are no longer updated.
+ *
+ * @param ring Pointer to the shared-memory ring. If NULL, the function does nothing.
+ */
+void close_shm_ring(shm_ring_t* ring)
+{
+    if (!ring)
+        return;
+
+    if (ring->base != MAP_FAILED)
+        munmap(ring->base, ring->mapped_size);
+    if (ring->fd >= 0)
+    {
+        close(ring->fd);
+        shm_unlink(ring->name);
+    }
+    if (ring->yuv_context)
+        sws_freeContext(ring->yuv_context);
+    if (ring->name)
+        free(ring->name);
+
+    free(ring);
+    ring = NULL;
+}
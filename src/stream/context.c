@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | context.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-19
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -17,6 +17,8 @@
 #include <unistd.h>
 
 #include "errors.h"
+#include "libavutil/pixdesc.h"
+#include "scaler.h"
 #include "stream.h"
 #include "utilities.h"
 
@@ -78,6 +80,10 @@ short _init_codec_context(stream_t* stream, const options_t* options)
         goto error;
     }
 
+    // Keyframe stacking never needs the frames in between, so the decoder skips them outright
+    if (options->stack_mode == STACK_MODE_KEYFRAMES)
+        stream->codec_context->skip_frame = AVDISCARD_NONKEY;
+
     if (avcodec_open2(stream->codec_context, codec, NULL) < 0)
     {
         write_msg_to_fd(STDERR_FILENO,
@@ -100,11 +106,37 @@ error:
     return RTN_ERROR;
 }
 
+/**
+ * @brief Tells whether the first plane of a pixel format holds 8-bit luma samples one byte apart.
+ *
+ * Such frames (YUV 4:2:0, 4:2:2, 4:4:4, NV12, GRAY8...) can be averaged for --gray straight
+ * from the decoded Y plane, without any conversion.
+ *
+ * @param format  Pixel format of the decoded frames.
+ *
+ * @return 1 if the Y plane can be read directly, otherwise 0.
+ */
+static short _has_luma_plane(enum AVPixelFormat format)
+{
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+    if (!desc || desc->nb_components < 1 ||
+        (desc->flags & (AV_PIX_FMT_FLAG_RGB | AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_HWACCEL)))
+        return 0;
+
+    const AVComponentDescriptor* luma = &desc->comp[0];
+    return luma->plane == 0 && luma->step == 1 && luma->offset == 0 && luma->shift == 0 &&
+           luma->depth == 8;
+}
+
 /**
  * @brief Initializes the SwsContext for scaling and converting pixel formats.
  *
- * This function sets up the SwsContext for converting the video stream's pixel format
- * to RGB24 format.
+ * This function sets up the SwsContext for converting the processed region of the
+ * video stream from its pixel format to RGB24 format, on `--scale-threads` slice threads.
+ * With --gray the target is GRAY8, and no context is needed at all when the decoded
+ * frames already carry an 8-bit luma plane (stream->luma_plane is set instead, and limited
+ * range luma is expanded to full range on the way out of the frame, as swscale does).
+ * The context comes from the shared SwsContext cache and is released by free_stream().
  *
  * @param stream       Pointer to the stream_t structure containing stream information.
  * @param options      Pointer to the options_t structure containing configuration options.
@@ -135,9 +167,25 @@ short _init_sws_context(stream_t* stream, const options_t* options)
         return RTN_ERROR;
     }
 
-    stream->sws_context =
-        sws_getContext(codecpar->width, codecpar->height, codecpar->format, codecpar->width,
-                       codecpar->height, AV_PIX_FMT_RGB24, SWS_FAST_BILINEAR, NULL, NULL, NULL);
+    if (options->gray && _has_luma_plane(codecpar->format))
+    {
+        stream->luma_plane = 1;
+        init_luma_range(stream);
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Reading luma plane of video stream index: %d\n",
+                   stream->video_stream_index);
+        return RTN_SUCCESS;
+    }
+
+    sws_key_t key = {.src_width = stream->region.width,
+                     .src_height = stream->region.height,
+                     .src_format = codecpar->format,
+                     .dst_width = stream->region.width,
+                     .dst_height = stream->region.height,
+                     .dst_format = options->gray ? AV_PIX_FMT_GRAY8 : AV_PIX_FMT_RGB24,
+                     .flags = SWS_FAST_BILINEAR,
+                     .threads = options->scale_threads};
+    stream->sws_context = acquire_sws_context(&key);
 
     if (!stream->sws_context)
     {
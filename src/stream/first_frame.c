@@ -0,0 +1,213 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | first_frame.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libavutil/pixdesc.h"
+#include "stream.h"
+#include "utilities.h"
+
+/* Frees the primed packets that have not been replayed yet */
+void free_primed_packets(stream_t* stream)
+{
+    if (!stream || !stream->primed_packets)
+        return;
+
+    for (int i = stream->primed_next; i < stream->primed_count; ++i)
+        av_packet_free(&stream->primed_packets[i]);
+
+    free(stream->primed_packets);
+    stream->primed_packets = NULL;
+    stream->primed_count = 0;
+    stream->primed_next = 0;
+}
+
+/* Drops the packets kept so far, a newer keyframe starts the decode over */
+static void _drop_primed_packets(stream_t* stream)
+{
+    for (int i = 0; i < stream->primed_count; ++i)
+        av_packet_free(&stream->primed_packets[i]);
+    stream->primed_count = 0;
+}
+
+/**
+ * @brief Keeps a copy of a video packet read while priming and sends it to the decoder.
+ *
+ * @return 1 once the decoder returned a frame, 0 if it needs more packets, -1 on failure.
+ */
+static short _prime_with_packet(stream_t* stream, const AVPacket* packet, AVFrame* frame)
+{
+    if (stream->primed_count == MAX_PRIMED_PACKETS)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _prime_with_packet | " ERROR_NO_FIRST_FRAME "\n");
+        return RTN_ERROR;
+    }
+
+    AVPacket* kept = av_packet_clone(packet);
+    if (!kept)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _prime_with_packet | " ERROR_FAILED_TO_ALLOCATE_PACKET "\n");
+        return RTN_ERROR;
+    }
+    stream->primed_packets[stream->primed_count++] = kept;
+
+    if (avcodec_send_packet(stream->codec_context, kept) < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _prime_with_packet | " ERROR_FAILED_TO_SEND_PACKET "\n");
+        return RTN_ERROR;
+    }
+
+    int ret = avcodec_receive_frame(stream->codec_context, frame);
+    if (ret >= 0)
+    {
+        av_frame_unref(frame);
+        return 1;
+    }
+
+    if (ret != AVERROR(EAGAIN))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _prime_with_packet | " ERROR_FAILED_TO_RECEIVE_FRAME "\n");
+        return RTN_ERROR;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Learns the frame size and pixel format of the video stream from its first frame.
+ *
+ * With --fast-start, stream info probing is skipped as soon as the SDP carries the codec
+ * extradata (e.g. sprop-parameter-sets), but RTSP never describes the frame size or pixel
+ * format, which the region, the scaler and the process buffers are sized from. They are
+ * taken from the first frame the decoder returns instead: packets are decoded from the
+ * first keyframe on, kept, and replayed by read_stream_packet() once the decoder has been
+ * flushed, so the capture still starts at that keyframe. Nothing is read when the size and
+ * format are already known (stream info probing or --profile-cache).
+ *
+ * @param stream   Pointer to the stream_t structure with an opened codec context.
+ * @param options  Pointer to the options_t structure containing debug settings.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short _prime_stream_format(stream_t* stream, const options_t* options)
+{
+    if (!stream || !options || !stream->format_context || !stream->codec_context)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _prime_stream_format | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    AVCodecContext* codec_context = stream->codec_context;
+    if (codec_context->width > 0 && codec_context->height > 0 &&
+        codec_context->pix_fmt != AV_PIX_FMT_NONE)
+        return RTN_SUCCESS;
+
+    stream->primed_packets = (AVPacket**)calloc(MAX_PRIMED_PACKETS, sizeof(AVPacket*));
+    AVPacket* packet = av_packet_alloc();
+    AVFrame* frame = av_frame_alloc();
+    if (!stream->primed_packets || !packet || !frame)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) _prime_stream_format | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        goto end;
+    }
+
+    set_deadline_stage("I-frame wait");
+    long long give_up_at =
+        monotonic_time_in_microseconds() + (long long)FIRST_FRAME_TIMEOUT_SEC * 1000000;
+    short primed = 0;
+
+    while (!primed && monotonic_time_in_microseconds() < give_up_at && !stop_requested())
+    {
+        if (av_read_frame(stream->format_context, packet) < 0)
+        {
+            if (!stream_race_lost(stream))
+                write_msg_to_fd(STDERR_FILENO,
+                                "(f) _prime_stream_format | " ERROR_FAILED_TO_READ_FRAME "\n");
+            break;
+        }
+
+        // Decoding starts at a keyframe, the packets before the first one are useless
+        if (packet->stream_index == stream->video_stream_index &&
+            ((packet->flags & AV_PKT_FLAG_KEY) || stream->primed_count))
+        {
+            if (packet->flags & AV_PKT_FLAG_KEY)
+                _drop_primed_packets(stream);
+            primed = _prime_with_packet(stream, packet, frame);
+        }
+
+        av_packet_unref(packet);
+        if (primed < 0)
+            break;
+    }
+
+    if (primed > 0)
+    {
+        AVCodecParameters* codecpar =
+            stream->format_context->streams[stream->video_stream_index]->codecpar;
+        codecpar->width = codec_context->width;
+        codecpar->height = codec_context->height;
+        codecpar->format = codec_context->pix_fmt;
+        avcodec_flush_buffers(codec_context);
+
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET
+                             " Learned %dx%d %s from the first frame, replaying %d packets.\n",
+                   codecpar->width, codecpar->height, av_get_pix_fmt_name(codecpar->format),
+                   stream->primed_count);
+    }
+    else if (primed == 0 && !stream_race_lost(stream))
+        write_msg_to_fd(STDERR_FILENO, "(f) _prime_stream_format | " ERROR_NO_FIRST_FRAME "\n");
+
+end:
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    if (codec_context->width <= 0 || codec_context->pix_fmt == AV_PIX_FMT_NONE)
+    {
+        free_primed_packets(stream);
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Reads the next packet of the stream, replaying the packets kept while priming first.
+ *
+ * @param stream  Pointer to the stream_t structure.
+ * @param packet  Pointer to the packet to fill (see av_read_frame()).
+ *
+ * @return 0 on success, a negative AVERROR code on failure.
+ */
+int read_stream_packet(stream_t* stream, AVPacket* packet)
+{
+    if (stream->primed_next < stream->primed_count)
+    {
+        av_packet_move_ref(packet, stream->primed_packets[stream->primed_next]);
+        av_packet_free(&stream->primed_packets[stream->primed_next++]);
+        if (stream->primed_next == stream->primed_count)
+            free_primed_packets(stream);
+        return 0;
+    }
+
+    return av_read_frame(stream->format_context, packet);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | input_profiles.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "stream.h"
+#include "utilities.h"
+
+float _get_scale_factor(int src_width, int src_height, const options_t* options);
+
+/* Widens the needed source size to what options ask of a frame of the largest profile */
+static void _grow_needed_size(const input_profile_t* largest, const options_t* options,
+                              double* width, double* height)
+{
+    double crop_width = options->crop.width ? options->crop.width : 1.0;
+    double crop_height = options->crop.height ? options->crop.height : 1.0;
+    int region_width = (int)(largest->width * crop_width + 0.5);
+    int region_height = (int)(largest->height * crop_height + 0.5);
+    if (region_width <= 0 || region_height <= 0)
+        return;
+
+    double scale = _get_scale_factor(region_width, region_height, options);
+    if (largest->width * scale > *width)
+        *width = largest->width * scale;
+    if (largest->height * scale > *height)
+        *height = largest->height * scale;
+}
+
+/**
+ * @brief Picks the smallest input profile that serves every requested output without upscaling.
+ *
+ * The outputs are sized on the largest profile, as _get_scale_factor() would size them, for the
+ * main output and every output variant. The smallest profile at least that large then gives the
+ * same images for a fraction of the decode and conversion cost. An output that upscales even the
+ * largest profile, or a --publish-shm ring, keeps the largest one.
+ *
+ * @param options  Pointer to the options_t structure with the profiles and requested outputs.
+ *
+ * @return The chosen profile, or NULL if there are no profiles.
+ */
+const input_profile_t* pick_input_profile(const options_t* options)
+{
+    if (!options || !options->inputs || options->inputs_count <= 0)
+        return NULL;
+
+    const input_profile_t* largest = &options->inputs[0];
+    for (int i = 1; i < options->inputs_count; ++i)
+        if ((long long)options->inputs[i].width * options->inputs[i].height >
+            (long long)largest->width * largest->height)
+            largest = &options->inputs[i];
+
+    // Shared memory is published at the source resolution
+    if (options->shm_name)
+        return largest;
+
+    options_t output = *options;
+    output.debug = 0;
+    double width = 0, height = 0;
+    if (!options->outputs_count || options->output_file_path || options->output_file_fd >= 0)
+        _grow_needed_size(largest, &output, &width, &height);
+    for (int i = 0; i < options->outputs_count; ++i)
+    {
+        output.scale_factor = options->outputs[i].scale_factor;
+        output.resize_width = options->outputs[i].resize_width;
+        output.resize_height = options->outputs[i].resize_height;
+        _grow_needed_size(largest, &output, &width, &height);
+    }
+
+    const input_profile_t* chosen = largest;
+    for (int i = 0; i < options->inputs_count; ++i)
+    {
+        const input_profile_t* profile = &options->inputs[i];
+        if (profile->width + 0.5 >= width && profile->height + 0.5 >= height &&
+            (long long)profile->width * profile->height <
+                (long long)chosen->width * chosen->height)
+            chosen = profile;
+    }
+
+    return chosen;
+}
+
+/**
+ * @brief Points options->rtsp_url at the input profile the requested outputs need.
+ *
+ * @param options  Pointer to the options_t structure with the --input-profile list.
+ *
+ * @return 0 on success (or without profiles), -1 on failure.
+ */
+short select_input_profile(options_t* options)
+{
+    const input_profile_t* profile = pick_input_profile(options);
+    if (!profile)
+        return RTN_SUCCESS;
+
+    char* url = strdup(profile->url);
+    if (!url)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) select_input_profile | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return RTN_ERROR;
+    }
+
+    free(options->rtsp_url);
+    options->rtsp_url = url;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Selected input profile %dx%d: %s\n",
+               profile->width, profile->height, profile->url);
+
+    return RTN_SUCCESS;
+}
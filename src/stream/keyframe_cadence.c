@@ -0,0 +1,86 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | keyframe_cadence.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "stream.h"
+#include "utilities.h"
+
+/**
+ * @brief Learns the GOP duration of a stream from the PTS distance between its keyframes.
+ *
+ * Called for every decoded keyframe. The first measured interval replaces an unknown GOP and
+ * later ones are blended in with GOP_LEARNING_WEIGHT, starting from the GOP cached in the stream
+ * profile when there is one, so a single late keyframe does not swing the learned value. The
+ * GOP is written back to the profile cache and sizes the I-frame wait of later captures.
+ *
+ * @param stream   Pointer to the stream_t structure that learns the GOP.
+ * @param frame    Decoded keyframe.
+ * @param options  Pointer to the options_t structure (debug output).
+ */
+void learn_keyframe_interval(stream_t* stream, const AVFrame* frame, const options_t* options)
+{
+    if (!stream || !frame || !options || !stream->format_context)
+        return;
+
+    stream->last_keyframe_at = monotonic_time_in_microseconds();
+
+    int64_t last_pts = stream->last_keyframe_pts;
+    stream->last_keyframe_pts = frame->best_effort_timestamp;
+    if (last_pts == AV_NOPTS_VALUE || frame->best_effort_timestamp == AV_NOPTS_VALUE ||
+        frame->best_effort_timestamp <= last_pts)
+        return;
+
+    const AVStream* video_stream = stream->format_context->streams[stream->video_stream_index];
+    double interval =
+        (double)(frame->best_effort_timestamp - last_pts) * av_q2d(video_stream->time_base);
+    if (stream->keyframe_interval_sec > 0)
+        stream->keyframe_interval_sec +=
+            GOP_LEARNING_WEIGHT * (interval - stream->keyframe_interval_sec);
+    else
+        stream->keyframe_interval_sec = interval;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Keyframe interval %.3f s, learned GOP %.3f s\n",
+               interval, stream->keyframe_interval_sec);
+}
+
+/**
+ * @brief Fails a stream that stopped sending the keyframes its learned GOP promises.
+ *
+ * Once a keyframe was seen and the GOP is known, a stream that goes MAX_MISSED_KEYFRAMES GOPs
+ * (plus half a GOP of jitter) without a keyframe is considered dead, rather than holding the
+ * capture until its stop time.
+ *
+ * @param stream  Pointer to the stream_t structure being read.
+ *
+ * @return 0 while keyframes arrive on time, -1 once too many were missed.
+ */
+short check_keyframe_cadence(const stream_t* stream)
+{
+    if (!stream || stream->keyframe_interval_sec <= 0 || !stream->last_keyframe_at)
+        return RTN_SUCCESS;
+
+    double overdue_sec = (MAX_MISSED_KEYFRAMES + 0.5) * stream->keyframe_interval_sec;
+    if (monotonic_time_in_microseconds() - stream->last_keyframe_at <=
+        (long long)(overdue_sec * 1000000))
+        return RTN_SUCCESS;
+
+    write_msg_to_fd(STDERR_FILENO, "(f) check_keyframe_cadence | " ERROR_KEYFRAMES_MISSED "\n");
+    return RTN_ERROR;
+}
@@ -0,0 +1,81 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | luma_range.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <string.h>
+
+#include "stream.h"
+
+/**
+ * @brief Fills the lookup table that expands limited-range luma to full range.
+ *
+ * MPEG range luma spans 16..235; the table maps it onto 0..255 as (y - 16) * 255 / 219,
+ * rounded and clamped, which is what swscale does when it converts to full-range GRAY8.
+ *
+ * @param stream  Pointer to the stream reading its decoded luma plane (--gray).
+ */
+void init_luma_range(stream_t* stream)
+{
+    for (int y = 0; y < 256; ++y)
+    {
+        int full = ((y - LUMA_RANGE_MIN) * 255 + LUMA_RANGE_SPAN / 2) / LUMA_RANGE_SPAN;
+        if (y < LUMA_RANGE_MIN)
+            full = 0;
+        stream->luma_lut[y] = (uint8_t)(full > 255 ? 255 : full);
+    }
+}
+
+/**
+ * @brief Picks the luma range expansion a decoded frame needs.
+ *
+ * Frames flagged as full range, JPEG (yuvj) formats and GRAY8 are already full range;
+ * every other YUV frame, including an unspecified range, is taken as MPEG range.
+ *
+ * @param stream  Pointer to the stream with the lookup table.
+ * @param frame   Pointer to the decoded frame.
+ *
+ * @return The lookup table to map the luma samples with, or NULL to take them as they are.
+ */
+const uint8_t* get_luma_range_lut(const stream_t* stream, const AVFrame* frame)
+{
+    if (frame->color_range == AVCOL_RANGE_JPEG || frame->format == AV_PIX_FMT_YUVJ420P ||
+        frame->format == AV_PIX_FMT_YUVJ422P || frame->format == AV_PIX_FMT_YUVJ444P ||
+        frame->format == AV_PIX_FMT_GRAY8)
+        return NULL;
+
+    return stream->luma_lut;
+}
+
+/**
+ * @brief Copies the luma rows of the processed region out of a decoded frame at full range.
+ *
+ * @param stream    Pointer to the stream with the processed region and the lookup table.
+ * @param frame     Pointer to the decoded (and cropped) frame.
+ * @param dst       First row of the destination plane.
+ * @param linesize  Line size of the destination plane in bytes.
+ */
+void copy_luma_plane(const stream_t* stream, const AVFrame* frame, uint8_t* dst, int linesize)
+{
+    const uint8_t* lut = get_luma_range_lut(stream, frame);
+    for (int y = 0; y < stream->region.height; ++y)
+    {
+        const uint8_t* src = frame->data[0] + (ptrdiff_t)y * frame->linesize[0];
+        uint8_t* row = dst + (ptrdiff_t)y * linesize;
+        if (!lut)
+            memcpy(row, src, (size_t)stream->region.width);
+        else
+            for (int x = 0; x < stream->region.width; ++x) row[x] = lut[src[x]];
+    }
+}
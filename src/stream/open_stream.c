@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | open_stream.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-16
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -22,21 +22,46 @@
 #include "utilities.h"
 
 /**
- * @brief Detects and sets the index of the first video stream in the given stream object.
+ * @brief Finds a video track among the streams of a format context.
+ *
+ * @param format_context  Format context to search.
+ * @param track           Zero-based position of the track among the video streams (--video-track).
+ *
+ * @return Index of the stream in the format context, or -1 if there is no such video track.
+ */
+int find_video_track(const AVFormatContext* format_context, int track)
+{
+    if (!format_context || !format_context->streams)
+        return -1;
+
+    for (unsigned i = 0; i < format_context->nb_streams; ++i)
+    {
+        const AVStream* av_stream = format_context->streams[i];
+        if (av_stream && av_stream->codecpar &&
+            av_stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO && track-- == 0)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Detects and sets the index of the selected video stream in the given stream object.
  *
  * This function scans through the streams in the provided stream_t structure's format context,
- * searching for a stream of type AVMEDIA_TYPE_VIDEO. If found, it sets the video_stream_index
- * member of the stream_t structure to the index of the video stream. If no video stream is found,
- * or if the input arguments are invalid, an error message is written to STDERR and an error code
- * isreturned.
+ * searching for the `--video-track` stream of type AVMEDIA_TYPE_VIDEO (the first one by
+ * default). If found, it sets the video_stream_index member of the stream_t structure to its
+ * index. If no such video stream is found, or if the input arguments are invalid, an error
+ * message is written to STDERR and an error code is returned.
  *
- * @param stream Pointer to a stream_t structure containing the format context to search.
+ * @param stream   Pointer to a stream_t structure containing the format context to search.
+ * @param options  Pointer to the options_t structure with the video track to select.
  *
  * @return 0 if a video stream is found and its index is set; -1 otherwise.
  */
-short _detect_video_stream(stream_t* stream)
+short _detect_video_stream(stream_t* stream, const options_t* options)
 {
-    if (!stream || !stream->format_context)
+    if (!stream || !options || !stream->format_context)
     {
         write_msg_to_fd(STDERR_FILENO, "(f) _detect_video_stream | " ERROR_INVALID_ARGUMENTS "\n");
         return RTN_ERROR;
@@ -50,16 +75,7 @@ short _detect_video_stream(stream_t* stream)
         return RTN_ERROR;
     }
 
-    for (unsigned i = 0; i < stream->format_context->nb_streams; ++i)
-    {
-        if (stream->format_context->streams[i] && stream->format_context->streams[i]->codecpar &&
-            stream->format_context->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
-        {
-            stream->video_stream_index = i;
-            break;
-        }
-    }
-
+    stream->video_stream_index = find_video_track(stream->format_context, options->video_track);
     if (stream->video_stream_index == -1)
     {
         write_msg_to_fd(STDERR_FILENO,
@@ -70,13 +86,61 @@ short _detect_video_stream(stream_t* stream)
     return RTN_SUCCESS;
 }
 
+/**
+ * @brief Makes the demuxer drop the packets of every stream but the decoded video track.
+ *
+ * Other tracks are not even set up with the camera (allowed_media_types), but a camera may
+ * still advertise several video tracks, and the ones that are not decoded are never demuxed.
+ *
+ * @param stream  Pointer to the stream_t structure with the detected video stream.
+ */
+static void _discard_other_streams(stream_t* stream)
+{
+    for (unsigned i = 0; i < stream->format_context->nb_streams; ++i)
+        if ((int)i != stream->video_stream_index && stream->format_context->streams[i])
+            stream->format_context->streams[i]->discard = AVDISCARD_ALL;
+}
+
+/**
+ * @brief Tells whether the SDP already describes a video stream well enough to decode it.
+ *
+ * The codec extradata (e.g. sprop-parameter-sets) is enough: RTSP never describes the frame
+ * size or pixel format, they are learned from the first decoded frame instead
+ * (_prime_stream_format()).
+ *
+ * @param format_context  Format context of the opened stream.
+ * @param track           Video track that is decoded (--video-track).
+ *
+ * @return 1 if stream info probing can be skipped, otherwise 0.
+ */
+static short _sdp_describes_video(const AVFormatContext* format_context, int track)
+{
+    int index = find_video_track(format_context, track);
+    if (index < 0)
+        return 0;
+
+    const AVCodecParameters* codecpar = format_context->streams[index]->codecpar;
+    return codecpar->extradata_size > 0;
+}
+
+/* Aborts blocking I/O once the --deadline-ms budget ran out or another stream won the race */
+static int _interrupt_callback(void* opaque)
+{
+    return stream_race_lost(opaque) || deadline_interrupt_callback(NULL);
+}
+
 /**
  * @brief Opens an RTSP stream and initializes the stream context.
  *
  * This function attempts to open an RTSP stream using the provided options,
- * retrieves stream information, and detects the video stream index. It also
- * provides debug output if enabled in the options. In case of failure at any
- * step, it performs cleanup and returns an error code.
+ * retrieves stream information, detects the video stream index and discards all
+ * other streams. With --fast-start stream information probing is skipped when the
+ * SDP already describes the video stream, and with --profile-cache when a cached
+ * profile of the stream still matches its SDP. The format context polls the --deadline-ms
+ * budget through its interrupt callback, so a stalled connect or probe is aborted once the
+ * budget runs out. It also provides debug output if
+ * enabled in the options. In case of failure at any step, it performs cleanup and
+ * returns an error code.
  *
  * @param stream Pointer to a stream_t structure to be initialized.
  * @param options Pointer to an options_t structure containing stream options and configuration.
@@ -91,30 +155,61 @@ short _open_stream(stream_t* stream, const options_t* options)
         goto error;
     }
 
-    if (avformat_open_input(&stream->format_context, options->rtsp_url, NULL, &stream->options) < 0)
+    stream->format_context = avformat_alloc_context();
+    if (!stream->format_context)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _open_stream | " ERROR_FAILED_TO_OPEN_RTSP_STREAM "\n");
+        write_msg_to_fd(STDERR_FILENO, "(f) _open_stream | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
         goto error;
     }
 
-    if (options->debug)
-        printf(ANSI_BLUE "Debug:" ANSI_RESET " Successfully opened RTSP stream: %s\n",
-               options->rtsp_url);
+    stream->format_context->interrupt_callback.callback = _interrupt_callback;
+    stream->format_context->interrupt_callback.opaque = stream;
 
-    if (avformat_find_stream_info(stream->format_context, NULL) < 0)
+    set_deadline_stage("connect");
+    if (avformat_open_input(&stream->format_context, options->rtsp_url, NULL, &stream->options) < 0)
     {
-        write_msg_to_fd(STDERR_FILENO, "(f) _open_stream | " ERROR_FAILED_TO_GET_STREAM_INFO "\n");
+        if (!stream_race_lost(stream))
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) _open_stream | " ERROR_FAILED_TO_OPEN_RTSP_STREAM "\n");
         goto error;
     }
 
     if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Successfully opened RTSP stream: %s (%.1f ms)\n",
+               options->rtsp_url,
+               (monotonic_time_in_microseconds() - stream->opened_at) / 1000.0);
+
+    set_deadline_stage("probe");
+    if (options->fast_start && _sdp_describes_video(stream->format_context, options->video_track))
+    {
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET
+                             " Skipped stream info probing, the SDP describes the video stream.\n");
+    }
+    else if (apply_stream_profile(stream, options))
+    {
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET
+                             " Skipped stream info probing, the stream profile is cached.\n");
+    }
+    else if (avformat_find_stream_info(stream->format_context, NULL) < 0)
+    {
+        if (!stream_race_lost(stream))
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) _open_stream | " ERROR_FAILED_TO_GET_STREAM_INFO "\n");
+        goto error;
+    }
+    else if (options->debug)
         printf(ANSI_BLUE "Debug:" ANSI_RESET
-                         " Found information about %d streams in the RTSP stream.\n",
-               stream->format_context->nb_streams);
+                         " Found information about %d streams in the RTSP stream (%.1f ms).\n",
+               stream->format_context->nb_streams,
+               (monotonic_time_in_microseconds() - stream->opened_at) / 1000.0);
 
-    if (_detect_video_stream(stream) != RTN_SUCCESS)
+    if (_detect_video_stream(stream, options) != RTN_SUCCESS)
         goto error;
 
+    _discard_other_streams(stream);
+
     if (options->debug)
         printf(ANSI_BLUE "Debug:" ANSI_RESET " Detected video stream index: %d\n",
                stream->video_stream_index);
@@ -0,0 +1,371 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | profile_cache.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libavutil/pixdesc.h"
+#include "stream.h"
+#include "utilities.h"
+
+#define PROFILE_MAGIC "streamshot-profile 1"  // First line of a profile cache file.
+#define PROFILE_NAME_SIZE 32                  // Room for codec and pixel format names.
+
+/* Video stream parameters as stored in a profile cache file */
+typedef struct _profile_s
+{
+    int stream_index;                 // Index of the video stream in the format context.
+    char codec[PROFILE_NAME_SIZE];    // Decoder name (avcodec_get_name()).
+    int width;                        // Frame width in pixels.
+    int height;                       // Frame height in pixels.
+    char pix_fmt[PROFILE_NAME_SIZE];  // Pixel format name (av_get_pix_fmt_name()).
+    AVRational time_base;             // Time base of the video stream.
+    AVRational frame_rate;            // Average frame rate (0/0: unknown).
+    double gop_sec;                   // Observed GOP duration (0: not observed).
+    uint8_t* extradata;               // Codec extradata (SPS/PPS...), padded for the decoder.
+    int extradata_size;               // Size of the extradata in bytes.
+} _profile_t;
+
+/* 64-bit FNV-1a hash of a string */
+static uint64_t _fnv1a_64(const char* str)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (; *str; ++str)
+    {
+        hash ^= (unsigned char)*str;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Builds the path of the profile cache file of a stream.
+ *
+ * The file is named after the FNV-1a hash of the URL, so credentials in the URL never end up
+ * in file names, and the same camera always maps to the same file.
+ *
+ * @param dir  Profile cache directory (--profile-cache).
+ * @param url  URL of the stream.
+ *
+ * @return Newly allocated path (freed by the caller), or NULL on failure.
+ */
+char* get_stream_profile_path(const char* dir, const char* url)
+{
+    if (!dir || !url)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_stream_profile_path | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    size_t size = strlen(dir) + 32;
+    char* path = malloc(size);
+    if (!path)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) get_stream_profile_path | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return NULL;
+    }
+
+    snprintf(path, size, "%s/%016llx.profile", dir, (unsigned long long)_fnv1a_64(url));
+    return path;
+}
+
+/* Decodes a hex string into padded extradata; an empty value ("-") means no extradata */
+static short _decode_extradata(const char* hex, _profile_t* profile)
+{
+    size_t length = strcspn(hex, "\r\n");
+    if (length == 1 && hex[0] == '-')
+        return RTN_SUCCESS;
+    if (!length || length % 2)
+        return RTN_ERROR;
+
+    profile->extradata = av_mallocz(length / 2 + AV_INPUT_BUFFER_PADDING_SIZE);
+    if (!profile->extradata)
+        return RTN_ERROR;
+
+    for (size_t i = 0; i < length / 2; ++i)
+    {
+        unsigned int byte = 0;
+        if (sscanf(hex + 2 * i, "%2x", &byte) != 1)
+            return RTN_ERROR;
+        profile->extradata[i] = (uint8_t)byte;
+    }
+
+    profile->extradata_size = (int)(length / 2);
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Reads a profile cache file.
+ *
+ * @param path     Path of the profile cache file.
+ * @param profile  Profile to fill; its extradata is owned by the caller, even on failure.
+ *
+ * @return 0 if a complete profile was read, -1 if the file is missing or malformed.
+ */
+static short _read_profile(const char* path, _profile_t* profile)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return RTN_ERROR;
+
+    short result = RTN_ERROR;
+    char* line = NULL;
+    size_t line_size = 0;
+    if (getline(&line, &line_size, file) < 0 || strcmp(line, PROFILE_MAGIC "\n"))
+        goto end;
+
+    while (getline(&line, &line_size, file) > 0)
+    {
+        char* value = strchr(line, ' ');
+        if (!value)
+            goto end;
+        *value++ = '\0';
+
+        short parsed = 0;
+        if (!strcmp(line, "stream_index"))
+            parsed = sscanf(value, "%d", &profile->stream_index) == 1;
+        else if (!strcmp(line, "codec"))
+            parsed = sscanf(value, "%31s", profile->codec) == 1;
+        else if (!strcmp(line, "size"))
+            parsed = sscanf(value, "%dx%d", &profile->width, &profile->height) == 2;
+        else if (!strcmp(line, "pix_fmt"))
+            parsed = sscanf(value, "%31s", profile->pix_fmt) == 1;
+        else if (!strcmp(line, "time_base"))
+            parsed = sscanf(value, "%d/%d", &profile->time_base.num, &profile->time_base.den) == 2;
+        else if (!strcmp(line, "frame_rate"))
+            parsed =
+                sscanf(value, "%d/%d", &profile->frame_rate.num, &profile->frame_rate.den) == 2;
+        else if (!strcmp(line, "gop_sec"))
+            parsed = sscanf(value, "%lf", &profile->gop_sec) == 1;
+        else if (!strcmp(line, "extradata"))
+            parsed = _decode_extradata(value, profile) == RTN_SUCCESS;
+        else
+            parsed = 1;  // Keys of newer versions are ignored
+
+        if (!parsed)
+            goto end;
+    }
+
+    if (profile->stream_index >= 0 && profile->codec[0] && profile->width > 0 &&
+        profile->height > 0 && av_get_pix_fmt(profile->pix_fmt) != AV_PIX_FMT_NONE &&
+        profile->time_base.num > 0 && profile->time_base.den > 0)
+        result = RTN_SUCCESS;
+
+end:
+    free(line);
+    fclose(file);
+    return result;
+}
+
+/**
+ * @brief Tells whether a cached profile still describes the stream that was just opened.
+ *
+ * Everything the SDP already tells about the video stream must match the profile: the index of
+ * the selected video track, the codec, the time base, and the extradata and frame size when the
+ * SDP carries them.
+ * A camera reconfigured to another resolution or codec announces new sprop parameters, so the
+ * profile goes stale before any decoder is set up.
+ */
+static short _profile_matches_sdp(const AVFormatContext* format_context, const _profile_t* profile,
+                                  int track)
+{
+    if (profile->stream_index != find_video_track(format_context, track))
+        return 0;
+
+    const AVStream* av_stream = format_context->streams[profile->stream_index];
+    const AVCodecParameters* codecpar = av_stream->codecpar;
+    if (!codecpar || codecpar->codec_type != AVMEDIA_TYPE_VIDEO ||
+        strcmp(avcodec_get_name(codecpar->codec_id), profile->codec))
+        return 0;
+
+    if (av_stream->time_base.den && (av_stream->time_base.num != profile->time_base.num ||
+                                     av_stream->time_base.den != profile->time_base.den))
+        return 0;
+
+    if (codecpar->extradata_size > 0 &&
+        (codecpar->extradata_size != profile->extradata_size ||
+         memcmp(codecpar->extradata, profile->extradata, (size_t)profile->extradata_size)))
+        return 0;
+
+    if (codecpar->width > 0 &&
+        (codecpar->width != profile->width || codecpar->height != profile->height))
+        return 0;
+
+    return 1;
+}
+
+/**
+ * @brief Applies the cached profile of a stream instead of probing it (--profile-cache).
+ *
+ * The profile path is kept in the stream, so that free_stream() refreshes the profile after
+ * frames were decoded. A cached profile that no longer matches the SDP is deleted.
+ *
+ * @param stream   Pointer to the stream_t structure with the opened format context.
+ * @param options  Pointer to the options_t structure with the cache directory and the URL.
+ *
+ * @return 1 if the profile was applied and stream info probing can be skipped, otherwise 0.
+ */
+short apply_stream_profile(stream_t* stream, const options_t* options)
+{
+    if (!stream || !options || !stream->format_context || !options->profile_cache_dir)
+        return 0;
+
+    if (!stream->profile_path)
+        stream->profile_path = get_stream_profile_path(options->profile_cache_dir,
+                                                       options->rtsp_url);
+    if (!stream->profile_path)
+        return 0;
+
+    _profile_t profile = {.stream_index = -1};
+    if (_read_profile(stream->profile_path, &profile) != RTN_SUCCESS)
+    {
+        av_free(profile.extradata);
+        return 0;
+    }
+
+    if (!_profile_matches_sdp(stream->format_context, &profile, options->video_track))
+    {
+        av_free(profile.extradata);
+        unlink(stream->profile_path);
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Stream profile is stale, removed: %s\n",
+                   stream->profile_path);
+        return 0;
+    }
+
+    AVStream* av_stream = stream->format_context->streams[profile.stream_index];
+    AVCodecParameters* codecpar = av_stream->codecpar;
+    codecpar->width = profile.width;
+    codecpar->height = profile.height;
+    codecpar->format = av_get_pix_fmt(profile.pix_fmt);
+    if (!codecpar->extradata_size && profile.extradata_size)
+    {
+        av_freep(&codecpar->extradata);
+        codecpar->extradata = profile.extradata;
+        codecpar->extradata_size = profile.extradata_size;
+        profile.extradata = NULL;
+    }
+    av_free(profile.extradata);
+
+    if (profile.frame_rate.num > 0 && profile.frame_rate.den > 0)
+        av_stream->avg_frame_rate = profile.frame_rate;
+    if (profile.gop_sec > 0)
+        stream->keyframe_interval_sec = profile.gop_sec;
+
+    stream->profile_loaded = 1;
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Applied stream profile: %s (%s %dx%d)\n",
+               stream->profile_path, profile.codec, profile.width, profile.height);
+
+    return 1;
+}
+
+/**
+ * @brief Checks the first decoded frame of a stream opened from its cached profile.
+ *
+ * The crop region, scaler and process buffers were set up from the size and pixel format the
+ * profile put into the codec parameters, so a frame of another size or pixel format means the
+ * profile is stale: it is deleted and not written back, and the next run probes the stream
+ * again. The codec context cannot tell: the decoder updates it from the in-band SPS before it
+ * outputs the frame. This matters most for cameras that send SPS/PPS in-band only, whose SDP
+ * carries nothing a resolution change could be detected from.
+ *
+ * @param stream  Pointer to the stream_t structure opened from the profile.
+ * @param frame   First decoded frame.
+ *
+ * @return 0 if the frame matches the profile, -1 if the profile was stale.
+ */
+short check_stream_profile(stream_t* stream, const AVFrame* frame)
+{
+    if (!stream || !frame || !stream->profile_loaded || !stream->format_context ||
+        stream->video_stream_index < 0)
+        return RTN_SUCCESS;
+
+    const AVCodecParameters* codecpar =
+        stream->format_context->streams[stream->video_stream_index]->codecpar;
+    if (frame->width == codecpar->width && frame->height == codecpar->height &&
+        frame->format == codecpar->format)
+        return RTN_SUCCESS;
+
+    if (stream->profile_path)
+    {
+        unlink(stream->profile_path);
+        free(stream->profile_path);
+        stream->profile_path = NULL;
+    }
+
+    write_msg_to_fd(STDERR_FILENO,
+                    "(f) check_stream_profile | " ERROR_STREAM_PROFILE_MISMATCH "\n");
+    return RTN_ERROR;
+}
+
+/**
+ * @brief Writes the profile of a stream to its profile cache file.
+ *
+ * The file is replaced atomically, so concurrent runs on the same camera never read a torn
+ * profile. A failed write only costs the next run a probe.
+ *
+ * @param stream  Pointer to the stream_t structure with the probed video stream.
+ */
+void save_stream_profile(const stream_t* stream)
+{
+    if (!stream || !stream->profile_path || !stream->format_context ||
+        stream->video_stream_index < 0)
+        return;
+
+    const AVStream* av_stream = stream->format_context->streams[stream->video_stream_index];
+    const AVCodecParameters* codecpar = av_stream->codecpar;
+    const char* pix_fmt = av_get_pix_fmt_name(codecpar->format);
+    if (codecpar->width <= 0 || codecpar->height <= 0 || !pix_fmt)
+        return;
+
+    AVRational frame_rate = av_stream->avg_frame_rate;
+    if (!frame_rate.num || !frame_rate.den)
+        frame_rate = av_stream->r_frame_rate;
+
+    size_t size = 512 + 2 * (size_t)codecpar->extradata_size;
+    char* text = malloc(size);
+    if (!text)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) save_stream_profile | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return;
+    }
+
+    int length = snprintf(text, size,
+                          PROFILE_MAGIC "\nstream_index %d\ncodec %s\nsize %dx%d\npix_fmt %s\n"
+                                        "time_base %d/%d\nframe_rate %d/%d\ngop_sec %.6f\n"
+                                        "extradata ",
+                          stream->video_stream_index, avcodec_get_name(codecpar->codec_id),
+                          codecpar->width, codecpar->height, pix_fmt, av_stream->time_base.num,
+                          av_stream->time_base.den, frame_rate.num, frame_rate.den,
+                          stream->keyframe_interval_sec);
+    for (int i = 0; i < codecpar->extradata_size; ++i)
+        length += snprintf(text + length, size - (size_t)length, "%02x", codecpar->extradata[i]);
+    length += snprintf(text + length, size - (size_t)length,
+                       codecpar->extradata_size ? "\n" : "-\n");
+
+    write_data_to_file_atomic(stream->profile_path, text, (size_t)length, 0);
+    free(text);
+}
@@ -0,0 +1,111 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | region.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <math.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "libavutil/pixdesc.h"
+#include "stream.h"
+#include "utilities.h"
+
+/**
+ * @brief Resolves a crop specification into a pixel region of a frame.
+ *
+ * Normalised coordinates are scaled by the frame size. The left and top edges are
+ * rounded down to the chroma subsampling grid, so every plane of the frame can be
+ * cropped by moving its data pointer alone, and the region is clamped to the frame.
+ * A crop with zero width selects the whole frame.
+ *
+ * @param crop           Pointer to the crop specification.
+ * @param frame_width    Width of the decoded frame in pixels.
+ * @param frame_height   Height of the decoded frame in pixels.
+ * @param log2_chroma_w  Horizontal chroma subsampling shift of the frame's pixel format.
+ * @param log2_chroma_h  Vertical chroma subsampling shift of the frame's pixel format.
+ * @param region         Pointer to the region_t structure to populate.
+ *
+ * @return 0 on success, -1 if the region lies outside the frame or arguments are invalid.
+ */
+short get_crop_region(const crop_t* crop, int frame_width, int frame_height, int log2_chroma_w,
+                      int log2_chroma_h, region_t* region)
+{
+    if (!crop || !region || frame_width <= 0 || frame_height <= 0 || log2_chroma_w < 0 ||
+        log2_chroma_h < 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_crop_region | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    *region = (region_t){0, 0, frame_width, frame_height};
+    if (crop->width <= 0.0f || crop->height <= 0.0f)
+        return RTN_SUCCESS;
+
+    float scale_x = crop->normalized ? (float)frame_width : 1.0f;
+    float scale_y = crop->normalized ? (float)frame_height : 1.0f;
+    long x = lroundf(crop->x * scale_x);
+    long y = lroundf(crop->y * scale_y);
+    long right = lroundf((crop->x + crop->width) * scale_x);
+    long bottom = lroundf((crop->y + crop->height) * scale_y);
+
+    x &= ~((1L << log2_chroma_w) - 1);
+    y &= ~((1L << log2_chroma_h) - 1);
+    if (right > frame_width)
+        right = frame_width;
+    if (bottom > frame_height)
+        bottom = frame_height;
+
+    if (x >= right || y >= bottom)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) get_crop_region | " ERROR_INVALID_CROP "\n");
+        return RTN_ERROR;
+    }
+
+    *region = (region_t){(int)x, (int)y, (int)(right - x), (int)(bottom - y)};
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Resolves the region of the decoded frame that the stream converts and processes.
+ *
+ * @param stream   Pointer to the stream_t structure with an initialized codec context.
+ * @param options  Pointer to the options_t structure containing the crop specification.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short _init_region(stream_t* stream, const options_t* options)
+{
+    if (!stream || !options || !stream->codec_context)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) _init_region | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    const AVPixFmtDescriptor* descriptor = av_pix_fmt_desc_get(stream->codec_context->pix_fmt);
+    int log2_chroma_w = descriptor ? descriptor->log2_chroma_w : 0;
+    int log2_chroma_h = descriptor ? descriptor->log2_chroma_h : 0;
+
+    if (get_crop_region(&options->crop, stream->codec_context->width,
+                        stream->codec_context->height, log2_chroma_w, log2_chroma_h,
+                        &stream->region))
+        return RTN_ERROR;
+
+    if (options->debug)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Processing region %dx%d at %d,%d of %dx%d frame\n",
+               stream->region.width, stream->region.height, stream->region.x, stream->region.y,
+               stream->codec_context->width, stream->codec_context->height);
+
+    return RTN_SUCCESS;
+}
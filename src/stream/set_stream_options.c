@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | set_stream_options.c
     ::  ::          ::  ::    Created  | 2025-06-16
-          ::::  ::::          Modified | 2025-06-16
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -24,10 +24,11 @@
 /**
  * @brief Sets various options for the given stream based on the provided options structure.
  *
- * This function configures the stream's options dictionary with parameters such as RTSP transport,
- * timeout, and debug settings. It validates the input pointers, sets the required options using
- * av_dict_set, and handles errors appropriately. If debug mode is enabled, it prints the current
- * stream options to stdout.
+ * This function configures the stream's options dictionary with parameters such as the RTSP
+ * transport with its UDP socket buffer and reorder queue, timeout, the video-only track setup,
+ * the --fast-start probing limits and debug settings. It validates the input pointers, sets the
+ * required options using av_dict_set, and handles errors appropriately. If debug mode is
+ * enabled, it prints the current stream options to stdout.
  *
  * @param stream   Pointer to the stream_t structure to configure.
  * @param options  Pointer to the options_t structure containing configuration parameters.
@@ -46,8 +47,29 @@ short _set_stream_options(stream_t* stream, const options_t* options)
     snprintf(timeout_str, sizeof(timeout_str), "%d", options->timeout_sec * 1000000);
 
     short error = 0;
-    error |= av_dict_set(&stream->options, "rtsp_transport", "tcp", 0) < 0;
+    // Without a transport the demuxer tries UDP first and falls back to TCP (--transport auto)
+    if (options->transport != TRANSPORT_AUTO)
+        error |= av_dict_set(&stream->options, "rtsp_transport",
+                             transport_to_string(options->transport), 0) < 0;
+    if (options->buffer_size > 0)
+        error |= av_dict_set_int(&stream->options, "buffer_size", options->buffer_size, 0) < 0;
+    if (options->reorder_queue >= 0)
+        error |= av_dict_set_int(&stream->options, "reorder_queue_size", options->reorder_queue,
+                                 0) < 0;
     error |= av_dict_set(&stream->options, "timeout", timeout_str, 0) < 0;
+    // Only video is ever decoded: audio, metadata and ONVIF tracks are never set up
+    error |= av_dict_set(&stream->options, "allowed_media_types", "video", 0) < 0;
+
+    // Fast start: probe a single packet, never buffer, and hand RTSP packets over unreordered
+    if (options->fast_start)
+    {
+        error |= av_dict_set(&stream->options, "probesize", "32", 0) < 0;
+        error |= av_dict_set(&stream->options, "analyzeduration", "0", 0) < 0;
+        error |= av_dict_set(&stream->options, "fflags", "nobuffer", 0) < 0;
+        error |= av_dict_set(&stream->options, "max_delay", "0", 0) < 0;
+        if (options->reorder_queue < 0)
+            error |= av_dict_set(&stream->options, "reorder_queue_size", "0", 0) < 0;
+    }
 
     if (options->debug)
         error |= av_dict_set(&stream->options, "debug", "qp+mv", 0) < 0;
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | stream.c
     ::  ::          ::  ::    Created  | 2025-06-14
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -19,11 +19,14 @@
 #include <unistd.h>
 
 #include "errors.h"
+#include "scaler.h"
 #include "utilities.h"
 
 short _set_stream_options(stream_t* stream, const options_t* options);
 short _open_stream(stream_t* stream, const options_t* options);
 short _init_codec_context(stream_t* stream, const options_t* options);
+short _prime_stream_format(stream_t* stream, const options_t* options);
+short _init_region(stream_t* stream, const options_t* options);
 short _init_sws_context(stream_t* stream, const options_t* options);
 
 /**
@@ -33,6 +36,7 @@ short _init_sws_context(stream_t* stream, const options_t* options);
  * - Sets pointers to NULL.
  * - Sets video_stream_index to -1 to indicate it is not found.
  * - Initializes frame counters to 0.
+ * - Records the opening time that the time to first frame is measured from.
  *
  * @return Pointer to the newly allocated stream_t structure, or NULL if memory allocation fails.
  */
@@ -50,8 +54,25 @@ static stream_t* _init_stream(void)
     stream->video_stream_index = -1;
     stream->codec_context = NULL;
     stream->sws_context = NULL;
+    stream->region = (region_t){0};
+    stream->luma_plane = 0;
     stream->number_of_frames_to_read = 0;
     stream->stop_reading_at = 0;
+    stream->keyframe_interval_sec = 0;
+    stream->last_keyframe_pts = AV_NOPTS_VALUE;
+    stream->last_keyframe_at = 0;
+    stream->frame_duration = 1;
+    stream->profile_path = NULL;
+    stream->profile_loaded = 0;
+    stream->transport_stats = (transport_stats_t){.last_dts = AV_NOPTS_VALUE};
+    stream->opened_at = monotonic_time_in_microseconds();
+    stream->first_frame_us = 0;
+    stream->processed_frame = 0;
+    stream->race = NULL;
+    stream->race_index = 0;
+    stream->primed_packets = NULL;
+    stream->primed_count = 0;
+    stream->primed_next = 0;
 
     return stream;
 }
@@ -59,21 +80,52 @@ static stream_t* _init_stream(void)
 /**
  * @brief Initializes and configures a new stream based on the provided options.
  *
- * This function allocates and initializes a new stream object, sets its options,
- * opens the stream, and initializes the codec and sws contexts. If any step fails,
- * the function returns NULL.
+ * This function points the input at the --input-profile the requested outputs need,
+ * allocates and initializes a new stream object, sets its options,
+ * opens the stream, initializes the codec context, learns the frame format from the first
+ * frame when probing was skipped without it, resolves the processed region
+ * of the frame and initializes the sws context for it. If any step fails, the
+ * function frees the partially initialized stream and returns NULL.
  *
  * @param options Pointer to an options_t structure containing stream configuration parameters.
  *
  * @return Pointer to an initialized stream_t structure on success, or NULL on failure.
  */
-stream_t* get_stream(options_t* options)
+stream_t* get_stream(options_t* options) { return get_racing_stream(options, NULL, 0); }
+
+/**
+ * @brief Initializes and configures a stream that races others for the first usable keyframe.
+ *
+ * Like get_stream(), except that the stream joins the race before it is opened, so its
+ * connect, probe and reads are cancelled as soon as another stream wins.
+ *
+ * @param options  Pointer to an options_t structure with the URL of this stream.
+ * @param race     Race to join (NULL: no race).
+ * @param index    Index of the stream in the race.
+ *
+ * @return Pointer to an initialized stream_t structure on success, or NULL on failure.
+ */
+stream_t* get_racing_stream(options_t* options, stream_race_t* race, int index)
 {
+    if (select_input_profile(options))
+        return NULL;
+
     stream_t* stream = _init_stream();
+    if (!stream)
+        return NULL;
 
+    stream->race = race;
+    stream->race_index = index;
     if (_set_stream_options(stream, options) || _open_stream(stream, options) ||
-        _init_codec_context(stream, options) || _init_sws_context(stream, options))
+        _init_codec_context(stream, options) || _prime_stream_format(stream, options) ||
+        _init_region(stream, options) || _init_sws_context(stream, options))
+    {
+        // A stream cancelled while connecting or probing must still close its session
+        free_stream(stream);
         return NULL;
+    }
+
+    join_stream_race(stream, options);
 
     return stream;
 }
@@ -82,7 +134,9 @@ stream_t* get_stream(options_t* options)
  * @brief Frees all resources associated with a stream_t object.
  *
  * This function releases memory and closes any contexts associated with the given
- * stream_t pointer, including options, format context, codec context, and sws context.
+ * stream_t pointer, including options, format context and codec context, and hands the
+ * sws context back to the SwsContext cache. A stream that processed at least one frame first
+ * refreshes its --profile-cache file.
  * After freeing all internal resources, it also frees the stream_t structure itself.
  *
  * @param stream Pointer to the stream_t object to be freed. If NULL, the function does nothing.
@@ -92,6 +146,11 @@ void free_stream(stream_t* stream)
     if (!stream)
         return;
 
+    if (stream->profile_path && stream->processed_frame)
+        save_stream_profile(stream);
+    free(stream->profile_path);
+    free_primed_packets(stream);
+
     if (stream->options)
         av_dict_free(&stream->options);
     if (stream->format_context)
@@ -99,7 +158,7 @@ void free_stream(stream_t* stream)
     if (stream->codec_context)
         avcodec_free_context(&stream->codec_context);
     if (stream->sws_context)
-        sws_freeContext(stream->sws_context);
+        release_sws_context(stream->sws_context);
 
     free(stream);
     stream = NULL;
@@ -0,0 +1,199 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | stream_race.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "errors.h"
+#include "stream.h"
+#include "utilities.h"
+
+float _get_scale_factor(int src_width, int src_height, const options_t* options);
+
+/* Tells whether a frame region serves one output without upscaling it */
+static short _covers_output(int width, int height, const options_t* output)
+{
+    // A --scale output follows whatever size the stream delivers
+    if (output->resize_width <= 0 && output->resize_height <= 0)
+        return 1;
+
+    return _get_scale_factor(width, height, output) <= 1.0f + 1e-3f;
+}
+
+/**
+ * @brief Tells whether a frame region serves every requested output without upscaling.
+ *
+ * Each output is sized on its own, as _get_scale_factor() sizes it: the main output and
+ * every output variant.
+ */
+static short _covers_outputs(int width, int height, const options_t* options)
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    options_t output = *options;
+    output.debug = 0;
+    if ((!options->outputs_count || options->output_file_path || options->output_file_fd >= 0) &&
+        !_covers_output(width, height, &output))
+        return 0;
+
+    for (int i = 0; i < options->outputs_count; ++i)
+    {
+        output.scale_factor = options->outputs[i].scale_factor;
+        output.resize_width = options->outputs[i].resize_width;
+        output.resize_height = options->outputs[i].resize_height;
+        if (!_covers_output(width, height, &output))
+            return 0;
+    }
+
+    return 1;
+}
+
+/* Tells whether another stream may still qualify with a smaller frame than `area` */
+static short _smaller_stream_pending(stream_race_t* race, int index, long long area)
+{
+    for (int i = 0; i < RACE_STREAMS; ++i)
+    {
+        long long other = atomic_load(&race->areas[i]);
+        if (i != index && (other == 0 || (other > 0 && other < area)))
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Prepares a race of --input and --input-alt for the first usable keyframe.
+ *
+ * @param race  Race to prepare.
+ */
+void init_stream_race(stream_race_t* race)
+{
+    atomic_init(&race->winner, -1);
+    for (int i = 0; i < RACE_STREAMS; ++i) atomic_init(&race->areas[i], 0);
+}
+
+/**
+ * @brief Enters an opened stream into its race with the size of its processed region.
+ *
+ * A stream whose frames do not cover every requested output is entered as out of the race,
+ * so the other streams never wait for it.
+ *
+ * @param stream   Pointer to the opened stream with its processed region.
+ * @param options  Pointer to the options_t structure with the requested outputs.
+ */
+void join_stream_race(stream_t* stream, const options_t* options)
+{
+    if (!stream || !stream->race || stream->race_index < 0 || stream->race_index >= RACE_STREAMS)
+        return;
+
+    long long area = (long long)stream->region.width * stream->region.height;
+    if (!_covers_outputs(stream->region.width, stream->region.height, options))
+    {
+        area = -1;
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Stream %d (%dx%d) is too small for the output\n",
+                   stream->race_index, stream->region.width, stream->region.height);
+    }
+
+    atomic_store(&stream->race->areas[stream->race_index], area);
+}
+
+/**
+ * @brief Takes a stream out of its race, e.g. when it failed to open or to read.
+ *
+ * @param race   Race the stream takes part in (NULL: none).
+ * @param index  Index of the stream in the race.
+ */
+void leave_stream_race(stream_race_t* race, int index)
+{
+    if (race && index >= 0 && index < RACE_STREAMS)
+        atomic_store(&race->areas[index], -1);
+}
+
+/**
+ * @brief Claims the race for a stream that decoded its first I-frame.
+ *
+ * A stream wins when its frame covers every requested output. While another stream could
+ * still qualify with a smaller frame (it is still opening, or it is open and smaller and
+ * covers the outputs too), the claim waits up to RACE_GRACE_MS for it, so the cheaper sub
+ * stream is preferred over a main stream that happened to send its keyframe first. The other
+ * streams are then cancelled through their interrupt callbacks. A stream too small for the
+ * output withdraws, as none of its frames will ever cover it. Claiming again after a win
+ * succeeds.
+ *
+ * @param stream   Pointer to the stream that decoded its first I-frame.
+ * @param options  Pointer to the options_t structure with the requested outputs.
+ *
+ * @return 0 if the stream won the race (or takes part in none), -1 if it lost or withdrew.
+ */
+short claim_stream_race(stream_t* stream, const options_t* options)
+{
+    if (!stream || !stream->race)
+        return RTN_SUCCESS;
+
+    stream_race_t* race = stream->race;
+    int width = stream->region.width;
+    int height = stream->region.height;
+    if (!_covers_outputs(width, height, options))
+    {
+        if (options->debug)
+            printf(ANSI_BLUE "Debug:" ANSI_RESET " Stream %d (%dx%d) is too small for the output\n",
+                   stream->race_index, width, height);
+        leave_stream_race(race, stream->race_index);
+        return RTN_ERROR;
+    }
+
+    long long area = (long long)width * height;
+    struct timespec poll = {0, RACE_POLL_US * 1000L};
+    long long grace_until = monotonic_time_in_microseconds() + RACE_GRACE_MS * 1000LL;
+    while (atomic_load(&race->winner) == -1 &&
+           _smaller_stream_pending(race, stream->race_index, area) &&
+           monotonic_time_in_microseconds() < grace_until && !stop_requested() &&
+           !deadline_exceeded())
+        nanosleep(&poll, NULL);
+
+    int none = -1;
+    if (!atomic_compare_exchange_strong(&race->winner, &none, stream->race_index) &&
+        none != stream->race_index)
+        return RTN_ERROR;
+
+    if (options->debug && none == -1)
+        printf(ANSI_BLUE "Debug:" ANSI_RESET " Stream %d (%dx%d) won the race\n",
+               stream->race_index, width, height);
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Checks whether another stream already won the race of this one.
+ *
+ * Polled by the interrupt callback, so it must stay cheap and lock-free.
+ *
+ * @param stream  Pointer to the stream (NULL or not racing: never lost).
+ *
+ * @return 1 if another stream won, otherwise 0.
+ */
+short stream_race_lost(const stream_t* stream)
+{
+    if (!stream || !stream->race)
+        return 0;
+
+    int winner = atomic_load(&stream->race->winner);
+    return winner != -1 && winner != stream->race_index;
+}
@@ -0,0 +1,105 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | transport_stats.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "stream.h"
+#include "utilities.h"
+
+/**
+ * @brief Counts a demuxed video packet in the transport statistics.
+ *
+ * The RTP sequence counters of the demuxer are private to FFmpeg, so loss and reordering are
+ * derived from the packet timestamps instead: a DTS that goes backwards is a reordered packet,
+ * and a DTS step of several nominal frame durations means the frames in between were lost.
+ * Gaps are only counted once a frame was decoded, so joining the stream mid-GOP is not a loss.
+ *
+ * @param stream  Pointer to the stream_t structure holding the statistics.
+ * @param packet  Video packet just read from the stream.
+ */
+void count_video_packet(stream_t* stream, const AVPacket* packet)
+{
+    transport_stats_t* stats = &stream->transport_stats;
+    stats->packets++;
+    if (packet->flags & AV_PKT_FLAG_CORRUPT)
+        stats->corrupt_packets++;
+
+    if (packet->dts == AV_NOPTS_VALUE)
+        return;
+
+    if (stats->last_dts != AV_NOPTS_VALUE && packet->dts < stats->last_dts)
+    {
+        stats->reordered_packets++;
+        return;
+    }
+
+    if (stats->frames && stats->last_dts != AV_NOPTS_VALUE && stream->frame_duration > 0)
+    {
+        int64_t steps =
+            (packet->dts - stats->last_dts + stream->frame_duration / 2) / stream->frame_duration;
+        if (steps > 1)
+            stats->missing_frames += (unsigned long long)(steps - 1);
+    }
+
+    stats->last_dts = packet->dts;
+}
+
+/* Tells whether the decoder concealed missing or damaged parts of a frame */
+short is_corrupt_frame(const AVFrame* frame)
+{
+    return (frame->flags & AV_FRAME_FLAG_CORRUPT) || frame->decode_error_flags;
+}
+
+/**
+ * @brief Counts a decoded video frame and checks the frame loss against --max-loss.
+ *
+ * @param stream   Pointer to the stream_t structure holding the statistics.
+ * @param frame    Video frame just decoded.
+ * @param options  Pointer to the options_t structure with the tolerated loss.
+ *
+ * @return 0 while the share of lost and corrupt frames is within --max-loss, -1 above it.
+ */
+short count_video_frame(stream_t* stream, const AVFrame* frame, const options_t* options)
+{
+    transport_stats_t* stats = &stream->transport_stats;
+    stats->frames++;
+    if (is_corrupt_frame(frame))
+        stats->corrupt_frames++;
+
+    if (options->max_loss >= 100)
+        return RTN_SUCCESS;
+
+    unsigned long long lost = stats->corrupt_frames + stats->missing_frames;
+    unsigned long long expected = stats->frames + stats->missing_frames;
+    if (lost * 100 <= (unsigned long long)options->max_loss * expected)
+        return RTN_SUCCESS;
+
+    write_msg_to_fd(STDERR_FILENO, "(f) count_video_frame | " ERROR_PACKET_LOSS_ABOVE_LIMIT "\n");
+    return RTN_ERROR;
+}
+
+/* Prints the transport statistics of the stream (debug output) */
+void print_transport_stats(const stream_t* stream)
+{
+    const transport_stats_t* stats = &stream->transport_stats;
+    printf(ANSI_BLUE "Debug:" ANSI_RESET
+                     " Transport: %llu packets (%llu corrupt, %llu reordered), %llu frames "
+                     "decoded (%llu corrupt), ~%llu frames lost\n",
+           stats->packets, stats->corrupt_packets, stats->reordered_packets, stats->frames,
+           stats->corrupt_frames, stats->missing_frames);
+}
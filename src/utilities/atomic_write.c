@@ -0,0 +1,225 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | atomic_write.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+#define ATOMIC_WRITE_FILE_MODE 0644  // Permissions of the published file.
+
+static atomic_uint _temp_counter = 0;
+
+/* Splits a path into a newly allocated directory part ("." if there is none) */
+static char* _get_directory(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    if (!slash)
+        return strdup(".");
+    if (slash == path)
+        return strdup("/");
+
+    return strndup(path, slash - path);
+}
+
+/* Builds a hidden, process-unique temp name next to the destination file */
+static char* _get_temp_path(const char* directory, const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    const char* name = slash ? slash + 1 : path;
+
+    size_t size = strlen(directory) + strlen(name) + 64;
+    char* temp_path = malloc(size);
+    if (!temp_path)
+        return NULL;
+
+    snprintf(temp_path, size, "%s/.%s.%ld.%u.tmp", directory, name, (long)getpid(),
+             atomic_fetch_add(&_temp_counter, 1));
+    return temp_path;
+}
+
+/* Preallocates and fills the file with unbuffered positional writes */
+static short _write_all(int fd, const uint8_t* buf, size_t buf_size, char durable)
+{
+#ifdef __linux__
+    // Reserve the extents up front; filesystems without support (e.g. some NFS) just skip it
+    if (fallocate(fd, 0, 0, (off_t)buf_size) && errno != EOPNOTSUPP && errno != ENOSYS)
+        return RTN_ERROR;
+#endif
+
+    size_t total_written = 0;
+    while (total_written < buf_size)
+    {
+        ssize_t written =
+            pwrite(fd, buf + total_written, buf_size - total_written, (off_t)total_written);
+        if (written > 0)
+            total_written += written;
+        else if (written < 0 && errno == EINTR)
+            continue;
+        else
+            return RTN_ERROR;
+    }
+
+    if (durable && fdatasync(fd))
+        return RTN_ERROR;
+
+    return RTN_SUCCESS;
+}
+
+/* Makes the rename itself durable by syncing the containing directory */
+static short _sync_directory(const char* directory)
+{
+    int fd = open(directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return RTN_ERROR;
+
+    short result = fsync(fd) ? RTN_ERROR : RTN_SUCCESS;
+    close(fd);
+    return result;
+}
+
+#ifdef O_TMPFILE
+/*
+ * Writes into an anonymous O_TMPFILE inode and links it under the temp name only once the
+ * data is complete, so no partially written file is ever visible in the directory.
+ */
+static short _write_tmpfile(const char* directory, const char* temp_path, const uint8_t* buf,
+                            size_t buf_size, char durable)
+{
+    int fd = open(directory, O_TMPFILE | O_WRONLY | O_CLOEXEC, ATOMIC_WRITE_FILE_MODE);
+    if (fd < 0)
+        return RTN_ERROR;
+
+    char proc_path[64];
+    snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", fd);
+
+    short result = RTN_ERROR;
+    if (!_write_all(fd, buf, buf_size, durable) &&
+        !linkat(AT_FDCWD, proc_path, AT_FDCWD, temp_path, AT_SYMLINK_FOLLOW))
+        result = RTN_SUCCESS;
+
+    close(fd);
+    return result;
+}
+#endif
+
+/* Writes into a named temp file created exclusively next to the destination */
+static short _write_named_temp(const char* temp_path, const uint8_t* buf, size_t buf_size,
+                               char durable)
+{
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, ATOMIC_WRITE_FILE_MODE);
+    if (fd < 0)
+        return RTN_ERROR;
+
+    short result = _write_all(fd, buf, buf_size, durable);
+    close(fd);
+
+    if (result)
+        unlink(temp_path);
+
+    return result;
+}
+
+/**
+ * @brief Atomically replace a file with the contents of a buffer.
+ *
+ * The data is written to a temp file in the destination directory, preferably an anonymous
+ * O_TMPFILE inode, falling back to a hidden named file where O_TMPFILE is not supported
+ * (e.g. NFS). The file is preallocated with fallocate() and filled with unbuffered pwrite()
+ * calls, then renamed over the destination, so readers only ever see the previous or the
+ * complete new file.
+ *
+ * @param file_path  Path to the file to write (will be normalized).
+ * @param buf        Pointer to the buffer to write.
+ * @param buf_size   Number of bytes to write from the buffer.
+ * @param durable    If non-zero, fdatasync() the file before the rename and fsync() the
+ *                   directory after it, so the new file survives a crash.
+ *
+ * @return On success, returns the total number of written bytes.
+ *         On error, returns -1 and the destination is left untouched.
+ */
+ssize_t write_data_to_file_atomic(const char* file_path, const void* buf, size_t buf_size,
+                                  char durable)
+{
+    if (file_path == NULL || buf == NULL || buf_size == 0)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_data_to_file_atomic | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    char* normalized_path = normalize_file_path(file_path);
+    char* directory = normalized_path ? _get_directory(normalized_path) : NULL;
+    char* temp_path = directory ? _get_temp_path(directory, normalized_path) : NULL;
+    if (!temp_path)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_data_to_file_atomic | " ERROR_INVALID_ARGUMENTS "\n");
+        goto error;
+    }
+
+    short written = RTN_ERROR;
+#ifdef O_TMPFILE
+    written = _write_tmpfile(directory, temp_path, buf, buf_size, durable);
+#endif
+    if (written)
+        written = _write_named_temp(temp_path, buf, buf_size, durable);
+    if (written)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_data_to_file_atomic | " ERROR_FAILED_TO_CREATE_TEMP_FILE "\n");
+        goto error;
+    }
+
+    if (rename(temp_path, normalized_path))
+    {
+        unlink(temp_path);
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_data_to_file_atomic | " ERROR_FAILED_TO_RENAME_FILE "\n");
+        goto error;
+    }
+
+    if (durable && _sync_directory(directory))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) write_data_to_file_atomic | " ERROR_FAILED_TO_SYNC_FILE "\n");
+        goto error;
+    }
+
+    free(temp_path);
+    free(directory);
+    free(normalized_path);
+    return (ssize_t)buf_size;
+
+error:
+    if (temp_path)
+        free(temp_path);
+    if (directory)
+        free(directory);
+    if (normalized_path)
+        free(normalized_path);
+
+    return RTN_ERROR;
+}
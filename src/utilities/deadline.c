@@ -0,0 +1,88 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | deadline.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdatomic.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+// Stages are set and latched by every stream of an --input-alt race
+static long long _deadline_at = 0;                      // Monotonic deadline in us (0: none).
+static _Atomic(const char*) _stage = "start";           // Stage the run is currently in.
+static _Atomic(const char*) _exhausted_stage = NULL;    // Stage that ran out of budget.
+
+/**
+ * @brief Arms the end-to-end deadline of the run (--deadline-ms).
+ *
+ * The budget is measured on the monotonic clock, so NTP steps neither shorten nor extend it.
+ * A zero budget disarms the deadline and forgets any exhausted stage.
+ *
+ * @param deadline_ms  Budget from now in milliseconds (0: no deadline).
+ */
+void start_deadline(int deadline_ms)
+{
+    _deadline_at = 0;
+    _stage = "start";
+    _exhausted_stage = NULL;
+    if (deadline_ms > 0)
+        _deadline_at = monotonic_time_in_microseconds() + (long long)deadline_ms * 1000;
+}
+
+/* Names the stage that the budget is spent on from now on (connect, probe, decode...) */
+void set_deadline_stage(const char* stage) { _stage = stage; }
+
+/* Monotonic time of the deadline in microseconds, or 0 when no deadline is armed */
+long long get_deadline_at(void) { return _deadline_at; }
+
+/**
+ * @brief Checks whether the deadline has passed, recording the stage it was exhausted in.
+ *
+ * @return 1 if an armed deadline has passed, otherwise 0.
+ */
+short deadline_exceeded(void)
+{
+    if (_exhausted_stage)
+        return 1;
+    if (!_deadline_at || monotonic_time_in_microseconds() < _deadline_at)
+        return 0;
+
+    const char* none = NULL;
+    atomic_compare_exchange_strong(&_exhausted_stage, &none, atomic_load(&_stage));
+    return 1;
+}
+
+/**
+ * @brief Stage that exhausted the budget.
+ *
+ * @return Name of the stage, or NULL if the deadline was never exceeded.
+ */
+const char* get_deadline_exhausted_stage(void) { return _exhausted_stage; }
+
+/**
+ * @brief AVIOInterruptCB callback that aborts blocking FFmpeg I/O once the deadline passed.
+ *
+ * FFmpeg polls it while connecting, reading and waiting on sockets, so a blocked
+ * avformat_open_input(), avformat_find_stream_info() or av_read_frame() returns promptly.
+ *
+ * @param opaque  Unused.
+ *
+ * @return 1 to abort the blocking operation, 0 to let it continue.
+ */
+int deadline_interrupt_callback(void* opaque)
+{
+    (void)opaque;
+    return deadline_exceeded();
+}
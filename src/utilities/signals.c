@@ -0,0 +1,68 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | signals.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <signal.h>
+#include <string.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+static volatile sig_atomic_t _stop_signal_received = 0;
+
+/**
+ * @brief Records that a stop signal (SIGINT or SIGTERM) was delivered.
+ *
+ * @param signum The number of the received signal (unused).
+ */
+static void _handle_stop_signal(int signum)
+{
+    (void)signum;
+    _stop_signal_received = 1;
+}
+
+/**
+ * @brief Installs handlers for SIGINT and SIGTERM that request a graceful stop.
+ *
+ * Long-running modes poll stop_requested() between frames instead of being killed mid-write,
+ * so buffers and shared resources are released properly.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+short install_stop_handlers(void)
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+
+    if (sigaction(SIGINT, &action, NULL) || sigaction(SIGTERM, &action, NULL))
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) install_stop_handlers | "
+                                       ERROR_FAILED_TO_INSTALL_SIGNAL_HANDLERS "\n");
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Checks whether a stop signal has been received.
+ *
+ * @return 1 if SIGINT or SIGTERM was received, 0 otherwise.
+ */
+short stop_requested(void) { return _stop_signal_received ? 1 : 0; }
@@ -7,14 +7,17 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | time.c
     ::  ::          ::  ::    Created  | 2025-06-15
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "errors.h"
@@ -43,3 +46,24 @@ long long time_now_in_microseconds(void)
 
     return (long long)(tv.tv_sec) * 1000000 + (long long)(tv.tv_usec);
 }
+
+/**
+ * @brief Get the current value of the monotonic clock in microseconds.
+ *
+ * Unlike time_now_in_microseconds(), the returned value is not affected by wall-clock
+ * adjustments, which makes it the right base for deadlines and elapsed-time measurements.
+ *
+ * @return The monotonic time in microseconds on success, or -1 on failure.
+ */
+long long monotonic_time_in_microseconds(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts))
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) monotonic_time_in_microseconds | " ERROR_FAILED_TO_GET_TIME "\n");
+        return RTN_ERROR;
+    }
+
+    return (long long)(ts.tv_sec) * 1000000 + (long long)(ts.tv_nsec) / 1000;
+}
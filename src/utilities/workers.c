@@ -0,0 +1,318 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | workers.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "workers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+/* Marks one task of the group as finished and wakes up waiters on the last one */
+static void _finish_group_task(worker_group_t* group)
+{
+    if (!group)
+        return;
+
+    pthread_mutex_lock(&group->mutex);
+    if (--group->pending == 0)
+        pthread_cond_broadcast(&group->done);
+    pthread_mutex_unlock(&group->mutex);
+}
+
+/* Worker thread main loop: runs queued tasks until the pool stops and the queue is drained */
+static void* _worker_loop(void* arg)
+{
+    worker_pool_t* pool = (worker_pool_t*)arg;
+
+    while (1)
+    {
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->queue_length && !pool->stopping)
+            pthread_cond_wait(&pool->not_empty, &pool->mutex);
+
+        if (!pool->queue_length)
+        {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+
+        worker_task_t task = pool->queue[pool->queue_head];
+        pool->queue_head = (pool->queue_head + 1) % pool->queue_capacity;
+        pool->queue_length--;
+        pthread_cond_signal(&pool->not_full);
+        pthread_mutex_unlock(&pool->mutex);
+
+        task.function(task.arg);
+        _finish_group_task(task.group);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Creates a pool of worker threads fed from a bounded task queue.
+ *
+ * @param threads_count   Number of worker threads to start (must be > 0).
+ * @param queue_capacity  Maximum number of queued tasks before submit_worker_task() blocks.
+ *
+ * @return Pointer to the new worker_pool_t, or NULL on failure.
+ *
+ * @note The pool must be released with free_worker_pool().
+ */
+worker_pool_t* create_worker_pool(int threads_count, int queue_capacity)
+{
+    if (threads_count <= 0 || queue_capacity <= 0)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) create_worker_pool | " ERROR_INVALID_ARGUMENTS "\n");
+        return NULL;
+    }
+
+    worker_pool_t* pool = (worker_pool_t*)calloc(1, sizeof(worker_pool_t));
+    if (!pool)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) create_worker_pool | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        return NULL;
+    }
+
+    pool->threads = (pthread_t*)calloc(threads_count, sizeof(pthread_t));
+    pool->queue = (worker_task_t*)calloc(queue_capacity, sizeof(worker_task_t));
+    pool->queue_capacity = queue_capacity;
+    if (!pool->threads || !pool->queue)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) create_worker_pool | " ERROR_FAILED_TO_ALLOCATE_MEMORY "\n");
+        free(pool->threads);
+        free(pool->queue);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->not_empty, NULL);
+    pthread_cond_init(&pool->not_full, NULL);
+
+    for (int i = 0; i < threads_count; ++i)
+    {
+        if (pthread_create(&pool->threads[i], NULL, _worker_loop, pool))
+        {
+            write_msg_to_fd(STDERR_FILENO,
+                            "(f) create_worker_pool | " ERROR_FAILED_TO_START_THREAD "\n");
+            free_worker_pool(pool);
+            return NULL;
+        }
+
+        pool->threads_count++;
+    }
+
+    return pool;
+}
+
+/* Queues a task, waiting for room or giving up with WORKER_QUEUE_FULL when the queue is full */
+static short _queue_task(worker_pool_t* pool, worker_group_t* group, worker_task_fn_t function,
+                         void* arg, char wait)
+{
+    if (group)
+    {
+        pthread_mutex_lock(&group->mutex);
+        group->pending++;
+        pthread_mutex_unlock(&group->mutex);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    while (wait && pool->queue_length == pool->queue_capacity && !pool->stopping)
+        pthread_cond_wait(&pool->not_full, &pool->mutex);
+
+    if (pool->stopping || pool->queue_length == pool->queue_capacity)
+    {
+        short result = pool->stopping ? RTN_ERROR : WORKER_QUEUE_FULL;
+        pthread_mutex_unlock(&pool->mutex);
+        _finish_group_task(group);
+        return result;
+    }
+
+    int tail = (pool->queue_head + pool->queue_length) % pool->queue_capacity;
+    pool->queue[tail] = (worker_task_t){.function = function, .arg = arg, .group = group};
+    pool->queue_length++;
+    pthread_cond_signal(&pool->not_empty);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Queues a task for execution on the pool, blocking while the queue is full.
+ *
+ * @param pool      Pointer to the worker pool.
+ * @param group     Optional group to account the task in (see wait_worker_group()).
+ * @param function  Function to run on a worker thread.
+ * @param arg       Argument passed to function.
+ *
+ * @return 0 on success, or -1 on invalid arguments or if the pool is stopping.
+ */
+short submit_worker_task(worker_pool_t* pool, worker_group_t* group, worker_task_fn_t function,
+                         void* arg)
+{
+    if (!pool || !function)
+    {
+        write_msg_to_fd(STDERR_FILENO, "(f) submit_worker_task | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    return _queue_task(pool, group, function, arg, 1);
+}
+
+/**
+ * @brief Queues a task for execution on the pool without waiting for room in the queue.
+ *
+ * Producers that must never stall (e.g. a capture loop draining a socket) use this to drop
+ * work instead of blocking when the workers cannot keep up.
+ *
+ * @param pool      Pointer to the worker pool.
+ * @param group     Optional group to account the task in (see wait_worker_group()).
+ * @param function  Function to run on a worker thread.
+ * @param arg       Argument passed to function.
+ *
+ * @return 0 on success, WORKER_QUEUE_FULL if the queue is full (the task is not queued),
+ *         or -1 on invalid arguments or if the pool is stopping.
+ */
+short try_submit_worker_task(worker_pool_t* pool, worker_group_t* group,
+                             worker_task_fn_t function, void* arg)
+{
+    if (!pool || !function)
+    {
+        write_msg_to_fd(STDERR_FILENO,
+                        "(f) try_submit_worker_task | " ERROR_INVALID_ARGUMENTS "\n");
+        return RTN_ERROR;
+    }
+
+    return _queue_task(pool, group, function, arg, 0);
+}
+
+/**
+ * @brief Returns the number of tasks waiting in the queue (running tasks are not counted).
+ *
+ * @param pool  Pointer to the worker pool.
+ *
+ * @return Queue length, or 0 if pool is NULL.
+ */
+int get_worker_queue_length(worker_pool_t* pool)
+{
+    if (!pool)
+        return 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    int length = pool->queue_length;
+    pthread_mutex_unlock(&pool->mutex);
+
+    return length;
+}
+
+/**
+ * @brief Stops the pool after all queued tasks have run, joins the workers and frees it.
+ *
+ * @param pool  Pointer to the worker pool (may be NULL).
+ */
+void free_worker_pool(worker_pool_t* pool)
+{
+    if (!pool)
+        return;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->not_empty);
+    pthread_cond_broadcast(&pool->not_full);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->threads_count; ++i)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_cond_destroy(&pool->not_full);
+    pthread_cond_destroy(&pool->not_empty);
+    pthread_mutex_destroy(&pool->mutex);
+
+    free(pool->queue);
+    free(pool->threads);
+    free(pool);
+}
+
+/**
+ * @brief Initializes an empty task group.
+ *
+ * @param group  Pointer to the group to initialize.
+ *
+ * @return 0 on success, or -1 on failure.
+ */
+short init_worker_group(worker_group_t* group)
+{
+    if (!group)
+        return RTN_ERROR;
+
+    group->pending = 0;
+    if (pthread_mutex_init(&group->mutex, NULL))
+        return RTN_ERROR;
+    if (pthread_cond_init(&group->done, NULL))
+    {
+        pthread_mutex_destroy(&group->mutex);
+        return RTN_ERROR;
+    }
+
+    return RTN_SUCCESS;
+}
+
+/**
+ * @brief Blocks until every task submitted with this group has finished.
+ *
+ * @param group  Pointer to the group to wait for.
+ */
+void wait_worker_group(worker_group_t* group)
+{
+    if (!group)
+        return;
+
+    pthread_mutex_lock(&group->mutex);
+    while (group->pending)
+        pthread_cond_wait(&group->done, &group->mutex);
+    pthread_mutex_unlock(&group->mutex);
+}
+
+/**
+ * @brief Releases the resources of a task group that has no pending tasks.
+ *
+ * @param group  Pointer to the group to destroy.
+ */
+void destroy_worker_group(worker_group_t* group)
+{
+    if (!group)
+        return;
+
+    pthread_cond_destroy(&group->done);
+    pthread_mutex_destroy(&group->mutex);
+}
+
+/**
+ * @brief Returns the number of online CPUs (at least 1).
+ */
+int get_cpu_count(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
@@ -7,14 +7,18 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | write.c
     ::  ::          ::  ::    Created  | 2025-06-05
-          ::::  ::::          Modified | 2025-06-20
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
 
 *******************************************************************/
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,34 +27,109 @@
 #include "errors.h"
 #include "utilities.h"
 
+/* Returns the time left until the deadline in ms, -1 if there is no deadline */
+static int _remaining_ms(long long deadline_us)
+{
+    if (!deadline_us)
+        return -1;
+
+    long long left_us = deadline_us - monotonic_time_in_microseconds();
+    if (left_us <= 0)
+        return 0;
+
+    return (int)((left_us + 999) / 1000);
+}
+
+/* Polls the descriptor for `events` and accounts the time spent waiting as a stall */
+static int _poll_fd(int fd, short events, int timeout_ms, write_stats_t* stats)
+{
+    struct pollfd pfd = {.fd = fd, .events = events, .revents = 0};
+
+    long long started_at = monotonic_time_in_microseconds();
+    int ready = poll(&pfd, 1, timeout_ms);
+    stats->stall_us += monotonic_time_in_microseconds() - started_at;
+    stats->polls++;
+
+    if (ready > 0 && (pfd.revents & (POLLERR | POLLNVAL)))
+    {
+        errno = EPIPE;
+        return RTN_ERROR;
+    }
+
+    if (ready < 0 && errno == EINTR)
+        return 0;
+
+    return ready;
+}
+
+/* Sleeps in poll() until the descriptor accepts more data or the deadline passes */
+static short _wait_writable(int fd, long long deadline_us, write_stats_t* stats)
+{
+    while (1)
+    {
+        int timeout_ms = _remaining_ms(deadline_us);
+        if (timeout_ms == 0)
+        {
+            errno = ETIMEDOUT;
+            return RTN_ERROR;
+        }
+
+        int ready = _poll_fd(fd, POLLOUT, timeout_ms, stats);
+        if (ready < 0)
+            return RTN_ERROR;
+        if (ready > 0)
+            return RTN_SUCCESS;
+    }
+}
+
 /**
- * @brief Writes the specified buffer to a file descriptor.
+ * @brief Writes the specified buffer to a file descriptor, waiting in poll() when it is full.
  *
- * This function attempts to write exactly `buf_size` bytes from the buffer `buf`
- * to the file descriptor `fd`. It handles partial writes by repeatedly calling
- * the write system call until all data is written or an error occurs.
+ * Partial writes are retried until all `buf_size` bytes are accepted. When the descriptor
+ * reports EAGAIN/EWOULDBLOCK the function sleeps in poll() instead of spinning. If a
+ * deadline is set, a blocking descriptor is switched to non-blocking mode for the duration
+ * of the call so that the deadline can be enforced; its flags are restored afterwards.
  *
- * @param fd        The file descriptor to which data will be written.
- * @param buf       Pointer to the buffer containing the data to write.
- * @param buf_size  The number of bytes to write from the buffer.
+ * The data is copied into the descriptor with write(), so the function returns as soon as
+ * the last byte is accepted (e.g. fits into a pipe buffer) and never waits for the reader.
+ *
+ * @param fd          The file descriptor to which data will be written.
+ * @param buf         Pointer to the buffer containing the data to write.
+ * @param buf_size    The number of bytes to write from the buffer.
+ * @param timeout_ms  Deadline for the whole write in milliseconds (0: no deadline).
+ * @param stats       Optional pointer to receive throughput and stall statistics.
  *
  * @return On success, returns the total number of written bytes.
- *         On error, returns -1.
+ *         On error or timeout, returns -1.
  *
  * @note This function does not close the file descriptor.
- *       If a signal interrupts the write operation, the function will retry.
  */
-ssize_t write_data_to_fd(int fd, const void* buf, size_t buf_size)
+ssize_t write_data_to_fd_with_deadline(int fd, const void* buf, size_t buf_size, int timeout_ms,
+                                       write_stats_t* stats)
 {
-    if (fd < 0 || buf == NULL || buf_size == 0)
+    if (fd < 0 || buf == NULL || buf_size == 0 || timeout_ms < 0)
     {
         write(STDERR_FILENO, "(f) write_data_to_fd | " ERROR_INVALID_ARGUMENTS "\n",
               strlen("(f) write_data_to_fd | " ERROR_INVALID_ARGUMENTS "\n"));
         return RTN_ERROR;
     }
 
+    write_stats_t local_stats;
+    if (!stats)
+        stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    long long started_at = monotonic_time_in_microseconds();
+    long long deadline_us = timeout_ms ? started_at + (long long)timeout_ms * 1000 : 0;
+
+    int fd_flags = fcntl(fd, F_GETFL);
+    char restore_flags = 0;
+    if (deadline_us && fd_flags >= 0 && !(fd_flags & O_NONBLOCK))
+        restore_flags = !fcntl(fd, F_SETFL, fd_flags | O_NONBLOCK);
+
     size_t total_written = 0;
     const uint8_t* ptr = (const uint8_t*)buf;
+    short result = RTN_SUCCESS;
 
     while (total_written < buf_size)
     {
@@ -60,21 +139,57 @@ ssize_t write_data_to_fd(int fd, const void* buf, size_t buf_size)
             total_written += written;
         else if (written == 0)
             break;  // EOF reached, no more data to write
-        else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
-            continue;  // Retry on non-blocking or interrupted write
+        else if (errno == EINTR)
+            continue;  // Retry interrupted write
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+            result = RTN_ERROR;
         else
-            goto error;  // Other errors, exit with error
+            result = _wait_writable(fd, deadline_us, stats);
+
+        if (result)
+            break;
     }
 
-    return (ssize_t)total_written;
+    int saved_errno = errno;
+    if (restore_flags)
+        fcntl(fd, F_SETFL, fd_flags);
+
+    stats->bytes = total_written;
+    stats->elapsed_us = monotonic_time_in_microseconds() - started_at;
 
-error:
+    if (!result)
+        return (ssize_t)total_written;
 
-    write(STDERR_FILENO, "(f) write_data_to_fd | " ERROR_FAILED_TO_WRITE_FD "\n",
-          strlen("(f) write_data_to_fd | " ERROR_FAILED_TO_WRITE_FD "\n"));
+    if (saved_errno == ETIMEDOUT)
+        write(STDERR_FILENO, "(f) write_data_to_fd | " ERROR_WRITE_TIMED_OUT "\n",
+              strlen("(f) write_data_to_fd | " ERROR_WRITE_TIMED_OUT "\n"));
+    else
+        write(STDERR_FILENO, "(f) write_data_to_fd | " ERROR_FAILED_TO_WRITE_FD "\n",
+              strlen("(f) write_data_to_fd | " ERROR_FAILED_TO_WRITE_FD "\n"));
     return RTN_ERROR;
 }
 
+/**
+ * @brief Writes the specified buffer to a file descriptor.
+ *
+ * This function attempts to write exactly `buf_size` bytes from the buffer `buf`
+ * to the file descriptor `fd`, without a deadline. See write_data_to_fd_with_deadline().
+ *
+ * @param fd        The file descriptor to which data will be written.
+ * @param buf       Pointer to the buffer containing the data to write.
+ * @param buf_size  The number of bytes to write from the buffer.
+ *
+ * @return On success, returns the total number of written bytes.
+ *         On error, returns -1.
+ *
+ * @note This function does not close the file descriptor.
+ *       If a signal interrupts the write operation, the function will retry.
+ */
+ssize_t write_data_to_fd(int fd, const void* buf, size_t buf_size)
+{
+    return write_data_to_fd_with_deadline(fd, buf, buf_size, 0, NULL);
+}
+
 /**
  * @brief Writes a null-terminated message to the specified file descriptor.
  *
@@ -0,0 +1,146 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_batch_line.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "options.h"
+#include "process.h"
+#include "utilities.h"
+
+#define T_BATCH_PATH "/tmp/test_run_batch.txt"
+#define T_BATCH_STATUS_SIZE 4096
+
+int test_split_batch_line(void)
+{
+    char line[] = "  -i rtsp://cam1/main\t-o \"/srv/snap/cam 1.jpg\" -w'320'  \n";
+    char* argv[MAX_BATCH_ARGS];
+    int argc = split_batch_line(line, argv, MAX_BATCH_ARGS);
+    int failed = argc != 6 || strcmp(argv[0], "streamshot") != 0 ||
+                 strcmp(argv[2], "rtsp://cam1/main") != 0 ||
+                 strcmp(argv[4], "/srv/snap/cam 1.jpg") != 0 || strcmp(argv[5], "-w320") != 0 ||
+                 argv[6] != NULL;
+
+    char blank[] = " \t\n";
+    failed += split_batch_line(blank, argv, MAX_BATCH_ARGS) != 1;
+
+    char unterminated[] = "-o 'cam.jpg";
+    failed += split_batch_line(unterminated, argv, MAX_BATCH_ARGS) != -1;
+
+    char too_many[] = "-d -d -d";
+    failed += split_batch_line(too_many, argv, 3) != -1;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) split_batch_line: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) split_batch_line: test passed\n");
+    return 0;
+}
+
+/* Counts the open file descriptors of the process */
+static int _count_open_fds(void)
+{
+    DIR* dir = opendir("/proc/self/fd");
+    if (!dir)
+        return -1;
+
+    int count = 0;
+    while (readdir(dir)) ++count;
+    closedir(dir);
+    return count;
+}
+
+int test_run_batch(void)
+{
+    FILE* file = fopen(T_BATCH_PATH, "w");
+    if (!file)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) run_batch: fopen failed\n");
+        return 1;
+    }
+
+    // Nothing listens on port 1, so every job fails to open its stream
+    fputs("# unreachable cameras\n"
+          "-i rtsp://127.0.0.1:1/cam1 -o /tmp/test_run_batch_1.jpg\n"
+          "\n"
+          "-i rtsp://127.0.0.1:1/cam2 -o /tmp/test_run_batch_2.jpg -w 320\n"
+          "-i rtsp://127.0.0.1:1/cam3\n",
+          file);
+    fclose(file);
+
+    int open_fds = _count_open_fds();
+    char status_path[] = "/tmp/test_run_batch_status_XXXXXX";
+    int status_fd = mkstemp(status_path);
+    int stdout_fd = dup(STDOUT_FILENO);
+    if (status_fd < 0 || stdout_fd < 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) run_batch: mkstemp failed\n");
+        return 1;
+    }
+
+    options_t options = {0};
+    options.batch_file = T_BATCH_PATH;
+    options.jobs = 2;
+    options.output_file_fd = -1;
+
+    // The JSON status lines go to stdout, which is pointed at a file while the batch runs
+    fflush(stdout);
+    dup2(status_fd, STDOUT_FILENO);
+    short result = run_batch(&options);
+    fflush(stdout);
+    dup2(stdout_fd, STDOUT_FILENO);
+    close(stdout_fd);
+
+    char status[T_BATCH_STATUS_SIZE] = {0};
+    lseek(status_fd, 0, SEEK_SET);
+    ssize_t size = read(status_fd, status, sizeof(status) - 1);
+    close(status_fd);
+    unlink(status_path);
+    unlink(T_BATCH_PATH);
+
+    // A failed open releases its stream, so no socket outlives its job
+    int failed = result != RTN_ERROR || size <= 0 || _count_open_fds() != open_fds;
+    failed += !strstr(status, "{\"line\":2,\"url\":\"rtsp://127.0.0.1:1/cam1\",\"status\":"
+                              "\"error\",\"stage\":\"capture\"");
+    failed += !strstr(status, "{\"line\":4,\"url\":\"rtsp://127.0.0.1:1/cam2\",\"status\":"
+                              "\"error\",\"stage\":\"capture\"");
+    failed += !strstr(status, "{\"line\":5,\"url\":null,\"status\":\"error\",\"stage\":"
+                              "\"options\"");
+    failed += access("/tmp/test_run_batch_1.jpg", F_OK) == 0;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) run_batch: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) run_batch: test passed\n");
+    return 0;
+}
+
+int test_batch_line(void)
+{
+    return test_split_batch_line() + test_run_batch();
+}
@@ -0,0 +1,119 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_box_downscaled_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+
+/* Compares a box-downscaled image against a straightforward per-pixel average */
+static int _check_box_downscale(int width, int height, int ratio, int channels)
+{
+    image_t image = {.width = width, .height = height};
+    image.size = (size_t)width * height * channels;
+    image.data = malloc(image.size);
+    if (!image.data)
+        return 1;
+
+    for (size_t i = 0; i < image.size; ++i)
+        image.data[i] = (uint8_t)((i * 37) ^ (i >> 3));
+
+    image_t* scaled = get_box_downscaled_image(&image, ratio, 0);
+    int dst_width = width / ratio, dst_height = height / ratio;
+    int failed = !scaled || scaled->width != dst_width || scaled->height != dst_height;
+
+    for (int y = 0; !failed && y < dst_height; ++y)
+        for (int x = 0; x < dst_width; ++x)
+            for (int c = 0; c < channels; ++c)
+            {
+                int sum = 0;
+                for (int dy = 0; dy < ratio; ++dy)
+                    for (int dx = 0; dx < ratio; ++dx)
+                        sum += image.data[((size_t)(y * ratio + dy) * width + x * ratio + dx) *
+                                              channels +
+                                          c];
+                int expected = (sum + ratio * ratio / 2) / (ratio * ratio);
+                if (scaled->data[((size_t)y * dst_width + x) * channels + c] != expected)
+                    failed = 1;
+            }
+
+    free(image.data);
+    free_image(scaled);
+    return failed;
+}
+
+int test_box_downscaled_image_values(void)
+{
+    int failed = 0;
+
+    // Widths cover the vectorized vertical pass together with its scalar tail
+    for (int ratio = 2; ratio <= BOX_MAX_RATIO; ++ratio)
+    {
+        failed += _check_box_downscale(48, 36, ratio, RGB_BYTES_PER_PIXEL) +
+                  _check_box_downscale(50, 37, ratio, RGB_BYTES_PER_PIXEL);
+        failed += _check_box_downscale(48, 36, ratio, GRAY_BYTES_PER_PIXEL) +
+                  _check_box_downscale(50, 37, ratio, GRAY_BYTES_PER_PIXEL);
+    }
+
+    // Large enough to be split into row bands on worker threads
+    failed += _check_box_downscale(2004, 1008, 4, RGB_BYTES_PER_PIXEL);
+
+    // The shared band workers are reused by the next image and restarted after being freed
+    failed += _check_box_downscale(2004, 1008, 2, GRAY_BYTES_PER_PIXEL);
+    free_box_downscale_pool();
+    failed += _check_box_downscale(2004, 1008, 2, RGB_BYTES_PER_PIXEL);
+    free_box_downscale_pool();
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_box_downscaled_image: values test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_box_downscaled_image: values test passed\n");
+    return 0;
+}
+
+int test_box_downscale_ratio(void)
+{
+    int failed = get_box_downscale_ratio(3840, 2160, 0.5f) != 2 ||
+                 get_box_downscale_ratio(3840, 2160, 1.0f / 3.0f) != 3 ||
+                 get_box_downscale_ratio(3840, 2160, 0.25f) != 4 ||
+                 get_box_downscale_ratio(3840, 2160, 0.2f) != 0 ||
+                 get_box_downscale_ratio(3840, 2160, 0.6f) != 0 ||
+                 get_box_downscale_ratio(3840, 2160, 1.0f) != 0 ||
+                 get_box_downscale_ratio(1921, 1080, 0.5f) != 0 ||
+                 get_box_downscale_ratio(0, 1080, 0.5f) != 0;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_box_downscale_ratio: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_box_downscale_ratio: test passed\n");
+    return 0;
+}
+
+int test_box_downscaled_image(void)
+{
+    int failed = 0;
+    failed += test_box_downscaled_image_values();
+    failed += test_box_downscale_ratio();
+    return failed;
+}
@@ -0,0 +1,109 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_crop.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "options.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_parse_crop_values(void)
+{
+    crop_t pixels = {0};
+    crop_t fractions = {0};
+    crop_t unit_pixels = {0};
+
+    int failed = parse_crop("640,360,1280,720", &pixels) != RTN_SUCCESS || pixels.x != 640.0f ||
+                 pixels.y != 360.0f || pixels.width != 1280.0f || pixels.height != 720.0f ||
+                 pixels.normalized;
+    failed += parse_crop("0.25,0,0.5,1", &fractions) != RTN_SUCCESS || fractions.x != 0.25f ||
+              fractions.width != 0.5f || fractions.height != 1.0f || !fractions.normalized;
+    failed += parse_crop("0,0,1,1", &unit_pixels) != RTN_SUCCESS || unit_pixels.normalized;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) parse_crop: values test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_crop: values test passed\n");
+    return 0;
+}
+
+int test_parse_crop_invalid(void)
+{
+    const char* specs[] = {"", "1,2,3", "1,2,3,4,5", "a,0,10,10", "-1,0,10,10", "0,0,0,10",
+                           "0,0,10,nan", "0;0;10;10", NULL};
+
+    for (int i = 0; specs[i]; ++i)
+    {
+        crop_t crop = {0};
+        if (parse_crop(specs[i], &crop) != RTN_ERROR)
+        {
+            printf("[" ANSI_RED "KO" ANSI_RESET
+                   "] (f) parse_crop: invalid spec test failed for \"%s\"\n",
+                   specs[i]);
+            return 1;
+        }
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_crop: invalid spec test passed\n");
+    return 0;
+}
+
+int test_get_crop_region(void)
+{
+    region_t region;
+    int failed = 0;
+
+    // No crop selects the whole frame
+    crop_t none = {0};
+    failed += get_crop_region(&none, 1920, 1080, 1, 1, &region) != RTN_SUCCESS ||
+              region.x != 0 || region.y != 0 || region.width != 1920 || region.height != 1080;
+
+    // Normalised centre quarter of a 1920x1080 frame
+    crop_t centre = {0.25f, 0.25f, 0.5f, 0.5f, 1};
+    failed += get_crop_region(&centre, 1920, 1080, 1, 1, &region) != RTN_SUCCESS ||
+              region.x != 480 || region.y != 270 || region.width != 960 || region.height != 540;
+
+    // Odd edges snap down to the 4:2:0 chroma grid and the region is clamped to the frame
+    crop_t odd = {101, 51, 2000, 100, 0};
+    failed += get_crop_region(&odd, 1920, 1080, 1, 1, &region) != RTN_SUCCESS ||
+              region.x != 100 || region.y != 50 || region.width != 1820 || region.height != 101;
+
+    // A region outside the frame is rejected
+    crop_t outside = {1920, 0, 10, 10, 0};
+    failed += get_crop_region(&outside, 1920, 1080, 1, 1, &region) != RTN_ERROR;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_crop_region: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_crop_region: test passed\n");
+    return 0;
+}
+
+int test_crop(void)
+{
+    int failed = 0;
+    failed += test_parse_crop_values();
+    failed += test_parse_crop_invalid();
+    failed += test_get_crop_region();
+    return failed;
+}
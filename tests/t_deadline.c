@@ -0,0 +1,60 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_deadline.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+int test_deadline(void)
+{
+    int failed = 0;
+
+    // Without a budget nothing ever expires
+    start_deadline(0);
+    failed += get_deadline_at() != 0 || deadline_exceeded() || deadline_interrupt_callback(NULL);
+
+    start_deadline(60000);
+    set_deadline_stage("connect");
+    failed += get_deadline_at() <= monotonic_time_in_microseconds() || deadline_exceeded() ||
+              get_deadline_exhausted_stage() != NULL;
+
+    // The stage that ran out of budget is latched, later stages do not replace it
+    start_deadline(1);
+    set_deadline_stage("probe");
+    struct timespec pause = {.tv_sec = 0, .tv_nsec = 5000000};
+    nanosleep(&pause, NULL);
+    failed += !deadline_interrupt_callback(NULL);
+    set_deadline_stage("encode");
+    failed += !deadline_exceeded() || !get_deadline_exhausted_stage() ||
+              strcmp(get_deadline_exhausted_stage(), "probe");
+
+    start_deadline(0);
+    failed += deadline_exceeded() || get_deadline_exhausted_stage() != NULL;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) deadline: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) deadline: test passed\n");
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_find_video_track.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_find_video_track(void)
+{
+    // Audio, main video, ONVIF metadata and sub video tracks, as a camera SDP lists them
+    enum AVMediaType types[] = {AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_VIDEO, AVMEDIA_TYPE_DATA,
+                                AVMEDIA_TYPE_VIDEO};
+    AVCodecParameters codecpars[4] = {0};
+    AVStream av_streams[4] = {0};
+    AVStream* streams[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        codecpars[i].codec_type = types[i];
+        av_streams[i].codecpar = &codecpars[i];
+        streams[i] = &av_streams[i];
+    }
+
+    AVFormatContext format_context = {0};
+    format_context.nb_streams = 4;
+    format_context.streams = streams;
+
+    int failed = find_video_track(&format_context, 0) != 1;
+    failed += find_video_track(&format_context, 1) != 3;
+    failed += find_video_track(&format_context, 2) != -1;
+    failed += find_video_track(NULL, 0) != -1;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) find_video_track: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) find_video_track: test passed\n");
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_first_frame.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "stream.h"
+#include "utilities.h"
+
+int test_read_stream_packet(void)
+{
+    stream_t stream = {.primed_packets = calloc(MAX_PRIMED_PACKETS, sizeof(AVPacket*))};
+    AVPacket* packet = av_packet_alloc();
+    int failed = !stream.primed_packets || !packet;
+
+    for (int i = 0; !failed && i < 3; ++i)
+    {
+        AVPacket kept = {.pts = 100 + i, .flags = i ? 0 : AV_PKT_FLAG_KEY};
+        failed += !(stream.primed_packets[stream.primed_count++] = av_packet_clone(&kept));
+    }
+
+    // The packets kept while learning the format come back in order, starting at the keyframe
+    for (int i = 0; !failed && i < 3; ++i)
+    {
+        failed += read_stream_packet(&stream, packet) != 0 || packet->pts != 100 + i ||
+                  (i == 0) != (packet->flags & AV_PKT_FLAG_KEY);
+        av_packet_unref(packet);
+    }
+    failed += stream.primed_packets != NULL || stream.primed_count != 0;
+
+    free_primed_packets(&stream);
+    av_packet_free(&packet);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) read_stream_packet: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) read_stream_packet: test passed\n");
+    return 0;
+}
+
+int test_first_frame(void)
+{
+    return test_read_stream_packet();
+}
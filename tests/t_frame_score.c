@@ -0,0 +1,122 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_frame_score.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+
+/* Straightforward score of a gray image: 2x2 average, Laplacian variance, exposure weight */
+static double _reference_score(const uint8_t* data, int width, int height)
+{
+    int w = width / 2, h = height / 2;
+    double luma_sum = 0, sum = 0, sum_sq = 0;
+    uint8_t* luma = malloc((size_t)w * h);
+    if (!luma)
+        return -1;
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+        {
+            const uint8_t* p = data + (size_t)(2 * y) * width + 2 * x;
+            luma[y * w + x] = (uint8_t)((p[0] + p[1] + p[width] + p[width + 1] + 2) >> 2);
+            luma_sum += luma[y * w + x];
+        }
+
+    for (int y = 1; y < h - 1; ++y)
+        for (int x = 1; x < w - 1; ++x)
+        {
+            int lap = 4 * luma[y * w + x] - luma[y * w + x - 1] - luma[y * w + x + 1] -
+                      luma[(y - 1) * w + x] - luma[(y + 1) * w + x];
+            sum += lap;
+            sum_sq += (double)lap * lap;
+        }
+
+    free(luma);
+    double samples = (double)(w - 2) * (h - 2);
+    double deviation = (luma_sum / ((double)w * h) - 128.0) / 128.0;
+    return (sum_sq / samples - (sum / samples) * (sum / samples)) * (1.0 - deviation * deviation);
+}
+
+/* Fills a gray image with 4x4 blocks alternating between two levels */
+static void _fill_blocks(uint8_t* data, int width, int height, uint8_t low, uint8_t high)
+{
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x) data[y * width + x] = ((x / 4 + y / 4) % 2) ? high : low;
+}
+
+static int _report(const char* name, int failed)
+{
+    if (failed)
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_frame_score: %s test failed\n", name);
+    else
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_frame_score: %s test passed\n", name);
+    return failed;
+}
+
+int test_frame_score(void)
+{
+    const int width = 142, height = 66;  // Odd-sized planes exercise the vector tails
+    int failed = 0;
+
+    uint8_t* gray = malloc((size_t)width * height);
+    uint8_t* rgb = malloc((size_t)width * height * RGB_BYTES_PER_PIXEL);
+    uint8_t* luma = malloc((size_t)(width / 2) * (height / 2));
+    if (!gray || !rgb || !luma)
+    {
+        free(gray);
+        free(rgb);
+        free(luma);
+        return _report("allocation", 1);
+    }
+
+    for (int i = 0; i < width * height; ++i) gray[i] = (uint8_t)((i * 37) ^ (i >> 3));
+    double score = get_frame_score(gray, width, width, height, GRAY_BYTES_PER_PIXEL, luma);
+    double expected = _reference_score(gray, width, height);
+    failed += _report("reference", fabs(score - expected) > 1e-6 * (fabs(expected) + 1));
+
+    for (int i = 0; i < width * height; ++i) gray[i] = 128;
+    failed += _report("flat frame",
+                      get_frame_score(gray, width, width, height, GRAY_BYTES_PER_PIXEL, luma) != 0);
+
+    _fill_blocks(gray, width, height, 96, 160);
+    double sharp = get_frame_score(gray, width, width, height, GRAY_BYTES_PER_PIXEL, luma);
+    for (int i = 0; i < width * height; ++i)
+        rgb[i * 3] = rgb[i * 3 + 1] = rgb[i * 3 + 2] = gray[i];
+    double sharp_rgb = get_frame_score(rgb, width * RGB_BYTES_PER_PIXEL, width, height,
+                                       RGB_BYTES_PER_PIXEL, luma);
+    failed += _report("rgb matches gray", fabs(sharp - sharp_rgb) > 1e-6 * sharp);
+
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x) gray[y * width + x] = (uint8_t)(96 + x * 64 / width);
+    double blurred = get_frame_score(gray, width, width, height, GRAY_BYTES_PER_PIXEL, luma);
+    failed += _report("sharp beats blurred", !(sharp > blurred));
+
+    _fill_blocks(gray, width, height, 0, 64);
+    double dark = get_frame_score(gray, width, width, height, GRAY_BYTES_PER_PIXEL, luma);
+    failed += _report("exposure weight", !(sharp > dark));
+
+    failed +=
+        _report("tiny frame", get_frame_score(gray, 4, 4, 4, GRAY_BYTES_PER_PIXEL, luma) != 0);
+
+    free(gray);
+    free(rgb);
+    free(luma);
+    return failed;
+}
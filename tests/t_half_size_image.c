@@ -0,0 +1,92 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_half_size_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+
+int test_half_size_image_values(void)
+{
+    // Odd width/height: the trailing column and row are dropped. The width is large enough
+    // for the vectorized vertical pass to run alongside the scalar tail.
+    int width = 37, height = 9;
+    image_t image = {.width = width, .height = height};
+    image.size = (size_t)width * height * RGB_BYTES_PER_PIXEL;
+    image.data = malloc(image.size);
+    if (!image.data)
+        return 1;
+
+    for (size_t i = 0; i < image.size; ++i)
+        image.data[i] = (uint8_t)((i * 37) ^ (i >> 3));
+
+    image_t* half = get_half_size_image(&image);
+    int failed = !half || half->width != width / 2 || half->height != height / 2 ||
+                 half->size != (size_t)(width / 2) * (height / 2) * RGB_BYTES_PER_PIXEL;
+
+    for (int y = 0; !failed && y < height / 2; ++y)
+        for (int x = 0; x < width / 2; ++x)
+            for (int c = 0; c < RGB_BYTES_PER_PIXEL; ++c)
+            {
+                size_t top = ((size_t)(2 * y) * width + 2 * x) * RGB_BYTES_PER_PIXEL + c;
+                size_t bottom = top + (size_t)width * RGB_BYTES_PER_PIXEL;
+                int sum = image.data[top] + image.data[top + RGB_BYTES_PER_PIXEL] +
+                          image.data[bottom] + image.data[bottom + RGB_BYTES_PER_PIXEL];
+                int expected = (sum + 2) >> 2;
+                if (half->data[((size_t)y * (width / 2) + x) * RGB_BYTES_PER_PIXEL + c] !=
+                    expected)
+                    failed = 1;
+            }
+
+    free(image.data);
+    free_image(half);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_half_size_image: values test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_half_size_image: values test passed\n");
+    return 0;
+}
+
+int test_half_size_image_invalid(void)
+{
+    uint8_t pixel[3] = {0};
+    image_t tiny = {.data = pixel, .size = sizeof(pixel), .width = 1, .height = 1};
+    if (get_half_size_image(NULL) || get_half_size_image(&tiny))
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_half_size_image: invalid arguments test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET
+           "] (f) get_half_size_image: invalid arguments test passed\n");
+    return 0;
+}
+
+int test_half_size_image(void)
+{
+    int failed = 0;
+    failed += test_half_size_image_values();
+    failed += test_half_size_image_invalid();
+    return failed;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_image_format_to_string.c
     ::  ::          ::  ::    Created  | 2025-06-25
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -32,6 +32,7 @@ int test_image_format_to_string(void)
                  {IMAGE_FORMAT_JPEG, "jpeg"},
                  {IMAGE_FORMAT_PNG, "png"},
                  {IMAGE_FORMAT_PPM, "ppm"},
+                 {IMAGE_FORMAT_PGM, "pgm"},
                  {IMAGE_FORMAT_UNKNOWN, "unknown format"}};
 
     size_t num_tests = sizeof(tests) / sizeof(tests[0]);
@@ -51,5 +52,16 @@ int test_image_format_to_string(void)
                    (int)tests[i].format, tests[i].expected, result);
     }
 
+    if (strcmp(image_format_to_mime_type(IMAGE_FORMAT_JPEG), "image/jpeg") != 0 ||
+        strcmp(image_format_to_mime_type(IMAGE_FORMAT_PNG), "image/png") != 0 ||
+        strcmp(image_format_to_mime_type(IMAGE_FORMAT_PGM), "image/x-portable-graymap") != 0 ||
+        strcmp(image_format_to_mime_type(IMAGE_FORMAT_UNKNOWN), "application/octet-stream") != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) image_format_to_mime_type: test failed\n");
+        failed = 1;
+    }
+    else
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) image_format_to_mime_type: test passed\n");
+
     return failed;
 }
\ No newline at end of file
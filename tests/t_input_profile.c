@@ -0,0 +1,99 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_input_profile.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errors.h"
+#include "options.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_parse_input_profile(void)
+{
+    input_profile_t profile;
+    int failed = parse_input_profile("1280x720=rtsp://camera/sub?x=1", &profile) != RTN_SUCCESS ||
+                 profile.width != 1280 || profile.height != 720 ||
+                 strcmp(profile.url, "rtsp://camera/sub?x=1") != 0;
+    free(profile.url);
+
+    const char* invalid[] = {"1280x720=", "1280=rtsp://camera", "0x720=rtsp://camera",
+                             "rtsp://camera", ""};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+        failed += parse_input_profile(invalid[i], &profile) != RTN_ERROR || profile.url;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) parse_input_profile: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_input_profile: test passed\n");
+    return 0;
+}
+
+int test_pick_input_profile(void)
+{
+    input_profile_t inputs[] = {{1920, 1080, "rtsp://camera/mid"},
+                                {3840, 2160, "rtsp://camera/main"},
+                                {640, 360, "rtsp://camera/sub"}};
+    options_t options = {0};
+    options.inputs = inputs;
+    options.inputs_count = 3;
+    options.output_file_fd = -1;
+    options.output_file_path = "snapshot.jpg";
+    options.scale_factor = DEFAULT_SCALE_FACTOR;
+
+    // A 320 wide thumbnail is served by the sub stream
+    options.resize_width = 320;
+    int failed = pick_input_profile(&options) != &inputs[2];
+
+    // Half of the 4K frame needs the 1080p profile, 1.5x upscaling keeps the largest one
+    options.resize_width = 0;
+    options.scale_factor = 0.5f;
+    failed += pick_input_profile(&options) != &inputs[0];
+    options.scale_factor = 1.5f;
+    failed += pick_input_profile(&options) != &inputs[1];
+
+    // A variant at full width needs the largest profile, even next to a small main output
+    output_variant_t variants[] = {{.scale_factor = 1.0f, .resize_width = 3840, .fd = -1}};
+    options.scale_factor = DEFAULT_SCALE_FACTOR;
+    options.resize_width = 320;
+    options.outputs = variants;
+    options.outputs_count = 1;
+    failed += pick_input_profile(&options) != &inputs[1];
+
+    options.inputs_count = 0;
+    failed += pick_input_profile(&options) != NULL;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) pick_input_profile: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) pick_input_profile: test passed\n");
+    return 0;
+}
+
+int test_input_profile(void)
+{
+    int failed = 0;
+    failed += test_parse_input_profile();
+    failed += test_pick_input_profile();
+    return failed;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_keyframe_cadence.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "options.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_learn_keyframe_interval(void)
+{
+    AVCodecParameters codecpar = {0};
+    AVStream av_stream = {0};
+    av_stream.codecpar = &codecpar;
+    av_stream.time_base = (AVRational){1, 90000};
+    AVStream* streams[] = {&av_stream};
+    AVFormatContext format_context = {0};
+    format_context.nb_streams = 1;
+    format_context.streams = streams;
+
+    stream_t stream = {0};
+    stream.format_context = &format_context;
+    stream.last_keyframe_pts = AV_NOPTS_VALUE;
+    options_t options = {0};
+
+    // Keyframes 2 s apart, then a late one 4 s after: the learned GOP moves by a quarter
+    int64_t pts[] = {0, 180000, 360000, 720000};
+    double expected[] = {0, 2.0, 2.0, 2.5};
+    AVFrame frame = {0};
+    int failed = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        frame.best_effort_timestamp = pts[i];
+        learn_keyframe_interval(&stream, &frame, &options);
+        double error = stream.keyframe_interval_sec - expected[i];
+        failed += error > 1e-9 || error < -1e-9 || !stream.last_keyframe_at;
+    }
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) learn_keyframe_interval: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) learn_keyframe_interval: test passed\n");
+    return 0;
+}
+
+int test_check_keyframe_cadence(void)
+{
+    stream_t stream = {0};
+    int failed = 0;
+
+    // Nothing is expected before the GOP is known and a keyframe was seen
+    stream.last_keyframe_at = monotonic_time_in_microseconds() - 60000000;
+    failed += check_keyframe_cadence(&stream) != RTN_SUCCESS;
+
+    stream.keyframe_interval_sec = 2.0;
+    stream.last_keyframe_at = monotonic_time_in_microseconds() - 4000000;
+    failed += check_keyframe_cadence(&stream) != RTN_SUCCESS;
+
+    // Two expected keyframes missed
+    stream.last_keyframe_at = monotonic_time_in_microseconds() - 6000000;
+    failed += check_keyframe_cadence(&stream) != RTN_ERROR;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) check_keyframe_cadence: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) check_keyframe_cadence: test passed\n");
+    return 0;
+}
+
+int test_keyframe_cadence(void)
+{
+    int failed = 0;
+    failed += test_learn_keyframe_interval();
+    failed += test_check_keyframe_cadence();
+    return failed;
+}
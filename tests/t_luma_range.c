@@ -0,0 +1,68 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_luma_range.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stream.h"
+#include "utilities.h"
+
+int test_luma_range(void)
+{
+    // A 4x2 limited range luma plane with black, white and out-of-range samples
+    uint8_t plane[2][8] = {{16, 235, 126, 0, 99, 99, 99, 99}, {255, 17, 234, 16, 99, 99, 99, 99}};
+    AVFrame frame = {0};
+    frame.data[0] = plane[0];
+    frame.linesize[0] = 8;
+    frame.width = 4;
+    frame.height = 2;
+    frame.format = AV_PIX_FMT_YUV420P;
+    frame.color_range = AVCOL_RANGE_MPEG;
+
+    stream_t stream = {0};
+    stream.region = (region_t){.width = 4, .height = 2};
+    init_luma_range(&stream);
+
+    uint8_t image[2][4];
+    const uint8_t expanded[2][4] = {{0, 255, 128, 0}, {255, 1, 254, 0}};
+    copy_luma_plane(&stream, &frame, image[0], 4);
+    int failed = memcmp(image, expanded, sizeof(image)) != 0;
+
+    // An unspecified range is MPEG range, as swscale takes it
+    frame.color_range = AVCOL_RANGE_UNSPECIFIED;
+    failed += get_luma_range_lut(&stream, &frame) != stream.luma_lut;
+
+    // Full range frames are copied as they are
+    const uint8_t full[2][4] = {{16, 235, 126, 0}, {255, 17, 234, 16}};
+    frame.color_range = AVCOL_RANGE_JPEG;
+    copy_luma_plane(&stream, &frame, image[0], 4);
+    failed += memcmp(image, full, sizeof(image)) != 0;
+
+    frame.color_range = AVCOL_RANGE_UNSPECIFIED;
+    frame.format = AV_PIX_FMT_YUVJ420P;
+    failed += get_luma_range_lut(&stream, &frame) != NULL;
+    frame.format = AV_PIX_FMT_GRAY8;
+    failed += get_luma_range_lut(&stream, &frame) != NULL;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) luma_range: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) luma_range: test passed\n");
+    return 0;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_parse_args.c
     ::  ::          ::  ::    Created  | 2025-06-29
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -35,6 +35,9 @@ int _test_flag(int argc, char* test_name, char* argv[], int (*check_function)(op
     }
 
     opts->rtsp_url = NULL;
+    opts->input_alt = NULL;
+    opts->inputs = NULL;
+    opts->inputs_count = 0;
     opts->timeout_sec = DEFAULT_TIMEOUT_SEC;
     opts->output_file_path = NULL;
     opts->output_file_fd = -1;
@@ -53,6 +56,36 @@ int _test_flag(int argc, char* test_name, char* argv[], int (*check_function)(op
         free(opts);
         return 1;
     }
+    opts->shm_name = NULL;
+    opts->shm_slots = DEFAULT_SHM_SLOTS;
+    opts->shm_format = DEFAULT_SHM_FORMAT;
+    opts->write_timeout_ms = DEFAULT_WRITE_TIMEOUT_MS;
+    opts->atomic_write = 0;
+    opts->fsync = 0;
+    opts->outputs = NULL;
+    opts->outputs_count = 0;
+    opts->pyramid_levels = 0;
+    opts->scale_threads = DEFAULT_SCALE_THREADS;
+    opts->crop = (crop_t){0};
+    opts->gray = 0;
+    opts->interval_sec = DEFAULT_INTERVAL_SEC;
+    opts->count = DEFAULT_TIMELAPSE_COUNT;
+    opts->pipeline_depth = DEFAULT_PIPELINE_DEPTH;
+    opts->burst_frames = DEFAULT_BURST_FRAMES;
+    opts->best_of = DEFAULT_BEST_OF;
+    opts->stack_mode = DEFAULT_STACK_MODE;
+    opts->exposure_end = EXPOSURE_END_FRAMES;
+    opts->weight_by_duration = 0;
+    opts->fast_start = 0;
+    opts->profile_cache_dir = NULL;
+    opts->video_track = DEFAULT_VIDEO_TRACK;
+    opts->transport = DEFAULT_TRANSPORT;
+    opts->buffer_size = DEFAULT_BUFFER_SIZE;
+    opts->reorder_queue = DEFAULT_REORDER_QUEUE;
+    opts->max_loss = DEFAULT_MAX_LOSS;
+    opts->deadline_ms = DEFAULT_DEADLINE_MS;
+    opts->batch_file = NULL;
+    opts->jobs = DEFAULT_JOBS;
     opts->help = 0;
     opts->version = 0;
 
@@ -766,6 +799,110 @@ int test_debug_flags(void)
     return failed;
 }
 
+int check_publish_flags(options_t* opts)
+{
+    if (!opts || !opts->shm_name || strcmp(opts->shm_name, "/cam1") != 0 || opts->shm_slots != 8 ||
+        opts->shm_format != SHM_FORMAT_YUV)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: publish flags test failed | expected shm_name /cam1, "
+               "shm_slots 8, shm_format yuv\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_no_publish_flags(options_t* opts)
+{
+    if (!opts || opts->shm_name || opts->shm_slots != DEFAULT_SHM_SLOTS ||
+        opts->shm_format != DEFAULT_SHM_FORMAT)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: publish flags test failed | expected publishing to be off\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_publish_flags(void)
+{
+    int failed = 0;
+
+    char* argv[] = {"prog", "--publish-shm", "/cam1", "--publish-slots", "8", "--publish-format",
+                    "yuv"};
+    failed += _test_flag(7, "publish flags", argv, check_publish_flags, RTN_SUCCESS);
+
+    char* argv_equals[] = {"prog", "--publish-shm=/cam1", "--publish-slots=8",
+                           "--publish-format=YUV"};
+    failed +=
+        _test_flag(4, "publish flags with equals", argv_equals, check_publish_flags, RTN_SUCCESS);
+
+    char* argv_no_publish[] = {"prog", "-i", "rtsp://example.com/stream"};
+    failed += _test_flag(3, "no publish flags", argv_no_publish, check_no_publish_flags,
+                         RTN_SUCCESS);
+
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: publish flags test passed\n");
+
+    return failed;
+}
+
+int check_fsync_flags(options_t* opts)
+{
+    if (!opts || !opts->atomic_write || !opts->fsync || !opts->output_file_path)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: atomic write flags test failed | expected atomic_write 1, "
+               "fsync 1\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_atomic_write_flags(void)
+{
+    int failed = 0;
+
+    char* argv[] = {"prog", "--fsync", "-o", "snapshot.jpg"};
+    failed += _test_flag(4, "atomic write flags", argv, check_fsync_flags, RTN_SUCCESS);
+
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: atomic write flags test passed\n");
+
+    return failed;
+}
+
+int check_output_variants(options_t* opts)
+{
+    if (!opts || opts->outputs_count != 2 || opts->outputs[0].format != IMAGE_FORMAT_JPG ||
+        opts->outputs[0].resize_width != 1920 || !opts->outputs[0].path ||
+        strcmp(opts->outputs[0].path, "a.jpg") != 0 ||
+        opts->outputs[1].format != IMAGE_FORMAT_PNG || opts->outputs[1].fd != 4)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: output variants test failed | expected 2 parsed variants\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_output_variants(void)
+{
+    int failed = 0;
+
+    char* argv[] = {"prog", "--output", "jpg:q=85:w=1920:path=a.jpg", "--output=png:w=320:fd=4"};
+    failed += _test_flag(4, "output variants", argv, check_output_variants, RTN_SUCCESS);
+
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: output variants test passed\n");
+
+    return failed;
+}
+
 int check_invalid_flag(options_t* opts)
 {
     if (!opts || opts->rtsp_url != NULL || opts->timeout_sec != DEFAULT_TIMEOUT_SEC ||
@@ -817,6 +954,459 @@ int test_missing_value(void)
     return 0;
 }
 
+int check_scale_threads_flag(options_t* opts)
+{
+    if (!opts || opts->scale_threads != 8)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: scale threads flag test failed | expected 8, got %d\n",
+               opts ? opts->scale_threads : -1);
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_scale_threads_flag(void)
+{
+    char* argv[] = {"prog", "--scale-threads", "8"};
+    if (_test_flag(3, "scale threads flag", argv, check_scale_threads_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: scale threads flag test passed\n");
+    return 0;
+}
+
+int check_crop_flag(options_t* opts)
+{
+    if (!opts || opts->crop.x != 0.25f || opts->crop.y != 0.0f || opts->crop.width != 0.5f ||
+        opts->crop.height != 1.0f || !opts->crop.normalized)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: crop flag test failed | expected normalized 0.25,0,0.5,1\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_crop_flag(void)
+{
+    int failed = 0;
+
+    char* argv[] = {"prog", "--crop", "0.25,0,0.5,1"};
+    failed += _test_flag(3, "crop flag", argv, check_crop_flag, RTN_SUCCESS);
+
+    char* argv_invalid[] = {"prog", "--crop=10,10,0,0"};
+    failed += _test_flag(2, "invalid crop flag", argv_invalid, check_invalid_flag, RTN_ERROR);
+
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: crop flag test passed\n");
+
+    return failed;
+}
+
+int check_gray_flag(options_t* opts)
+{
+    if (!opts || opts->gray != 1 || opts->output_format != IMAGE_FORMAT_PGM)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: gray flag test failed | expected gray pgm output\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_gray_flag(void)
+{
+    char* argv[] = {"prog", "--gray", "-f", "pgm"};
+    if (_test_flag(4, "gray flag", argv, check_gray_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: gray flag test passed\n");
+    return 0;
+}
+
+int check_timelapse_flags(options_t* opts)
+{
+    if (!opts || opts->interval_sec != 30 || opts->count != 120 || opts->pipeline_depth != 4)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: timelapse flags test failed | expected interval 30, count 120, "
+               "pipeline 4\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_timelapse_flags(void)
+{
+    char* argv[] = {"prog", "--interval", "30", "--count=120", "--pipeline", "4"};
+    if (_test_flag(6, "timelapse flags", argv, check_timelapse_flags, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: timelapse flags test passed\n");
+    return 0;
+}
+
+int check_burst_flag(options_t* opts)
+{
+    if (!opts || opts->burst_frames != 10)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: burst flag test failed | expected burst of 10 frames\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_burst_flag(void)
+{
+    char* argv[] = {"prog", "--burst", "10"};
+    if (_test_flag(3, "burst flag", argv, check_burst_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: burst flag test passed\n");
+    return 0;
+}
+
+int check_best_of_flag(options_t* opts)
+{
+    if (!opts || opts->best_of != 8)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: best-of flag test failed | expected 8 candidates\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_best_of_flag(void)
+{
+    char* argv[] = {"prog", "--best-of=8"};
+    if (_test_flag(2, "best-of flag", argv, check_best_of_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: best-of flag test passed\n");
+    return 0;
+}
+
+int check_stack_flag(options_t* opts)
+{
+    if (!opts || opts->stack_mode != STACK_MODE_KEYFRAMES || opts->exposure_sec != 3600)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: stack flag test failed | expected keyframes, exposure 3600\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_unknown_stack_flag(options_t* opts)
+{
+    if (!opts || opts->stack_mode != STACK_MODE_UNKNOWN)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: stack flag test failed | expected unknown mode\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_stack_flag(void)
+{
+    char* argv[] = {"prog", "--stack", "KeyFrames", "-e", "3600"};
+    if (_test_flag(5, "stack flag", argv, check_stack_flag, RTN_SUCCESS))
+        return 1;
+
+    char* unknown_argv[] = {"prog", "--stack=gop"};
+    if (_test_flag(2, "unknown stack flag", unknown_argv, check_unknown_stack_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: stack flag test passed\n");
+    return 0;
+}
+
+int check_exposure_end_flag(options_t* opts)
+{
+    if (!opts || opts->exposure_end != EXPOSURE_END_PTS || !opts->weight_by_duration ||
+        opts->exposure_sec != 10)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: exposure end flag test failed | expected pts, weighting, "
+               "exposure 10\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_unknown_exposure_end_flag(options_t* opts)
+{
+    if (!opts || opts->exposure_end != EXPOSURE_END_UNKNOWN || opts->weight_by_duration)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: exposure end flag test failed | expected unknown end\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_exposure_end_flag(void)
+{
+    char* argv[] = {"prog", "--exposure-end", "PTS", "--weight-by-duration", "-e", "10"};
+    if (_test_flag(6, "exposure end flag", argv, check_exposure_end_flag, RTN_SUCCESS))
+        return 1;
+
+    char* unknown_argv[] = {"prog", "--exposure-end=dts"};
+    if (_test_flag(2, "unknown exposure end flag", unknown_argv, check_unknown_exposure_end_flag,
+                   RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: exposure end flag test passed\n");
+    return 0;
+}
+
+int check_fast_start_flag(options_t* opts)
+{
+    if (!opts || !opts->fast_start)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: fast start flag test failed | expected fast start\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_fast_start_flag(void)
+{
+    char* argv[] = {"prog", "--fast-start"};
+    if (_test_flag(2, "fast start flag", argv, check_fast_start_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: fast start flag test passed\n");
+    return 0;
+}
+
+int check_profile_cache_flag(options_t* opts)
+{
+    if (!opts || !opts->profile_cache_dir || strcmp(opts->profile_cache_dir, "/var/cache/ss"))
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: profile cache flag test failed | expected /var/cache/ss\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_profile_cache_flag(void)
+{
+    char* argv[] = {"prog", "--profile-cache", "/var/cache/ss"};
+    if (_test_flag(3, "profile cache flag", argv, check_profile_cache_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: profile cache flag test passed\n");
+    return 0;
+}
+
+int check_video_track_flag(options_t* opts)
+{
+    if (!opts || opts->video_track != 1)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: video track flag test failed | expected track 1\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_video_track_flag(void)
+{
+    char* argv[] = {"prog", "--video-track=1"};
+    if (_test_flag(2, "video track flag", argv, check_video_track_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: video track flag test passed\n");
+    return 0;
+}
+
+int check_transport_flags(options_t* opts)
+{
+    if (!opts || opts->transport != TRANSPORT_UDP_MULTICAST || opts->buffer_size != 4194304 ||
+        opts->reorder_queue != 0 || opts->max_loss != 5)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: transport flags test failed | expected udp_multicast, 4 MiB "
+               "buffer, no reordering, 5%% loss\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_unknown_transport_flag(options_t* opts)
+{
+    if (!opts || opts->transport != TRANSPORT_UNKNOWN)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: transport flags test failed | expected unknown transport\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_transport_flags(void)
+{
+    char* argv[] = {"prog",          "--transport=UDP_multicast", "--buffer-size", "4194304",
+                    "--reorder-queue", "0",                       "--max-loss",    "5"};
+    if (_test_flag(8, "transport flags", argv, check_transport_flags, RTN_SUCCESS))
+        return 1;
+
+    char* unknown_argv[] = {"prog", "--transport", "sctp"};
+    if (_test_flag(3, "unknown transport flag", unknown_argv, check_unknown_transport_flag,
+                   RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: transport flags test passed\n");
+    return 0;
+}
+
+int check_deadline_flag(options_t* opts)
+{
+    if (!opts || opts->deadline_ms != 1500)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: deadline flag test failed | expected 1500 ms\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_deadline_flag(void)
+{
+    char* argv[] = {"prog", "--deadline-ms", "1500"};
+    if (_test_flag(3, "deadline flag", argv, check_deadline_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: deadline flag test passed\n");
+    return 0;
+}
+
+int check_input_alt_flag(options_t* opts)
+{
+    if (!opts || !opts->rtsp_url || !opts->input_alt ||
+        strcmp(opts->input_alt, "rtsp://camera/sub") != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: input alt flag test failed | expected rtsp://camera/sub\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_input_alt_flag(void)
+{
+    char* argv[] = {"prog", "-i", "rtsp://camera/main", "--input-alt=rtsp://camera/sub"};
+    if (_test_flag(4, "input alt flag", argv, check_input_alt_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: input alt flag test passed\n");
+    return 0;
+}
+
+int check_input_profile_flags(options_t* opts)
+{
+    if (!opts || opts->rtsp_url || opts->inputs_count != 2 || opts->inputs[0].width != 3840 ||
+        opts->inputs[0].height != 2160 || strcmp(opts->inputs[1].url, "rtsp://camera/sub") != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: input profile flags test failed | expected two profiles\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_invalid_input_profile_flag(options_t* opts)
+{
+    if (!opts || opts->inputs_count != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: input profile flags test failed | expected no profile\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_input_profile_flags(void)
+{
+    char* argv[] = {"prog", "--input-profile", "3840x2160=rtsp://camera/main",
+                    "--input-profile=640x360=rtsp://camera/sub"};
+    if (_test_flag(4, "input profile flags", argv, check_input_profile_flags, RTN_SUCCESS))
+        return 1;
+
+    char* invalid_argv[] = {"prog", "--input-profile", "640=rtsp://camera/sub"};
+    if (_test_flag(3, "invalid input profile flag", invalid_argv,
+                   check_invalid_input_profile_flag, RTN_ERROR))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: input profile flags test passed\n");
+    return 0;
+}
+
+int check_batch_flags(options_t* opts)
+{
+    if (!opts || !opts->batch_file || strcmp(opts->batch_file, "jobs.txt") != 0 ||
+        opts->jobs != 8)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: batch flags test failed | expected jobs.txt on 8 jobs\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_batch_stdin_flag(options_t* opts)
+{
+    if (!opts || !opts->batch_file || strcmp(opts->batch_file, "-") != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) parse_args: batch flags test failed | expected - (stdin)\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int test_batch_flags(void)
+{
+    char* argv[] = {"prog", "--batch=jobs.txt", "--jobs", "8"};
+    if (_test_flag(4, "batch flags", argv, check_batch_flags, RTN_SUCCESS))
+        return 1;
+
+    char* stdin_argv[] = {"prog", "--batch", "-"};
+    if (_test_flag(3, "batch stdin flag", stdin_argv, check_batch_stdin_flag, RTN_SUCCESS))
+        return 1;
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_args: batch flags test passed\n");
+    return 0;
+}
+
 int test_parse_args(void)
 {
     int failed = 0;
@@ -829,6 +1419,25 @@ int test_parse_args(void)
     failed += test_scale_and_resize();
     failed += test_image_quality();
     failed += test_debug_flags();
+    failed += test_publish_flags();
+    failed += test_atomic_write_flags();
+    failed += test_output_variants();
+    failed += test_crop_flag();
+    failed += test_scale_threads_flag();
+    failed += test_gray_flag();
+    failed += test_timelapse_flags();
+    failed += test_burst_flag();
+    failed += test_best_of_flag();
+    failed += test_stack_flag();
+    failed += test_exposure_end_flag();
+    failed += test_fast_start_flag();
+    failed += test_profile_cache_flag();
+    failed += test_video_track_flag();
+    failed += test_transport_flags();
+    failed += test_deadline_flag();
+    failed += test_input_alt_flag();
+    failed += test_input_profile_flags();
+    failed += test_batch_flags();
     failed += test_invalid_flag();
     failed += test_missing_value();
     return failed;
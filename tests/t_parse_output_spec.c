@@ -0,0 +1,100 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_parse_output_spec.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errors.h"
+#include "options.h"
+#include "utilities.h"
+
+int test_parse_output_spec_full(void)
+{
+    output_variant_t variant;
+    short ret = parse_output_spec("jpg:q=85:w=1920:h=1080:path=/tmp/a:b.jpg", &variant);
+
+    int failed = ret != RTN_SUCCESS || variant.format != IMAGE_FORMAT_JPG ||
+                 variant.image_quality != 85 || variant.resize_width != 1920 ||
+                 variant.resize_height != 1080 || variant.fd != -1 || !variant.path ||
+                 strcmp(variant.path, "/tmp/a:b.jpg") != 0;
+    if (ret == RTN_SUCCESS)
+        free(variant.path);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) parse_output_spec: full spec test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_output_spec: full spec test passed\n");
+    return 0;
+}
+
+int test_parse_output_spec_defaults(void)
+{
+    output_variant_t variant;
+    short ret = parse_output_spec("PNG:s=0.5:fd=4", &variant);
+
+    int failed = ret != RTN_SUCCESS || variant.format != IMAGE_FORMAT_PNG ||
+                 variant.image_quality != DEFAULT_IMAGE_QUALITY || variant.scale_factor != 0.5f ||
+                 variant.resize_width != -1 || variant.resize_height != -1 || variant.fd != 4 ||
+                 variant.path != NULL;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) parse_output_spec: defaults test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_output_spec: defaults test passed\n");
+    return 0;
+}
+
+int test_parse_output_spec_invalid(void)
+{
+    const char* specs[] = {"gif:path=a.gif", "jpg:x=1", "jpg:q", "jpg:q=", "jpg:path=", NULL};
+
+    for (int i = 0; specs[i]; ++i)
+    {
+        output_variant_t variant;
+        if (parse_output_spec(specs[i], &variant) != RTN_ERROR || variant.path != NULL)
+        {
+            printf("[" ANSI_RED "KO" ANSI_RESET
+                   "] (f) parse_output_spec: invalid spec test failed for \"%s\"\n",
+                   specs[i]);
+            return 1;
+        }
+    }
+
+    if (parse_output_spec(NULL, NULL) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) parse_output_spec: NULL spec test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) parse_output_spec: invalid spec test passed\n");
+    return 0;
+}
+
+int test_parse_output_spec(void)
+{
+    int failed = 0;
+    failed += test_parse_output_spec_full();
+    failed += test_parse_output_spec_defaults();
+    failed += test_parse_output_spec_invalid();
+    return failed;
+}
@@ -0,0 +1,105 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_pgm_image.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errors.h"
+#include "process.h"
+#include "utilities.h"
+
+static int test_valid_gray_data(void)
+{
+    size_t size = 100 * 100 * GRAY_BYTES_PER_PIXEL;
+    uint8_t* gray_data = malloc(size);
+    if (!gray_data)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) test_valid_gray_data: memory allocation failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < size; ++i) gray_data[i] = (uint8_t)(i % 256);
+
+    const char* header = "P5\n100 100\n255\n";
+    size_t header_len = strlen(header);
+
+    image_t* img = get_pgm_image(gray_data, size, 100, 100);
+    if (img == NULL || img->data == NULL || img->size != header_len + size ||
+        img->width != 100 || img->height != 100 || memcmp(img->data, header, header_len) != 0 ||
+        memcmp(img->data + header_len, gray_data, size) != 0)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_pgm_image: failed to create image\n");
+        free_image(img);
+        free(gray_data);
+        return 1;
+    }
+
+    free_image(img);
+    free(gray_data);
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_pgm_image: valid gray data test passed\n");
+    return 0;
+}
+
+static int test_rgb_data(void)
+{
+    size_t size = 100 * 100 * RGB_BYTES_PER_PIXEL;
+    uint8_t* rgb_data = calloc(size, 1);
+    if (!rgb_data)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) test_rgb_data: memory allocation failed\n");
+        return 1;
+    }
+
+    image_t* img = get_pgm_image(rgb_data, size, 100, 100);
+    free(rgb_data);
+    if (img != NULL)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_pgm_image: RGB data test failed | expected NULL result\n");
+        free_image(img);
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_pgm_image: RGB data test passed\n");
+    return 0;
+}
+
+static int test_null_data(void)
+{
+    size_t size = 100 * 100 * GRAY_BYTES_PER_PIXEL;
+    image_t* img = get_pgm_image(NULL, size, 100, 100);
+    if (img != NULL)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_pgm_image: NULL data test failed | expected NULL result\n");
+        free_image(img);
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_pgm_image: NULL data test passed\n");
+    return 0;
+}
+
+int test_pgm_image(void)
+{
+    int failed = 0;
+    failed += test_valid_gray_data();
+    failed += test_rgb_data();
+    failed += test_null_data();
+    return failed;
+}
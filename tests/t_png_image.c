@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_png_image.c
     ::  ::          ::  ::    Created  | 2025-06-28
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -51,6 +51,35 @@ static int test_valid_rgb_data(void)
     return 0;
 }
 
+static int test_valid_gray_data(void)
+{
+    size_t size = 100 * 100 * GRAY_BYTES_PER_PIXEL;
+    uint8_t* gray_data = malloc(size);
+    if (!gray_data)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) test_valid_gray_data: memory allocation failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < size; ++i) gray_data[i] = (uint8_t)(i % 256);
+
+    image_t* img = get_png_image(gray_data, size, 100, 100, 75);
+    if (img == NULL || img->data == NULL || img->size == 0 || img->width != 100 ||
+        img->height != 100)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) get_png_image: failed to create gray image\n");
+        free_image(img);
+        free(gray_data);
+        return 1;
+    }
+
+    free_image(img);
+    free(gray_data);
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_png_image: valid gray data test passed\n");
+    return 0;
+}
+
 static int test_null_data(void)
 {
     size_t size = 100 * 100 * RGB_BYTES_PER_PIXEL;
@@ -179,6 +208,7 @@ int test_png_image(void)
 {
     int failed = 0;
     failed += test_valid_rgb_data();
+    failed += test_valid_gray_data();
     failed += test_null_data();
     failed += test_invalid_arguments();
     return failed;
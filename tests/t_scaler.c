@@ -0,0 +1,127 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_scaler.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "scaler.h"
+#include "utilities.h"
+
+int test_wrap_frame_buffer_values(void)
+{
+    uint8_t buffer[4 * 2 * 3] = {0};
+    AVFrame* frame = av_frame_alloc();
+    if (!frame)
+        return 1;
+
+    short ret = wrap_frame_buffer(frame, buffer, 4, 2, AV_PIX_FMT_RGB24);
+    int failed = ret != RTN_SUCCESS || frame->data[0] != buffer || frame->linesize[0] != 4 * 3 ||
+                 frame->width != 4 || frame->height != 2 || frame->format != AV_PIX_FMT_RGB24 ||
+                 !frame->buf[0];
+
+    // Releasing the frame must leave the caller-owned buffer alone
+    av_frame_free(&frame);
+    buffer[0] = 1;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) wrap_frame_buffer: values test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) wrap_frame_buffer: values test passed\n");
+    return 0;
+}
+
+int test_wrap_frame_buffer_invalid(void)
+{
+    uint8_t buffer[3] = {0};
+    AVFrame* frame = av_frame_alloc();
+    if (!frame)
+        return 1;
+
+    int failed = wrap_frame_buffer(NULL, buffer, 1, 1, AV_PIX_FMT_RGB24) != RTN_ERROR ||
+                 wrap_frame_buffer(frame, NULL, 1, 1, AV_PIX_FMT_RGB24) != RTN_ERROR ||
+                 wrap_frame_buffer(frame, buffer, 0, 1, AV_PIX_FMT_RGB24) != RTN_ERROR ||
+                 scale_frame(NULL, frame, frame) != RTN_ERROR;
+    av_frame_free(&frame);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) wrap_frame_buffer: invalid arguments test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET
+           "] (f) wrap_frame_buffer: invalid arguments test passed\n");
+    return 0;
+}
+
+int test_sws_cache(void)
+{
+    free_sws_cache();
+    sws_cache_stats_t before = get_sws_cache_stats();
+    sws_key_t key = {.src_width = 64,
+                     .src_height = 32,
+                     .src_format = AV_PIX_FMT_YUV420P,
+                     .dst_width = 64,
+                     .dst_height = 32,
+                     .dst_format = AV_PIX_FMT_RGB24,
+                     .flags = 0,
+                     .threads = 1};
+
+    // Released contexts are reused, busy ones are never handed out twice
+    struct SwsContext* first = acquire_sws_context(&key);
+    struct SwsContext* second = acquire_sws_context(&key);
+    int failed = !first || !second || first == second;
+    release_sws_context(first);
+    struct SwsContext* third = acquire_sws_context(&key);
+    failed += third != first;
+    release_sws_context(second);
+    release_sws_context(third);
+
+    // Filling the cache with other geometries evicts the least recently used contexts
+    for (int i = 0; i < SWS_CACHE_CAPACITY; ++i)
+    {
+        key.dst_width = 16 + i;
+        release_sws_context(acquire_sws_context(&key));
+    }
+
+    sws_cache_stats_t after = get_sws_cache_stats();
+    failed += after.hits - before.hits != 1 ||
+              after.misses - before.misses != 2 + SWS_CACHE_CAPACITY ||
+              after.evictions - before.evictions != 2;
+    free_sws_cache();
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) acquire_sws_context: cache test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) acquire_sws_context: cache test passed\n");
+    return 0;
+}
+
+int test_scaler(void)
+{
+    int failed = 0;
+    failed += test_wrap_frame_buffer_values();
+    failed += test_wrap_frame_buffer_invalid();
+    failed += test_sws_cache();
+    return failed;
+}
@@ -0,0 +1,95 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_sequence_path.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+
+static int _check_sequence_path(const char* path_template, unsigned long long sequence,
+                                time_t when, const char* expected)
+{
+    char* path = get_sequence_path(path_template, sequence, when);
+    int failed = !path || strcmp(path, expected) != 0;
+
+    if (failed)
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_sequence_path: '%s' failed | expected '%s', got '%s'\n",
+               path_template, expected, path ? path : "(null)");
+
+    free(path);
+    return failed;
+}
+
+static int _check_burst_frame_path(const char* path, unsigned long long frame, time_t when,
+                                   const char* expected)
+{
+    char* frame_path = get_burst_frame_path(path, frame, when);
+    int failed = !frame_path || strcmp(frame_path, expected) != 0;
+
+    if (failed)
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_burst_frame_path: '%s' failed | expected '%s', got '%s'\n",
+               path, expected, frame_path ? frame_path : "(null)");
+
+    free(frame_path);
+    return failed;
+}
+
+int test_sequence_path(void)
+{
+    int failed = 0;
+    time_t when = 1760781600;
+
+    char year[8];
+    struct tm local_time;
+    localtime_r(&when, &local_time);
+    strftime(year, sizeof(year), "%Y", &local_time);
+
+    char expected[64];
+    snprintf(expected, sizeof(expected), "out/cam_%s_000042.jpg", year);
+
+    failed += _check_sequence_path("snap_%N.jpg", 7, when, "snap_000007.jpg");
+    failed += _check_sequence_path("out/cam_%Y_%N.jpg", 42, when, expected);
+    failed += _check_sequence_path("latest.jpg", 3, when, "latest.jpg");
+    failed += _check_sequence_path("100%%_%N.png", 1, when, "100%_000001.png");
+
+    failed += _check_burst_frame_path("incident.jpg", 1, when, "incident_000001.jpg");
+    failed += _check_burst_frame_path("out.d/burst", 12, when, "out.d/burst_000012");
+    failed += _check_burst_frame_path("dir/.hidden", 3, when, "dir/.hidden_000003");
+    failed += _check_burst_frame_path("burst_%N.png", 5, when, "burst_000005.png");
+
+    char* path = get_sequence_path(NULL, 1, when);
+    if (path)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) get_sequence_path: NULL template test failed | expected NULL result\n");
+        free(path);
+        failed++;
+    }
+
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET
+               "] (f) get_sequence_path: templates and burst paths test passed\n");
+
+    return failed;
+}
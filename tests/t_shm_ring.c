@@ -0,0 +1,151 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_shm_ring.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "errors.h"
+#include "options.h"
+#include "publish.h"
+#include "utilities.h"
+
+#define T_SHM_RING_NAME "/streamshot_test_ring"
+
+static options_t _make_ring_options(shm_format_t format, int slots)
+{
+    options_t options;
+    memset(&options, 0, sizeof(options));
+    options.shm_name = T_SHM_RING_NAME;
+    options.shm_slots = slots;
+    options.shm_format = format;
+    return options;
+}
+
+static int test_shm_ring_invalid_arguments(void)
+{
+    options_t options = _make_ring_options(SHM_FORMAT_RGB, 1);
+    AVRational time_base = {1, 90000};
+
+    if (open_shm_ring(&options, 4, 2, time_base) != NULL ||
+        open_shm_ring(NULL, 4, 2, time_base) != NULL)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) open_shm_ring: invalid arguments test failed | expected NULL\n");
+        return 1;
+    }
+
+    options.shm_slots = 2;
+    if (open_shm_ring(&options, 0, 2, time_base) != NULL)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) open_shm_ring: invalid dimensions test failed | expected NULL\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) open_shm_ring: invalid arguments test passed\n");
+    return 0;
+}
+
+static int test_shm_ring_publish_rgb(void)
+{
+    options_t options = _make_ring_options(SHM_FORMAT_RGB, 2);
+    AVRational time_base = {1, 90000};
+    shm_ring_t* ring = open_shm_ring(&options, 4, 2, time_base);
+    if (!ring)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) open_shm_ring: failed to open ring\n");
+        return 1;
+    }
+
+    int failed = 0;
+    uint8_t rgb[4 * 2 * 3];
+    AVFrame frame;
+    memset(&frame, 0, sizeof(frame));
+
+    for (int n = 0; n < 3; ++n)
+    {
+        memset(rgb, n + 1, sizeof(rgb));
+        frame.best_effort_timestamp = 3600 * n;
+        if (publish_frame(ring, &frame, rgb))
+            failed++;
+    }
+
+    const shm_ring_header_t* header = ring->header;
+    uint64_t published = atomic_load(&header->frames_published);
+    const shm_ring_slot_t* slot =
+        (const shm_ring_slot_t*)(ring->base + header->slots_offset +
+                                 ((published - 1) % header->slot_count) * header->slot_stride);
+    const uint8_t* data = (const uint8_t*)slot + header->data_offset;
+
+    if (header->magic != SHM_RING_MAGIC || header->slot_count != 2 || header->width != 4 ||
+        header->height != 2 || header->frame_size != sizeof(rgb) || published != 3 ||
+        atomic_load(&slot->sequence) % 2 != 0 || slot->frame_index != 2 || slot->pts != 7200 ||
+        slot->size != sizeof(rgb) || data[0] != 3 || data[sizeof(rgb) - 1] != 3)
+        failed++;
+
+    close_shm_ring(ring);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) publish_frame: rgb ring test failed | unexpected header or slot content\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) publish_frame: rgb ring test passed\n");
+    return 0;
+}
+
+static int test_shm_ring_reopen(void)
+{
+    options_t options = _make_ring_options(SHM_FORMAT_RGB, 4);
+    AVRational time_base = {1, 90000};
+    shm_ring_t* old_ring = open_shm_ring(&options, 64, 32, time_base);
+
+    // A smaller ring under the same name must not shrink the mapping of attached readers
+    options.shm_slots = 2;
+    shm_ring_t* new_ring = old_ring ? open_shm_ring(&options, 4, 2, time_base) : NULL;
+    volatile uint8_t last_byte = old_ring ? old_ring->base[old_ring->mapped_size - 1] : 1;
+
+    int failed = !old_ring || !new_ring || last_byte != 0 ||
+                 old_ring->header->magic != SHM_RING_MAGIC || old_ring->header->width != 64 ||
+                 new_ring->header->width != 4;
+
+    close_shm_ring(new_ring);
+    close_shm_ring(old_ring);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) open_shm_ring: reopen test failed | previous ring changed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) open_shm_ring: reopen test passed\n");
+    return 0;
+}
+
+int test_shm_ring(void)
+{
+    int failed = 0;
+    failed += test_shm_ring_invalid_arguments();
+    failed += test_shm_ring_publish_rgb();
+    failed += test_shm_ring_reopen();
+    return failed;
+}
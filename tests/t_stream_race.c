@@ -0,0 +1,97 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_stream_race.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "options.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_stream_race(void)
+{
+    output_variant_t variants[] = {{.resize_width = 640, .resize_height = -1, .fd = -1}};
+    options_t options = {0};
+    options.resize_width = 320;
+    char output_path[] = "/tmp/test_stream_race.jpg";
+    options.output_file_path = output_path;
+    options.output_file_fd = -1;
+    options.outputs = variants;
+    options.outputs_count = 1;
+
+    // A 4K main stream and a 704x576 sub stream both cover a 640 wide output
+    stream_race_t race;
+    init_stream_race(&race);
+    stream_t main_stream = {.race = &race, .race_index = 0};
+    main_stream.region = (region_t){.width = 3840, .height = 2160};
+    stream_t sub_stream = {.race = &race, .race_index = 1};
+    sub_stream.region = (region_t){.width = 704, .height = 576};
+    join_stream_race(&main_stream, &options);
+    join_stream_race(&sub_stream, &options);
+
+    // The smaller sub stream claims at once, the main stream then lost
+    long long start = monotonic_time_in_microseconds();
+    int failed = stream_race_lost(&main_stream) || stream_race_lost(&sub_stream);
+    failed += claim_stream_race(&sub_stream, &options) != RTN_SUCCESS;
+    failed += claim_stream_race(&sub_stream, &options) != RTN_SUCCESS;
+    failed += monotonic_time_in_microseconds() - start >= RACE_GRACE_MS * 1000LL;
+    failed += !stream_race_lost(&main_stream) || stream_race_lost(&sub_stream);
+    failed += claim_stream_race(&main_stream, &options) != RTN_ERROR;
+
+    // The main stream leaves the qualifying sub stream a grace window before it wins
+    init_stream_race(&race);
+    join_stream_race(&main_stream, &options);
+    join_stream_race(&sub_stream, &options);
+    start = monotonic_time_in_microseconds();
+    failed += claim_stream_race(&main_stream, &options) != RTN_SUCCESS;
+    failed += monotonic_time_in_microseconds() - start < RACE_GRACE_MS * 1000LL;
+
+    // Without a sub stream left in the race, the main stream wins at once
+    init_stream_race(&race);
+    join_stream_race(&main_stream, &options);
+    leave_stream_race(&race, sub_stream.race_index);
+    start = monotonic_time_in_microseconds();
+    failed += claim_stream_race(&main_stream, &options) != RTN_SUCCESS;
+    failed += monotonic_time_in_microseconds() - start >= RACE_GRACE_MS * 1000LL;
+
+    // Every output is sized on its own: 640x360 covers h=120 but not w=1920
+    sub_stream.region = (region_t){.width = 640, .height = 360};
+    options.resize_width = 1920;
+    variants[0] = (output_variant_t){.resize_width = -1, .resize_height = 120, .fd = -1};
+    init_stream_race(&race);
+    join_stream_race(&main_stream, &options);
+    join_stream_race(&sub_stream, &options);
+    failed += claim_stream_race(&sub_stream, &options) != RTN_ERROR;
+    failed += claim_stream_race(&main_stream, &options) != RTN_SUCCESS;
+
+    options.resize_width = 320;
+    variants[0].resize_height = 720;
+    init_stream_race(&race);
+    failed += claim_stream_race(&sub_stream, &options) != RTN_ERROR;
+
+    // Streams outside a race never lose
+    stream_t single = {0};
+    failed += stream_race_lost(&single) || claim_stream_race(&single, &options) != RTN_SUCCESS;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) stream_race: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) stream_race: test passed\n");
+    return 0;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_string_to_image_format.c
     ::  ::          ::  ::    Created  | 2025-06-25
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -32,13 +32,15 @@ int test_string_to_image_format(void)
                  {"jpeg", IMAGE_FORMAT_JPEG},
                  {"png", IMAGE_FORMAT_PNG},
                  {"ppm", IMAGE_FORMAT_PPM},
+                 {"pgm", IMAGE_FORMAT_PGM},
                  {"unknown format", IMAGE_FORMAT_UNKNOWN},
                  {"", IMAGE_FORMAT_UNKNOWN},
                  {"invalid", IMAGE_FORMAT_UNKNOWN},
                  {"JPG", IMAGE_FORMAT_JPG},
                  {"JPEG", IMAGE_FORMAT_JPEG},
                  {"PNG", IMAGE_FORMAT_PNG},
-                 {"PPM", IMAGE_FORMAT_PPM}};
+                 {"PPM", IMAGE_FORMAT_PPM},
+                 {"PGM", IMAGE_FORMAT_PGM}};
 
     for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
     {
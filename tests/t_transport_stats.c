@@ -0,0 +1,93 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_transport_stats.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdio.h>
+
+#include "errors.h"
+#include "options.h"
+#include "stream.h"
+#include "utilities.h"
+
+int test_transport_stats_packets(void)
+{
+    stream_t stream = {0};
+    stream.frame_duration = 3600;
+    stream.transport_stats.last_dts = AV_NOPTS_VALUE;
+
+    // Gaps before the first decoded frame are the mid-GOP join, not a loss
+    int64_t dts[] = {0, 7200, 10800, 21600, 18000, 25200};
+    AVPacket packet = {0};
+    for (int i = 0; i < 6; ++i)
+    {
+        packet.dts = dts[i];
+        packet.flags = i == 5 ? AV_PKT_FLAG_CORRUPT : 0;
+        count_video_packet(&stream, &packet);
+        if (i == 1)
+            stream.transport_stats.frames = 1;
+    }
+
+    const transport_stats_t* stats = &stream.transport_stats;
+    if (stats->packets != 6 || stats->corrupt_packets != 1 || stats->reordered_packets != 1 ||
+        stats->missing_frames != 2)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) count_video_packet: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) count_video_packet: test passed\n");
+    return 0;
+}
+
+int test_transport_stats_frames(void)
+{
+    stream_t stream = {0};
+    options_t options = {0};
+    options.max_loss = 25;
+
+    AVFrame clean = {0};
+    AVFrame corrupt = {0};
+    corrupt.flags = AV_FRAME_FLAG_CORRUPT;
+
+    int failed = is_corrupt_frame(&clean) || !is_corrupt_frame(&corrupt);
+    for (int i = 0; i < 3; ++i)
+        failed += count_video_frame(&stream, &clean, &options) != RTN_SUCCESS;
+
+    // One corrupt frame in four is within 25%, a second one is not
+    failed += count_video_frame(&stream, &corrupt, &options) != RTN_SUCCESS;
+    failed += count_video_frame(&stream, &corrupt, &options) != RTN_ERROR;
+
+    // --max-loss 100 tolerates anything
+    options.max_loss = 100;
+    failed += count_video_frame(&stream, &corrupt, &options) != RTN_SUCCESS;
+    failed += stream.transport_stats.frames != 6 || stream.transport_stats.corrupt_frames != 3;
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) count_video_frame: test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) count_video_frame: test passed\n");
+    return 0;
+}
+
+int test_transport_stats(void)
+{
+    int failed = 0;
+    failed += test_transport_stats_packets();
+    failed += test_transport_stats_frames();
+    return failed;
+}
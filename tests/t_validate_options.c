@@ -8,7 +8,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_validate_options.c
     ::  ::          ::  ::    Created  | 2025-06-29
-          ::::  ::::          Modified | 2025-06-29
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -569,6 +569,13 @@ int test_invalid_resize_width(void)
         failed++;
     }
 
+    // A pyramid base may be as narrow as a pyramid level, but no narrower
+    opts->pyramid_levels = 3;
+    opts->resize_width = MIN_PYRAMID_WIDTH;
+    failed += validate_options(opts) != RTN_SUCCESS;
+    opts->resize_width = MIN_PYRAMID_WIDTH - 1;
+    failed += validate_options(opts) != RTN_ERROR;
+
     free(opts);
     if (!failed)
         printf("[" ANSI_GREEN "OK" ANSI_RESET
@@ -669,6 +676,525 @@ int test_debug_options(void)
     return failed;
 }
 
+int test_gray_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->output_format = IMAGE_FORMAT_PGM;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: gray options test failed | pgm without --gray accepted\n");
+        failed++;
+    }
+
+    opts->gray = 1;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: gray options test failed | pgm with --gray rejected\n");
+        failed++;
+    }
+
+    opts->shm_name = "/streamshot";
+    opts->shm_slots = DEFAULT_SHM_SLOTS;
+    opts->shm_format = SHM_FORMAT_RGB;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: gray options test failed | rgb publishing accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: gray options test passed\n");
+
+    return failed;
+}
+
+int test_timelapse_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->count = 10;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: timelapse test failed | count without interval accepted\n");
+        failed++;
+    }
+
+    opts->pipeline_depth = 2;
+    opts->interval_sec = 60;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: timelapse test failed | valid timelapse rejected\n");
+        failed++;
+    }
+
+    opts->shm_name = "/streamshot";
+    opts->shm_slots = DEFAULT_SHM_SLOTS;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: timelapse test failed | interval with shm accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: timelapse test passed\n");
+
+    return failed;
+}
+
+int test_burst_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->burst_frames = 10;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: burst test failed | valid burst rejected\n");
+        failed++;
+    }
+
+    opts->burst_frames = MAX_BURST_FRAMES + 1;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: burst test failed | oversized burst accepted\n");
+        failed++;
+    }
+
+    opts->burst_frames = 10;
+    opts->exposure_sec = 2;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: burst test failed | burst with exposure accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: burst test passed\n");
+
+    return failed;
+}
+
+int test_best_of_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->best_of = 5;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: best-of test failed | valid best-of rejected\n");
+        failed++;
+    }
+
+    opts->burst_frames = 5;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: best-of test failed | best-of with burst accepted\n");
+        failed++;
+    }
+
+    opts->burst_frames = 0;
+    opts->exposure_sec = 3;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: best-of test failed | best-of with exposure accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: best-of test passed\n");
+
+    return failed;
+}
+
+int test_stack_mode_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->stack_mode = STACK_MODE_KEYFRAMES;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: stack mode test failed | keyframes without exposure "
+               "accepted\n");
+        failed++;
+    }
+
+    opts->exposure_sec = 3600;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: stack mode test failed | keyframe exposure rejected\n");
+        failed++;
+    }
+
+    opts->stack_mode = STACK_MODE_UNKNOWN;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: stack mode test failed | unknown mode accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: stack mode test passed\n");
+
+    return failed;
+}
+
+int test_exposure_end_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->exposure_end = EXPOSURE_END_PTS;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: exposure end test failed | pts without exposure "
+               "accepted\n");
+        failed++;
+    }
+
+    opts->exposure_sec = 10;
+    opts->weight_by_duration = 1;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: exposure end test failed | weighted pts exposure "
+               "rejected\n");
+        failed++;
+    }
+
+    opts->exposure_end = EXPOSURE_END_FRAMES;
+    opts->exposure_sec = 0;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: exposure end test failed | weighting without exposure "
+               "accepted\n");
+        failed++;
+    }
+
+    opts->weight_by_duration = 0;
+    opts->exposure_end = EXPOSURE_END_UNKNOWN;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: exposure end test failed | unknown end accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: exposure end test passed\n");
+
+    return failed;
+}
+
+int test_profile_cache_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->profile_cache_dir = "/unlikely_profile_cache_dir_that_should_not_exist";
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: profile cache test failed | missing directory accepted\n");
+        failed++;
+    }
+
+    opts->profile_cache_dir = "/tmp";
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: profile cache test failed | /tmp rejected\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET
+               "] (f) validate_options: profile cache test passed\n");
+
+    return failed;
+}
+
+int test_video_track_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->video_track = MAX_VIDEO_TRACK;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: video track test failed | max track rejected\n");
+        failed++;
+    }
+
+    opts->video_track = MAX_VIDEO_TRACK + 1;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: video track test failed | track above max accepted\n");
+        failed++;
+    }
+
+    opts->video_track = -1;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: video track test failed | negative track accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: video track test passed\n");
+
+    return failed;
+}
+
+int test_transport_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->buffer_size = 1048576;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: transport test failed | TCP socket buffer accepted\n");
+        failed++;
+    }
+
+    opts->transport = TRANSPORT_UDP;
+    opts->reorder_queue = 64;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: transport test failed | UDP tuning rejected\n");
+        failed++;
+    }
+
+    opts->transport = TRANSPORT_UNKNOWN;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: transport test failed | unknown transport accepted\n");
+        failed++;
+    }
+
+    opts->transport = TRANSPORT_TCP;
+    opts->buffer_size = 0;
+    opts->reorder_queue = DEFAULT_REORDER_QUEUE;
+    opts->max_loss = 101;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: transport test failed | max loss above 100 accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: transport test passed\n");
+
+    return failed;
+}
+
+int test_deadline_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->deadline_ms = MAX_DEADLINE_MS;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: deadline test failed | max deadline rejected\n");
+        failed++;
+    }
+
+    opts->deadline_ms = -1;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: deadline test failed | negative deadline accepted\n");
+        failed++;
+    }
+
+    opts->deadline_ms = 2000;
+    opts->interval_sec = 10;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: deadline test failed | timelapse deadline accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: deadline test passed\n");
+
+    return failed;
+}
+
+int test_input_alt_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->input_alt = "rtsp://camera/sub";
+    opts->crop = (crop_t){.x = 0.25f, .y = 0.25f, .width = 0.5f, .height = 0.5f, .normalized = 1};
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input alt test failed | normalized crop rejected\n");
+        failed++;
+    }
+
+    opts->crop.normalized = 0;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input alt test failed | pixel crop accepted\n");
+        failed++;
+    }
+
+    opts->crop = (crop_t){0};
+    opts->burst_frames = 4;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input alt test failed | burst accepted\n");
+        failed++;
+    }
+
+    opts->burst_frames = 0;
+    opts->input_alt = "http://camera/sub";
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input alt test failed | non-RTSP URL accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: input alt test passed\n");
+
+    return failed;
+}
+
+int test_input_profile_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+    input_profile_t inputs[] = {{3840, 2160, "rtsp://camera/main"},
+                                {640, 360, "rtsp://camera/sub"}};
+
+    opts->inputs = inputs;
+    opts->inputs_count = 2;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input profile test failed | --input accepted too\n");
+        failed++;
+    }
+
+    opts->rtsp_url = NULL;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input profile test failed | profiles rejected\n");
+        failed++;
+    }
+
+    inputs[1].url = "http://camera/sub";
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: input profile test failed | non-RTSP URL accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET
+               "] (f) validate_options: input profile test passed\n");
+
+    return failed;
+}
+
+int test_batch_options(void)
+{
+    int failed = 0;
+    options_t* opts = make_valid_options();
+
+    opts->jobs = 4;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: batch test failed | --jobs accepted without --batch\n");
+        failed++;
+    }
+
+    opts->batch_file = "jobs.txt";
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: batch test failed | --input accepted with --batch\n");
+        failed++;
+    }
+
+    opts->rtsp_url = NULL;
+    opts->output_file_path = NULL;
+    if (validate_options(opts) != RTN_SUCCESS)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: batch test failed | batch rejected\n");
+        failed++;
+    }
+
+    opts->jobs = MAX_JOBS + 1;
+    if (validate_options(opts) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) validate_options: batch test failed | too many jobs accepted\n");
+        failed++;
+    }
+
+    free(opts);
+    if (!failed)
+        printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) validate_options: batch test passed\n");
+
+    return failed;
+}
+
 int test_validate_options(void)
 {
     int failed = 0;
@@ -688,5 +1214,18 @@ int test_validate_options(void)
     failed += test_invalid_resize_width();
     failed += test_invalid_image_quality();
     failed += test_debug_options();
+    failed += test_gray_options();
+    failed += test_timelapse_options();
+    failed += test_burst_options();
+    failed += test_best_of_options();
+    failed += test_stack_mode_options();
+    failed += test_exposure_end_options();
+    failed += test_profile_cache_options();
+    failed += test_video_track_options();
+    failed += test_transport_options();
+    failed += test_deadline_options();
+    failed += test_input_alt_options();
+    failed += test_input_profile_options();
+    failed += test_batch_options();
     return failed;
 }
\ No newline at end of file
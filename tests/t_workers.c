@@ -0,0 +1,135 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_workers.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "errors.h"
+#include "utilities.h"
+#include "workers.h"
+
+#define T_WORKERS_TASKS 200
+
+static void _increment(void* arg)
+{
+    atomic_fetch_add((atomic_int*)arg, 1);
+}
+
+int test_workers_group(void)
+{
+    atomic_int counter = 0;
+    worker_group_t group;
+
+    // A queue smaller than the number of tasks exercises the blocking submit path
+    worker_pool_t* pool = create_worker_pool(4, 8);
+    if (!pool || init_worker_group(&group))
+    {
+        free_worker_pool(pool);
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) worker_pool: failed to create pool\n");
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = 0; i < T_WORKERS_TASKS; ++i)
+        failed += submit_worker_task(pool, &group, _increment, &counter) != RTN_SUCCESS;
+
+    wait_worker_group(&group);
+    failed += atomic_load(&counter) != T_WORKERS_TASKS;
+
+    destroy_worker_group(&group);
+    free_worker_pool(pool);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) worker_pool: group test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) worker_pool: group test passed\n");
+    return 0;
+}
+
+static atomic_int _started = 0;
+static atomic_int _released = 0;
+
+static void _block_until_released(void* arg)
+{
+    atomic_store(&_started, 1);
+    while (!atomic_load(&_released));
+    atomic_fetch_add((atomic_int*)arg, 1);
+}
+
+int test_workers_try_submit(void)
+{
+    atomic_int counter = 0;
+    worker_group_t group;
+
+    worker_pool_t* pool = create_worker_pool(1, 1);
+    if (!pool || init_worker_group(&group))
+    {
+        free_worker_pool(pool);
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) worker_pool: failed to create pool\n");
+        return 1;
+    }
+
+    // The only worker is held busy, so the queue holds one task and rejects the next one
+    int failed = submit_worker_task(pool, &group, _block_until_released, &counter) != RTN_SUCCESS;
+    while (!failed && !atomic_load(&_started));
+
+    failed += try_submit_worker_task(pool, &group, _increment, &counter) != RTN_SUCCESS;
+    failed += try_submit_worker_task(pool, &group, _increment, &counter) != WORKER_QUEUE_FULL;
+    failed += get_worker_queue_length(pool) != 1;
+
+    atomic_store(&_released, 1);
+    wait_worker_group(&group);
+    failed += atomic_load(&counter) != 2 || get_worker_queue_length(pool) != 0;
+
+    destroy_worker_group(&group);
+    free_worker_pool(pool);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) worker_pool: try submit test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) worker_pool: try submit test passed\n");
+    return 0;
+}
+
+int test_workers_invalid(void)
+{
+    if (create_worker_pool(0, 1) || create_worker_pool(1, 0) ||
+        submit_worker_task(NULL, NULL, _increment, NULL) != RTN_ERROR ||
+        try_submit_worker_task(NULL, NULL, _increment, NULL) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) worker_pool: invalid arguments test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) worker_pool: invalid arguments test passed\n");
+    return 0;
+}
+
+int test_workers(void)
+{
+    int failed = 0;
+    failed += test_workers_group();
+    failed += test_workers_try_submit();
+    failed += test_workers_invalid();
+    return failed;
+}
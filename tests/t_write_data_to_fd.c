@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | t_write_data_to_fd.c
     ::  ::          ::  ::    Created  | 2025-06-24
-          ::::  ::::          Modified | 2025-06-24
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -105,6 +106,125 @@ int test_write_data_to_fd_zero_size(void)
     return 0;
 }
 
+typedef struct _pipe_reader_s
+{
+    int fd;
+    uint8_t* data;
+    size_t size;
+    size_t received;
+} _pipe_reader_t;
+
+static void* _read_pipe(void* arg)
+{
+    _pipe_reader_t* reader = (_pipe_reader_t*)arg;
+    while (reader->received < reader->size)
+    {
+        usleep(1000);  // Slow consumer: forces the writer to wait for the pipe.
+        ssize_t r = read(reader->fd, reader->data + reader->received,
+                         reader->size - reader->received);
+        if (r <= 0)
+            break;
+        reader->received += r;
+    }
+
+    return NULL;
+}
+
+int test_write_data_to_fd_slow_pipe(void)
+{
+    int fds[2];
+    if (pipe(fds))
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_data_to_fd: pipe failed\n");
+        return 1;
+    }
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+
+    size_t size = 1024 * 1024;
+    uint8_t* data = malloc(size);
+    uint8_t* copy = malloc(size);
+    for (size_t i = 0; data && copy && i < size; ++i)
+        data[i] = (uint8_t)(i * 31);
+
+    _pipe_reader_t reader = {.fd = fds[0], .data = copy, .size = size, .received = 0};
+    pthread_t thread;
+    int failed = !data || !copy || pthread_create(&thread, NULL, _read_pipe, &reader);
+    if (!failed)
+    {
+        write_stats_t stats;
+        ssize_t written = write_data_to_fd_with_deadline(fds[1], data, size, 0, &stats);
+        pthread_join(thread, NULL);
+
+        failed = written != (ssize_t)size || stats.bytes != size || stats.polls == 0 ||
+                 reader.received != size || memcmp(data, copy, size) != 0;
+    }
+
+    // A large write that fits into the pipe returns before the reader takes a single byte
+    int capacity = fcntl(fds[1], F_SETPIPE_SZ, (int)size);
+    if (capacity < 0)
+        capacity = fcntl(fds[1], F_GETPIPE_SZ);
+    size_t queued = (size_t)capacity < size ? (size_t)capacity : size;
+    if (!failed && capacity > 0)
+    {
+        write_stats_t stats;
+        ssize_t written = write_data_to_fd_with_deadline(fds[1], data, queued, 0, &stats);
+        size_t received = 0;
+        while (written == (ssize_t)queued && received < queued)
+        {
+            ssize_t r = read(fds[0], copy + received, queued - received);
+            if (r <= 0)
+                break;
+            received += r;
+        }
+
+        failed = written != (ssize_t)queued || stats.polls != 0 || received != queued ||
+                 memcmp(data, copy, queued) != 0;
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+    free(data);
+    free(copy);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_data_to_fd: slow pipe test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_data_to_fd: slow pipe test passed\n");
+    return 0;
+}
+
+int test_write_data_to_fd_deadline(void)
+{
+    int fds[2];
+    if (pipe(fds))
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_data_to_fd: pipe failed\n");
+        return 1;
+    }
+
+    size_t size = 1024 * 1024;
+    uint8_t* data = calloc(1, size);
+    write_stats_t stats;
+    ssize_t written = data ? write_data_to_fd_with_deadline(fds[1], data, size, 50, &stats) : 0;
+    int still_blocking = !(fcntl(fds[1], F_GETFL) & O_NONBLOCK);
+
+    close(fds[0]);
+    close(fds[1]);
+    free(data);
+
+    if (written != RTN_ERROR || stats.stall_us < 40000 || !still_blocking)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_data_to_fd: deadline test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_data_to_fd: deadline test passed\n");
+    return 0;
+}
+
 int test_write_data_to_fd(void)
 {
     int failed = 0;
@@ -112,5 +232,7 @@ int test_write_data_to_fd(void)
     failed += test_write_data_to_fd_invalid_fd();
     failed += test_write_data_to_fd_null_buf();
     failed += test_write_data_to_fd_zero_size();
+    failed += test_write_data_to_fd_slow_pipe();
+    failed += test_write_data_to_fd_deadline();
     return failed;
 }
\ No newline at end of file
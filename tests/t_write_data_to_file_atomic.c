@@ -0,0 +1,110 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_write_data_to_file_atomic.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _GNU_SOURCE
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "utilities.h"
+
+// Helper: count directory entries left behind by the writer
+static int _count_entries(const char* dir_path)
+{
+    DIR* dir = opendir(dir_path);
+    if (!dir)
+        return -1;
+
+    int count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)))
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            count++;
+
+    closedir(dir);
+    return count;
+}
+
+int test_write_data_to_file_atomic_replace(void)
+{
+    char dir_path[] = "/tmp/test_atomic_write_XXXXXX";
+    if (!mkdtemp(dir_path))
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_data_to_file_atomic: mkdtemp failed\n");
+        return 1;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/out.bin", dir_path);
+
+    const char old_data[] = "previous snapshot with longer content";
+    const char new_data[] = "new snapshot";
+    int failed = write_data_to_file(path, old_data, sizeof(old_data)) != sizeof(old_data);
+    failed += write_data_to_file_atomic(path, new_data, sizeof(new_data), 1) != sizeof(new_data);
+
+    char buf[64] = {0};
+    FILE* f = fopen(path, "rb");
+    size_t n = f ? fread(buf, 1, sizeof(buf), f) : 0;
+    if (f)
+        fclose(f);
+
+    failed += n != sizeof(new_data) || memcmp(buf, new_data, sizeof(new_data)) != 0;
+    failed += _count_entries(dir_path) != 1;
+
+    unlink(path);
+    rmdir(dir_path);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) write_data_to_file_atomic: replace test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_data_to_file_atomic: replace test passed\n");
+    return 0;
+}
+
+int test_write_data_to_file_atomic_invalid(void)
+{
+    const char data[] = "abc";
+    if (write_data_to_file_atomic(NULL, data, sizeof(data), 0) != RTN_ERROR ||
+        write_data_to_file_atomic("file.bin", NULL, 10, 0) != RTN_ERROR ||
+        write_data_to_file_atomic("file.bin", data, 0, 0) != RTN_ERROR ||
+        write_data_to_file_atomic("/nonexistent_dir/file.bin", data, sizeof(data), 0) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) write_data_to_file_atomic: invalid arguments test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET
+           "] (f) write_data_to_file_atomic: invalid arguments test passed\n");
+    return 0;
+}
+
+int test_write_data_to_file_atomic(void)
+{
+    int failed = 0;
+    failed += test_write_data_to_file_atomic_replace();
+    failed += test_write_data_to_file_atomic_invalid();
+    return failed;
+}
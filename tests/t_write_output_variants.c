@@ -0,0 +1,103 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_write_output_variants.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+
+// Helper: read the first bytes of a file
+static size_t _read_head(const char* path, uint8_t* buf, size_t size)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return 0;
+
+    size_t n = fread(buf, 1, size, f);
+    fclose(f);
+    return n;
+}
+
+int test_write_output_variants_formats(void)
+{
+    int width = 64, height = 48;
+    image_t raw_image = {.width = width, .height = height};
+    raw_image.size = width * height * 3;
+    raw_image.data = malloc(raw_image.size);
+    for (size_t i = 0; raw_image.data && i < raw_image.size; ++i)
+        raw_image.data[i] = (uint8_t)i;
+
+    output_variant_t outputs[3] = {
+        {.format = IMAGE_FORMAT_JPG, .image_quality = 80, .scale_factor = 1.0f, .fd = -1,
+         .path = "/tmp/test_output_variant_0.jpg"},
+        {.format = IMAGE_FORMAT_PNG, .image_quality = 50, .scale_factor = 1.0f, .fd = -1,
+         .path = "/tmp/test_output_variant_1.png"},
+        {.format = IMAGE_FORMAT_PPM, .image_quality = 95, .scale_factor = 1.0f, .fd = -1,
+         .path = "/tmp/test_output_variant_2.ppm"},
+    };
+    options_t options = {.output_file_fd = -1, .outputs = outputs, .outputs_count = 3};
+
+    short ret = raw_image.data ? write_output_variants(&options, &raw_image) : RTN_ERROR;
+
+    uint8_t head[4];
+    int failed = ret != RTN_SUCCESS;
+    failed += _read_head(outputs[0].path, head, 2) != 2 || head[0] != 0xFF || head[1] != 0xD8;
+    failed += _read_head(outputs[1].path, head, 4) != 4 || memcmp(head, "\x89PNG", 4) != 0;
+    failed += _read_head(outputs[2].path, head, 2) != 2 || memcmp(head, "P6", 2) != 0;
+
+    for (int i = 0; i < 3; ++i)
+        unlink(outputs[i].path);
+    free(raw_image.data);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_output_variants: formats test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_output_variants: formats test passed\n");
+    return 0;
+}
+
+int test_write_output_variants_invalid(void)
+{
+    options_t options = {.output_file_fd = -1};
+    if (write_output_variants(NULL, NULL) != RTN_ERROR ||
+        write_output_variants(&options, NULL) != RTN_ERROR)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET
+               "] (f) write_output_variants: invalid arguments test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET
+           "] (f) write_output_variants: invalid arguments test passed\n");
+    return 0;
+}
+
+int test_write_output_variants(void)
+{
+    int failed = 0;
+    failed += test_write_output_variants_formats();
+    failed += test_write_output_variants_invalid();
+    return failed;
+}
@@ -0,0 +1,121 @@
+/*******************************************************************
+
+        ::          ::        +--------+-----------------------+
+          ::      ::          | Author | Dmitry Novikov        |
+        ::::::::::::::        | Email  | dredfort.42@gmail.com |
+      ::::  ::::::  ::::      +--------+-----------------------+
+    ::::::::::::::::::::::
+    ::  ::::::::::::::  ::    File     | t_write_pyramid.c
+    ::  ::          ::  ::    Created  | 2026-10-18
+          ::::  ::::          Modified | 2026-10-18
+
+    GitHub:   https://github.com/dredfort42
+    LinkedIn: https://linkedin.com/in/novikov-da
+
+*******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "errors.h"
+#include "output.h"
+#include "utilities.h"
+
+short _scale_image(image_t* raw_image, const options_t* options);
+
+int test_pyramid_level_path(void)
+{
+    const char* cases[][2] = {
+        {"snap.jpg", "snap_480.jpg"},
+        {"/a.b/snap", "/a.b/snap_480"},
+        {"dir/.hidden", "dir/.hidden_480"},
+        {"dir/snap.tar.png", "dir/snap.tar_480.png"},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        char* path = get_pyramid_level_path(cases[i][0], 480);
+        int failed = !path || strcmp(path, cases[i][1]) != 0;
+        free(path);
+        if (failed)
+        {
+            printf("[" ANSI_RED "KO" ANSI_RESET
+                   "] (f) get_pyramid_level_path: test failed for \"%s\"\n",
+                   cases[i][0]);
+            return 1;
+        }
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) get_pyramid_level_path: test passed\n");
+    return 0;
+}
+
+int test_write_pyramid_levels(void)
+{
+    image_t image = {.width = 128, .height = 40};
+    image.size = (size_t)image.width * image.height * 3;
+    image.data = calloc(1, image.size);
+
+    // 128x40 -> 64x20 -> stops before 32x10 (below the pyramid minimum)
+    options_t options = {.output_file_path = "/tmp/test_pyramid.ppm",
+                         .output_file_fd = -1,
+                         .output_format = IMAGE_FORMAT_PPM,
+                         .pyramid_levels = 4};
+    short ret = image.data ? write_pyramid(&options, &image) : RTN_ERROR;
+
+    // Level 0 is --output-file itself, only the smaller levels get a width suffix
+    const char* expected[] = {"/tmp/test_pyramid.ppm", "/tmp/test_pyramid_64.ppm"};
+    int failed = ret != RTN_SUCCESS;
+    for (int i = 0; i < 2; ++i)
+    {
+        failed += access(expected[i], F_OK) != 0;
+        unlink(expected[i]);
+    }
+    failed += access("/tmp/test_pyramid_32.ppm", F_OK) == 0;
+    failed += access("/tmp/test_pyramid_128.ppm", F_OK) == 0;
+    free(image.data);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_pyramid: levels test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_pyramid: levels test passed\n");
+    return 0;
+}
+
+int test_pyramid_base_scale(void)
+{
+    image_t image = {.width = 128, .height = 40};
+    image.size = (size_t)image.width * image.height * 3;
+    image.data = calloc(1, image.size);
+
+    // A 64x20 base is below MIN_RESIZE_WIDTH x MIN_RESIZE_HEIGHT, which only a pyramid allows
+    options_t options = {.resize_width = 64, .resize_height = -1, .pyramid_levels = 2};
+    short ret = image.data ? _scale_image(&image, &options) : RTN_ERROR;
+    int failed = ret != RTN_SUCCESS || image.width != 64 || image.height != 20;
+    free(image.data);
+
+    if (failed)
+    {
+        printf("[" ANSI_RED "KO" ANSI_RESET "] (f) write_pyramid: base scale test failed\n");
+        return 1;
+    }
+
+    printf("[" ANSI_GREEN "OK" ANSI_RESET "] (f) write_pyramid: base scale test passed\n");
+    return 0;
+}
+
+int test_write_pyramid(void)
+{
+    int failed = 0;
+    failed += test_pyramid_level_path();
+    failed += test_write_pyramid_levels();
+    failed += test_pyramid_base_scale();
+    return failed;
+}
@@ -7,7 +7,7 @@
     ::::::::::::::::::::::
     ::  ::::::::::::::  ::    File     | tests.c
     ::  ::          ::  ::    Created  | 2025-06-09
-          ::::  ::::          Modified | 2025-06-28
+          ::::  ::::          Modified | 2026-10-18
 
     GitHub:   https://github.com/dredfort42
     LinkedIn: https://linkedin.com/in/novikov-da
@@ -28,6 +28,7 @@ int main()
     failed += test_write_data_to_fd();
     failed += test_write_msg_to_fd();
     failed += test_write_data_to_file();
+    failed += test_write_data_to_file_atomic();
     failed += test_time_now_in_microseconds();
     failed += test_image_format_to_string();
     failed += test_string_to_image_format();
@@ -35,8 +36,30 @@ int main()
     failed += test_jpg_image();
     failed += test_png_image();
     failed += test_ppm_image();
+    failed += test_pgm_image();
     failed += test_parse_args();
     failed += test_validate_options();
+    failed += test_shm_ring();
+    failed += test_parse_output_spec();
+    failed += test_workers();
+    failed += test_write_output_variants();
+    failed += test_half_size_image();
+    failed += test_write_pyramid();
+    failed += test_crop();
+    failed += test_box_downscaled_image();
+    failed += test_scaler();
+    failed += test_sequence_path();
+    failed += test_frame_score();
+    failed += test_stream_profile();
+    failed += test_find_video_track();
+    failed += test_transport_stats();
+    failed += test_deadline();
+    failed += test_keyframe_cadence();
+    failed += test_stream_race();
+    failed += test_input_profile();
+    failed += test_batch_line();
+    failed += test_first_frame();
+    failed += test_luma_range();
 
     printf("\n");
     if (failed)